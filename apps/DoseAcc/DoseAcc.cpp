@@ -69,6 +69,11 @@ int main(int argc, const char** argv)
 		std::cout << "Registration file: " << appData._regFileName << std::endl;
 	}
 
+	if (!(appData._displacementFieldFileName.empty()))
+	{
+		std::cout << "Displacement field file: " << appData._displacementFieldFileName << std::endl;
+	}
+
 	std::cout << "Dose 1 weight:      " << appData._weightDose1 << std::endl;
 	std::cout << "Dose 2 weight:      " << appData._weightDose2 << std::endl;
 	std::cout << "Operator:           " << appData._operator << std::endl;
@@ -38,6 +38,7 @@ namespace rttb
 				_dose2FileName = "";
 				_outputFileName = "";
 				_regFileName = "";
+				_displacementFieldFileName = "";
 
 				_interpolatorName = "linear";
 
@@ -63,6 +64,11 @@ namespace rttb
                 appData._weightDose2 = argParser->get<double>(argParser->OPTION_WEIGHT2);
                 appData._regFileName = argParser->get<std::string>(argParser->OPTION_REGISTRATION_FILENAME);
                 appData._operator = argParser->get<std::string>(argParser->OPTION_OPERATOR);
+
+                if (argParser->isSet(argParser->OPTION_DISPLACEMENT_FIELD_FILENAME))
+                {
+                    appData._displacementFieldFileName = argParser->get<std::string>(argParser->OPTION_DISPLACEMENT_FIELD_FILENAME);
+                }
             }
 
 		}
@@ -44,6 +44,8 @@ namespace rttb
 				std::string _dose2LoadStyle;
 				RegistrationType::Pointer _spReg;
 				std::string  _regFileName;
+				/** Cache of the registration on the grid of dose 1 (see DisplacementFieldTransformation), empty if not used.*/
+				std::string  _displacementFieldFileName;
 				std::string _operator;
 
 				std::string  _outputFileName;
@@ -60,6 +60,13 @@ namespace rttb
 					"", "no mapping", 'r', true);
 				addInformationForXML(OPTION_REGISTRATION_FILENAME, cmdlineparsing::XMLGenerator::paramType::INPUT, { "mapr" });
 
+				addOption<std::string>(OPTION_DISPLACEMENT_FIELD_FILENAME, OPTION_GROUP_OPTIONAL,
+					"Specifies name and location of a displacement field file that caches the registration on the grid of dose 1. "
+					"If the file exists, dose 2 is mapped with the stored field instead of evaluating the registration "
+					"(the field has to match the grid of dose 1 and the specified registration). "
+					"Otherwise the displacement field of the registration is computed and stored in the file, so further accumulations "
+					"through the same registration can reuse it.", 'f');
+
 				std::string defaultLoadingStyle;
 				defaultLoadingStyle = "dicom";
 				std::string doseLoadStyleDescription = "Options are:"
@@ -51,6 +51,7 @@ namespace rttb
                 const std::string OPTION_LOAD_STYLE_DOSE1 = "loadStyle1";
                 const std::string OPTION_LOAD_STYLE_DOSE2 = "loadStyle2";
 				const std::string OPTION_OPERATOR = "operator";
+				const std::string OPTION_DISPLACEMENT_FIELD_FILENAME = "displacementField";
 			};
 
 		}
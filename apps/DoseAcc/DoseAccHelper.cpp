@@ -15,6 +15,11 @@
 
 #include "DoseAccHelper.h"
 
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
 #include "boost/make_shared.hpp"
 
 #include "mapRegistrationFileReader.h"
@@ -24,6 +29,7 @@
 #include "rttbITKImageAccessorConverter.h"
 #include "rttbSimpleMappableDoseAccessor.h"
 #include "rttbMatchPointTransformation.h"
+#include "rttbDisplacementFieldTransformation.h"
 #include "rttbLinearInterpolation.h"
 #include "rttbNearestNeighborInterpolation.h"
 #include "rttbRosuMappableDoseAccessor.h"
@@ -54,7 +60,7 @@ rttb::apps::doseAcc::loadRegistration(const std::string& fileName)
 	return resultPtr;
 };
 
-rttb::core::DoseAccessorInterface::Pointer generateNNMappableAccessor(
+rttb::interpolation::MappableDoseAccessorInterface::Pointer generateNNMappableAccessor(
     const rttb::core::GeometricInfo& geoInfoTargetImage,
     const rttb::core::DoseAccessorInterface::Pointer doseMovingImage,
     const rttb::interpolation::TransformationInterface::Pointer aTransformation)
@@ -65,7 +71,7 @@ rttb::core::DoseAccessorInterface::Pointer generateNNMappableAccessor(
     aTransformation, interpolate);
 }
 
-rttb::core::DoseAccessorInterface::Pointer generateLinearMappableAccessor(
+rttb::interpolation::MappableDoseAccessorInterface::Pointer generateLinearMappableAccessor(
     const rttb::core::GeometricInfo& geoInfoTargetImage,
     const rttb::core::DoseAccessorInterface::Pointer doseMovingImage,
     const rttb::interpolation::TransformationInterface::Pointer aTransformation)
@@ -76,7 +82,7 @@ rttb::core::DoseAccessorInterface::Pointer generateLinearMappableAccessor(
     aTransformation, interpolate);
 }
 
-rttb::core::DoseAccessorInterface::Pointer generateRosuMappableAccessor(
+rttb::interpolation::MappableDoseAccessorInterface::Pointer generateRosuMappableAccessor(
     const rttb::core::GeometricInfo& geoInfoTargetImage,
     const rttb::core::DoseAccessorInterface::Pointer doseMovingImage,
     const rttb::interpolation::TransformationInterface::Pointer aTransformation)
@@ -85,6 +91,97 @@ rttb::core::DoseAccessorInterface::Pointer generateRosuMappableAccessor(
     aTransformation);
 }
 
+/**Private helper function for generateTransformation(). Returns an identifier of the content of the registration file
+ * (FNV-1a checksum), so a cached displacement field can be checked against the registration.*/
+std::string
+computeRegistrationIdentifier(const std::string& fileName)
+{
+	std::ifstream registrationFile(fileName, std::ios::binary);
+
+	if (!registrationFile)
+	{
+		rttbDefaultExceptionStaticMacro( << "Cannot read registration file: " << fileName);
+	}
+
+	std::uint64_t checksum = 14695981039346656037ULL;
+	char character;
+
+	while (registrationFile.get(character))
+	{
+		checksum ^= static_cast<unsigned char>(character);
+		checksum *= 1099511628211ULL;
+	}
+
+	std::ostringstream identifier;
+	identifier << "registration FNV-1a " << std::hex << std::setw(16) << std::setfill('0') << checksum;
+	return identifier.str();
+}
+
+/**Private helper function for assembleOutputAccessor(). Returns the transformation used to map dose 2 (nullptr if no mapping is needed).
+ * If a displacement field file is specified and exists, the stored field is used (it has to be computed on the grid of dose 1
+ * and, if a registration is specified, from this registration). Otherwise, the field of the registration is computed on the
+ * grid of dose 1 and stored in the file, so the registration is only evaluated once for repeated accumulations.*/
+rttb::interpolation::TransformationInterface::Pointer
+generateTransformation(const rttb::apps::doseAcc::ApplicationData& appData)
+{
+	const bool useDisplacementField = !appData._displacementFieldFileName.empty();
+	std::string registrationIdentifier;
+
+	if (appData._spReg.IsNotNull() && useDisplacementField)
+	{
+		registrationIdentifier = computeRegistrationIdentifier(appData._regFileName);
+	}
+
+	if (useDisplacementField && std::ifstream(appData._displacementFieldFileName).good())
+	{
+		std::cout << std::endl << "read displacement field file... ";
+		rttb::interpolation::DisplacementFieldTransformation::Pointer field =
+		    rttb::interpolation::DisplacementFieldTransformation::read(appData._displacementFieldFileName);
+		std::cout << "done." << std::endl;
+
+		if (!field->getFieldGeometry().equalsAlmost(appData._dose1->getGeometricInfo()))
+		{
+			rttbDefaultExceptionStaticMacro( << "Displacement field " << appData._displacementFieldFileName <<
+			                                 " was not computed on the grid of dose 1. Delete it to compute it again.");
+		}
+
+		if (!registrationIdentifier.empty() && field->getTransformationIdentifier() != registrationIdentifier)
+		{
+			rttbDefaultExceptionStaticMacro( << "Displacement field " << appData._displacementFieldFileName <<
+			                                 " was not computed from registration " << appData._regFileName << ". Delete it to compute it again.");
+		}
+
+		return field;
+	}
+
+	if (appData._spReg.IsNull())
+	{
+		if (useDisplacementField)
+		{
+			rttbDefaultExceptionStaticMacro( << "Displacement field file " << appData._displacementFieldFileName <<
+			                                 " does not exist and no registration is specified to compute it.");
+		}
+
+		return nullptr;
+	}
+
+	rttb::interpolation::TransformationInterface::Pointer transform =
+	    boost::make_shared<rttb::interpolation::MatchPointTransformation>(appData._spReg);
+
+	if (useDisplacementField)
+	{
+		std::cout << std::endl << "compute displacement field... ";
+		auto field = boost::make_shared<rttb::interpolation::DisplacementFieldTransformation>(*transform,
+		             appData._dose1->getGeometricInfo());
+		field->setTransformationIdentifier(registrationIdentifier);
+		field->write(appData._displacementFieldFileName);
+		std::cout << "done." << std::endl;
+		transform = field;
+	}
+
+	return transform;
+}
+
 /**Private helper function for processData(). Generates a suitable output accessor
  * (depending on the configuration in appData a suitable accessor pipeline is established)
  * which performs the accumulation of the doses and returns the output.to */
@@ -94,24 +191,26 @@ assembleOutputAccessor(rttb::apps::doseAcc::ApplicationData& appData)
 
 	rttb::core::DoseAccessorInterface::Pointer dose2Accessor = appData._dose2;
 
-	if (appData._spReg.IsNotNull())
+	rttb::interpolation::TransformationInterface::Pointer transform = generateTransformation(appData);
+
+	if (transform != nullptr)
 	{
-    auto transform = boost::make_shared<rttb::interpolation::MatchPointTransformation>(appData._spReg);
+		rttb::interpolation::MappableDoseAccessorInterface::Pointer mappableAccessor;
 
 		if (appData._interpolatorName == "rosu")
 		{
-			dose2Accessor = generateRosuMappableAccessor(appData._dose1->getGeometricInfo(), appData._dose2,
-			                transform);
+			mappableAccessor = generateRosuMappableAccessor(appData._dose1->getGeometricInfo(), appData._dose2,
+			                   transform);
 		}
 		else if (appData._interpolatorName == "nn")
 		{
-			dose2Accessor = generateNNMappableAccessor(appData._dose1->getGeometricInfo(), appData._dose2,
-			                transform);
+			mappableAccessor = generateNNMappableAccessor(appData._dose1->getGeometricInfo(), appData._dose2,
+			                   transform);
 		}
 		else if (appData._interpolatorName == "linear")
 		{
-			dose2Accessor = generateLinearMappableAccessor(appData._dose1->getGeometricInfo(), appData._dose2,
-			                transform);
+			mappableAccessor = generateLinearMappableAccessor(appData._dose1->getGeometricInfo(), appData._dose2,
+			                   transform);
 		}
 		else
 		{
@@ -119,6 +218,11 @@ assembleOutputAccessor(rttb::apps::doseAcc::ApplicationData& appData)
 			                                 "Unkown interpolation type selected. Cannot map dose. Interpolation type: " <<
 			                                 appData._interpolatorName);
 		}
+
+		//map the whole dose once instead of mapping every voxel on access
+		std::cout << std::endl << "map dose 2... ";
+		dose2Accessor = mappableAccessor->resample();
+		std::cout << "done." << std::endl;
 	}
 
 	rttb::core::DoseAccessorInterface::Pointer outputAccessor;
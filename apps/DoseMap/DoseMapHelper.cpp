@@ -54,14 +54,14 @@ rttb::apps::doseMap::loadRegistration(const std::string& fileName)
 };
 
 
-/**Private helper function for processData(). Generates a suitable output accessor
+/**Private helper function for processData(). Generates a suitable mappable accessor
  * (depending on the configuration in appData a suitable accessor pipeline is established)
- * which performs the accumulation of the doses and returns the output.to */
-rttb::core::DoseAccessorInterface::Pointer
+ * which performs the mapping of the dose and returns it.*/
+rttb::interpolation::MappableDoseAccessorInterface::Pointer
 assembleOutputAccessor(rttb::apps::doseMap::ApplicationData& appData)
 {
 
-	rttb::core::DoseAccessorInterface::Pointer outputAccessor = appData._inputDose;
+	rttb::interpolation::MappableDoseAccessorInterface::Pointer outputAccessor;
 
   auto transform = boost::make_shared<rttb::interpolation::MatchPointTransformation>(appData._spReg);
 
@@ -95,9 +95,13 @@ assembleOutputAccessor(rttb::apps::doseMap::ApplicationData& appData)
 void
 rttb::apps::doseMap::processData(rttb::apps::doseMap::ApplicationData& appData)
 {
-	rttb::core::DoseAccessorInterface::Pointer outputAccessor = assembleOutputAccessor(
+	rttb::interpolation::MappableDoseAccessorInterface::Pointer mappableAccessor = assembleOutputAccessor(
 	            appData);
 
+	std::cout << std::endl << "map dose... ";
+	rttb::core::DoseAccessorInterface::Pointer outputAccessor = mappableAccessor->resample();
+	std::cout << "done." << std::endl;
+
 	std::cout << std::endl << "generate output image... ";
 	io::itk::ITKImageAccessorConverter converter(outputAccessor);
 	converter.setFailOnInvalidIDs(true);
@@ -23,6 +23,7 @@
 #include "RTToolboxConfigure.h"
 
 #include "rttbException.h"
+#include "rttbThreadPool.h"
 
 #include "rttbDoseLoader.cpp"
 #include "rttbStructLoader.cpp"
@@ -62,11 +63,13 @@ int main(int argc, const char** argv)
 	}
 
 	rttb::apps::doseTool::populateAppData(argParser, appData);
+	rttb::core::ThreadPool::setConcurrency(appData._numberOfThreads);
 
 	std::cout << std::endl << "*******************************************" << std::endl;
 	std::cout << "Dose file:   " << appData._doseFileName << std::endl;
 	std::cout << "Struct file: " << appData._structFileName << std::endl;
 	std::cout << "Struct name: " << appData._structNameRegex << std::endl;
+	std::cout << "Number of threads: " << rttb::core::ThreadPool::getInstance().getConcurrency() << std::endl;
 
 	if (appData._computeDoseStatistics)
 	{
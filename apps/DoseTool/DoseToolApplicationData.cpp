@@ -38,6 +38,7 @@ namespace rttb
 				_multipleStructsMode = false;
 				_computeDVH = false;
 				_computeDoseStatistics = false;
+				_numberOfThreads = 0;
 			}
 
 			void populateAppData(boost::shared_ptr<DoseToolCmdLineParser> argParser, ApplicationData& appData) {
@@ -49,6 +50,7 @@ namespace rttb
 				                           (argParser->OPTION_STRUCT_LOAD_STYLE);
 				appData._structNameRegex = argParser->get<std::string >(argParser->OPTION_STRUCT_NAME);
 				appData._multipleStructsMode = argParser->isSet(argParser->OPTION_MULTIPLE_STRUCTS_MODE);
+				appData._numberOfThreads = argParser->get<unsigned int>(argParser->OPTION_NUMBER_OF_THREADS);
 
 				if (argParser->isSet(argParser->OPTION_DOSE_STATISTICS)) {
 					appData._computeDoseStatistics = true;
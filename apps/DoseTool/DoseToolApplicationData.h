@@ -50,6 +50,7 @@ namespace rttb
 				bool _computeDVH;
 				bool _computeDoseStatistics;
 				std::string _dvhOutputFilename;
+				unsigned int _numberOfThreads;
 
 				/*! @brief Resets the variables. _prescribedDose is set to 1.0 because it produces no exception then (as it is not needed). Consistency checks are done in DoseToolCmdLineParser::validateInput()
 				*/
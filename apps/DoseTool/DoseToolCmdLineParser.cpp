@@ -98,6 +98,10 @@ namespace rttb
 					"The struct name will be appended to the chosen output filename.", 'm');
 				addInformationForXML(OPTION_MULTIPLE_STRUCTS_MODE, cmdlineparsing::XMLGenerator::paramType::BOOLEAN);
 
+				addOptionWithDefaultValue<unsigned int>(OPTION_NUMBER_OF_THREADS, OPTION_GROUP_OPTIONAL,
+					"Maximal number of threads used for the computations (e.g. voxelization). 0 means the number of hardware threads/cores.", 0, "0", 'j');
+				addInformationForXML(OPTION_NUMBER_OF_THREADS, cmdlineparsing::XMLGenerator::paramType::INTEGER);
+
 				parse(argc, argv);
 			}
 
@@ -29,10 +29,13 @@
 #include "rttbDVHCalculator.h"
 #include "rttbDVHXMLFileWriter.h"
 #include "rttbDoseStatisticsCalculator.h"
-#include "rttbBoostMaskAccessor.h"
+#include "rttbBoostMaskSetGenerator.h"
 #include "rttbGenericMaskedDoseIterator.h"
 #include "rttbDoseStatisticsXMLWriter.h"
 
+#include <tuple>
+#include <utility>
+
 
 std::vector<rttb::core::MaskAccessorInterface::Pointer>
 rttb::apps::doseTool::generateMasks(
@@ -55,11 +58,16 @@ rttb::apps::doseTool::generateMasks(
 
 			 bool strict = !appData._allowSelfIntersection;
 
+			std::vector<size_t> structureIndices;
+
 			for (size_t i = 0; i < maxIterationCount; i++) {
-				maskAccessorPtrVector.emplace_back(boost::make_shared<rttb::masks::boost::BoostMaskAccessor>(appData._struct->getStructure(i), appData._dose->getGeometricInfo(), strict));
-				maskAccessorPtrVector.at(i)->updateMask();
+				structureIndices.push_back(i);
 				appData._structNames.push_back(appData._struct->getStructure(i)->getLabel());
 			}
+
+			//all masks are voxelized concurrently on the same (shared) dose geometry
+			rttb::masks::boost::BoostMaskSetGenerator maskGenerator(appData._struct, appData._dose->getGeometricInfo(), strict);
+			maskAccessorPtrVector = maskGenerator.generateMasks(structureIndices);
 		} else {
 			std::cout << "no structures in structure set!" << std::endl;
 		}
@@ -93,6 +101,28 @@ calculateDoseStatistics(
 	}
 }
 
+/*! @brief Calculates the dose statistics and the DVH from the same traversal of the dose.
+@return the dose statistics (first) and the DVH (second)
+*/
+std::pair<rttb::algorithms::DoseStatistics::Pointer, rttb::core::DVH::Pointer>
+calculateDoseStatisticsAndDVH(
+    rttb::core::DoseIteratorInterface::Pointer doseIterator, bool calculateComplexDoseStatistics,
+    rttb::DoseTypeGy prescribedDose, rttb::IDType structUID, rttb::IDType doseUID)
+{
+	rttb::algorithms::DoseStatisticsCalculator doseStatsCalculator(doseIterator);
+	doseStatsCalculator.enableDVHCalculation(structUID, doseUID);
+
+	rttb::algorithms::DoseStatistics::Pointer statistics;
+
+	if (calculateComplexDoseStatistics) {
+		statistics = doseStatsCalculator.calculateDoseStatistics(prescribedDose);
+	} else {
+		statistics = doseStatsCalculator.calculateDoseStatistics();
+	}
+
+	return std::make_pair(statistics, doseStatsCalculator.getDVH());
+}
+
 
 rttb::core::DVH::Pointer calculateDVH(
     rttb::core::DoseIteratorInterface::Pointer
@@ -157,11 +187,34 @@ void rttb::apps::doseTool::processData(rttb::apps::doseTool::ApplicationData& ap
             maskAccessorPtrVector.at(i),
             appData._dose));
 
+        rttb::IDType structUID;
+        rttb::IDType doseUID;
+
+        //Generate random UID
+        if (appData._structLoadStyle == "itk") {
+            structUID = "struct.fromVoxelizedITK";
+            doseUID = "dose.fromVoxelizedITK";
+        } else {
+            structUID = appData._struct->getUID();
+            doseUID = appData._dose->getUID();
+        }
+
+        //if both are requested, the DVH is calculated together with the dose statistics
+        core::DVH::Pointer dvh;
+
         if (appData._computeDoseStatistics) {
             std::cout << std::endl << "computing dose statistics... ";
-            auto statistics = calculateDoseStatistics(
-                spDoseIterator,
-                appData._computeComplexDoseStatistics, appData._prescribedDose);
+            rttb::algorithms::DoseStatistics::Pointer statistics;
+
+            if (appData._computeDVH) {
+                std::tie(statistics, dvh) = calculateDoseStatisticsAndDVH(
+                    spDoseIterator,
+                    appData._computeComplexDoseStatistics, appData._prescribedDose, structUID, doseUID);
+            } else {
+                statistics = calculateDoseStatistics(
+                    spDoseIterator,
+                    appData._computeComplexDoseStatistics, appData._prescribedDose);
+            }
             std::cout << "done." << std::endl;
 
             std::cout << std::endl << "writing dose statistics to file... ";
@@ -179,23 +232,13 @@ void rttb::apps::doseTool::processData(rttb::apps::doseTool::ApplicationData& ap
         }
 
         if (appData._computeDVH) {
-            std::cout << std::endl << "computing DVH... ";
-            rttb::IDType structUID;
-            rttb::IDType doseUID;
-
-            //Generate random UID
-            if (appData._structLoadStyle == "itk") {
-                structUID = "struct.fromVoxelizedITK";
-                doseUID = "dose.fromVoxelizedITK";
-            } else {
-                structUID = appData._struct->getUID();
-                doseUID = appData._dose->getUID();
+            if (!dvh) {
+                std::cout << std::endl << "computing DVH... ";
+                dvh = calculateDVH(spDoseIterator, structUID,
+                    doseUID);
+                std::cout << "done." << std::endl;
             }
 
-            core::DVH::Pointer dvh = calculateDVH(spDoseIterator, structUID,
-                doseUID);
-            std::cout << "done." << std::endl;
-
             std::cout << std::endl << "writing DVH to file... ";
             std::string outputFilename;
 
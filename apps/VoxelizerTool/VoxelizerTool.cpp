@@ -19,6 +19,8 @@
 #include "VoxelizerToolCmdLineParser.h"
 #include "VoxelizerToolApplicationData.h"
 
+#include "rttbThreadPool.h"
+
 #include "rttbDoseLoader.cpp"
 #include "rttbStructLoader.cpp"
 
@@ -55,6 +57,7 @@ int main(int argc, const char** argv)
 	}
 
 	rttb::apps::voxelizerTool::populateAppData(argParser, appData);
+	rttb::core::ThreadPool::setConcurrency(appData._numberOfThreads);
 
 	if (argParser->isSet(argParser->OPTION_ALL_STRUCTS))
 	{
@@ -78,7 +81,8 @@ int main(int argc, const char** argv)
 	std::cout << "Struct regex: " << appData._regEx << std::endl;
 	std::cout << "Add structures: " << appData._addStructures << std::endl;
     std::cout << "Multiple Struct: " << appData._multipleStructs << std::endl;
-	std::cout << "Strict voxelization: " << !appData._noStrictVoxelization << std::endl << std::endl;
+	std::cout << "Strict voxelization: " << !appData._noStrictVoxelization << std::endl;
+	std::cout << "Number of threads: " << rttb::core::ThreadPool::getInstance().getConcurrency() << std::endl << std::endl;
 
 	std::cout << "reading reference and structure file..." << std::endl;
 
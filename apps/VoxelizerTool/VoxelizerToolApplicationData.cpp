@@ -42,6 +42,7 @@ namespace rttb
 				_addStructures = false;
 				_noStrictVoxelization = false;
 				_allStructs = false;
+				_numberOfThreads = 0;
 			}
 
 			void populateAppData(boost::shared_ptr<VoxelizerCmdLineParser> argParser, ApplicationData& appData)
@@ -53,6 +54,7 @@ namespace rttb
 				//only valid option for reading structs is dicom until now.
 				appData._structFileLoadStyle = "dicom";
 				appData._regEx = argParser->get<std::string>(argParser->OPTION_REGEX);
+				appData._numberOfThreads = argParser->get<unsigned int>(argParser->OPTION_NUMBER_OF_THREADS);
 				
 				if (argParser->isSet(argParser->OPTION_MULTIPLE_STRUCTS))
 				{
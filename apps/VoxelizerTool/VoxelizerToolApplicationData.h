@@ -50,6 +50,7 @@ namespace rttb
         bool _addStructures;
         bool _noStrictVoxelization;
 		bool _allStructs;
+		unsigned int _numberOfThreads;
 
         /*! @brief Resets the variables.
         */
@@ -72,6 +72,9 @@ namespace rttb
                 addInformationForXML(OPTION_NO_STRICT_VOXELIZATION, cmdlineparsing::XMLGenerator::paramType::BOOLEAN);
 				addOption(OPTION_ALL_STRUCTS, OPTION_GROUP_OPTIONAL, "Voxelizes all structures in a struct file",'f');
 				addInformationForXML(OPTION_ALL_STRUCTS, cmdlineparsing::XMLGenerator::paramType::BOOLEAN);
+				addOptionWithDefaultValue<unsigned int>(OPTION_NUMBER_OF_THREADS, OPTION_GROUP_OPTIONAL,
+					"Maximal number of threads used for the computations (e.g. voxelization). 0 means the number of hardware threads/cores.", 0, "0", 'j');
+				addInformationForXML(OPTION_NUMBER_OF_THREADS, cmdlineparsing::XMLGenerator::paramType::INTEGER);
 
 				parse(argc, argv);
 			}
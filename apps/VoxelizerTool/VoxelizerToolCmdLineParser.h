@@ -51,6 +51,7 @@ namespace rttb
 				const std::string OPTION_ADDSTRUCTURES = "addStructures";
 				const std::string OPTION_NO_STRICT_VOXELIZATION = "noStrictVoxelization";
 				const std::string OPTION_ALL_STRUCTS = "allStructs";
+				const std::string OPTION_NUMBER_OF_THREADS = "numberOfThreads";
 			};
 		}
 	}
@@ -15,7 +15,7 @@
 
 #include <iostream>
 
-#include "rttbBoostMaskAccessor.h"
+#include "rttbBoostMaskSetGenerator.h"
 
 #include "itkMacro.h"
 
@@ -50,23 +50,22 @@ void rttb::apps::voxelizerTool::removeSpecialCharacters(std::string& label)
 	}
 }
 
-rttb::core::MaskAccessorInterface::Pointer rttb::apps::voxelizerTool::createMask(
+std::vector<rttb::core::MaskAccessorInterface::Pointer> rttb::apps::voxelizerTool::createMasks(
     rttb::core::DoseAccessorInterface::Pointer doseAccessorPtr,
-    rttb::core::Structure::Pointer structurePtr,
-    bool strict)
+    rttb::core::StructureSet::Pointer structureSetPtr,
+    const std::vector<size_t>& structureIndices, bool strict)
 {
-    rttb::core::MaskAccessorInterface::Pointer maskAccessorPtr;
+    std::vector<rttb::core::MaskAccessorInterface::Pointer> maskAccessorPtrVector;
 
-    if (doseAccessorPtr != nullptr && structurePtr != nullptr)
+    if (doseAccessorPtr != nullptr && structureSetPtr != nullptr)
     {
-        maskAccessorPtr = boost::make_shared<rttb::masks::boost::BoostMaskAccessor>
-            (structurePtr, doseAccessorPtr->getGeometricInfo(),
-                strict);
+        rttb::masks::boost::BoostMaskSetGenerator maskGenerator(structureSetPtr,
+            doseAccessorPtr->getGeometricInfo(), strict);
 
-        maskAccessorPtr->updateMask();
+        maskAccessorPtrVector = maskGenerator.generateMasks(structureIndices);
     }
 
-    return maskAccessorPtr;
+    return maskAccessorPtrVector;
 }
 
 void rttb::apps::voxelizerTool::writeMaskToFile(std::vector<core::MaskAccessorInterface::Pointer> maskVector,
@@ -157,13 +156,17 @@ void rttb::apps::voxelizerTool::processData(rttb::apps::voxelizerTool::Applicati
 
         if (appData._addStructures)
         {
+            std::vector<size_t> structureIndices;
+
             for (size_t i=0; i<appData._struct->getNumberOfStructures(); i++ )
             {
-              std::cout << "creating mask #" << i << "...";
-                maskVector.push_back(createMask(appData._dose, appData._struct->getStructure(i),
-                    !appData._noStrictVoxelization));
-                std::cout << "done" << std::endl;
+                structureIndices.push_back(i);
             }
+
+            std::cout << "creating " << structureIndices.size() << " masks...";
+            maskVector = createMasks(appData._dose, appData._struct, structureIndices,
+                !appData._noStrictVoxelization);
+            std::cout << "done" << std::endl;
             std::cout << "writing mask to file...";
             writeMaskToFile(maskVector, appData._outputFilename, appData._binaryVoxelization);
             std::cout << "done" << std::endl;
@@ -179,12 +182,21 @@ void rttb::apps::voxelizerTool::processData(rttb::apps::voxelizerTool::Applicati
                 maxIterationCount = appData._struct->getNumberOfStructures();
             }
 
+            std::vector<size_t> structureIndices;
+
             for (size_t i = 0; i<maxIterationCount; i++)
             {
-                std::cout << "creating mask #" << i << "...";
-                auto currentMask = createMask(appData._dose, appData._struct->getStructure(i),
-                    !appData._noStrictVoxelization);
-                std::cout << "done" << std::endl;
+                structureIndices.push_back(i);
+            }
+
+            std::cout << "creating " << structureIndices.size() << " masks...";
+            maskVector = createMasks(appData._dose, appData._struct, structureIndices,
+                !appData._noStrictVoxelization);
+            std::cout << "done" << std::endl;
+
+            for (size_t i = 0; i<maxIterationCount; i++)
+            {
+                auto currentMask = maskVector.at(i);
                 std::string labelOfInterest = appData._struct->getStructure(i)->getLabel();
                 removeSpecialCharacters(labelOfInterest);
 
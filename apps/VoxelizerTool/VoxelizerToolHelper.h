@@ -17,6 +17,7 @@
 #include <vector>
 
 #include "rttbStructure.h"
+#include "rttbStructureSet.h"
 #include "rttbMaskAccessorInterface.h"
 #include "rttbITKImageMaskAccessor.h"
 #include "rttbDoseAccessorInterface.h"
@@ -37,13 +38,14 @@ namespace rttb
 			*/
 			void removeSpecialCharacters(std::string& label);
 
-            /**@brief create a mask with _rtStructureSet and _doseAccessor object.
-            @return a mask object
+            /**@brief create the masks of the given structures of the structure set on the geometry of the dose accessor.
+            The structures are voxelized concurrently.
+            @return the mask objects in the order of structureIndices
             */
-            core::MaskAccessorInterface::Pointer createMask(
+            std::vector<core::MaskAccessorInterface::Pointer> createMasks(
                 core::DoseAccessorInterface::Pointer doseAccessorPtr,
-              rttb::core::Structure::Pointer structurePtr,
-                bool strict);
+                core::StructureSet::Pointer structureSetPtr,
+                const std::vector<size_t>& structureIndices, bool strict);
 
             /**@brief write the mask into the outputfile
             @param Outputfilename
@@ -1,6 +1,7 @@
 SET(CPP_FILES 
   rttbDoseStatistics.cpp
   rttbDoseStatisticsCalculator.cpp
+  rttbSortedDoseSampleStore.cpp
   rttbArithmetic.cpp
   
   rttbVolumeToDoseMeasureCollectionCalculator.cpp
@@ -21,6 +22,7 @@ SET(CPP_FILES
 SET(H_FILES 
   rttbDoseStatistics.h
   rttbDoseStatisticsCalculator.h
+  rttbSortedDoseSampleStore.h
   rttbArithmetic.h
   rttbBinaryFunctorAccessor.h
   
@@ -85,6 +85,15 @@ namespace rttb
 			{
 				return IDType();
 			}
+
+		protected:
+			/*! @brief Gets the values of both operands in bulk and applies the functor to them.*/
+			void getValuesUnchecked(const VoxelGridID aFirstID, const size_t aNumberOfValues,
+			                        GenericValueType* aValues) const override;
+
+			/*! @brief Gathers the values of both operands in bulk and applies the functor to them.*/
+			void gatherValuesUnchecked(const VoxelGridID* aSortedIDs, const size_t aNumberOfIDs,
+			                           GenericValueType* aValues) const override;
 		};
 	}
 }
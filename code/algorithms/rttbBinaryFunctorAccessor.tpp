@@ -18,6 +18,8 @@
 #ifndef __BINARY_FUNCTOR_ACCESSOR_TPP
 #define __BINARY_FUNCTOR_ACCESSOR_TPP
 
+#include <vector>
+
 namespace rttb
 {
 	namespace algorithms
@@ -71,6 +73,32 @@ namespace rttb
 			}
 		}
 
+		template <class TDoseOperation> void BinaryFunctorAccessor<TDoseOperation>::getValuesUnchecked(
+		    const VoxelGridID aFirstID, const size_t aNumberOfValues, GenericValueType* aValues) const
+		{
+			std::vector<GenericValueType> values2(aNumberOfValues);
+			_spData1->getValues(aFirstID, aNumberOfValues, aValues);
+			_spData2->getValues(aFirstID, aNumberOfValues, values2.data());
+
+			for (size_t i = 0; i < aNumberOfValues; ++i)
+			{
+				aValues[i] = _functor.calc(aValues[i], values2[i]);
+			}
+		}
+
+		template <class TDoseOperation> void BinaryFunctorAccessor<TDoseOperation>::gatherValuesUnchecked(
+		    const VoxelGridID* aSortedIDs, const size_t aNumberOfIDs, GenericValueType* aValues) const
+		{
+			std::vector<GenericValueType> values2(aNumberOfIDs);
+			_spData1->gatherValues(aSortedIDs, aNumberOfIDs, aValues);
+			_spData2->gatherValues(aSortedIDs, aNumberOfIDs, values2.data());
+
+			for (size_t i = 0; i < aNumberOfIDs; ++i)
+			{
+				aValues[i] = _functor.calc(aValues[i], values2[i]);
+			}
+		}
+
 	}
 }
 #endif
\ No newline at end of file
@@ -240,6 +240,31 @@ namespace rttb
 			return iterator;
 		}
 
+		void DoseStatistics::setSampleStore(SortedDoseSampleStore::ConstPointer sampleStore)
+		{
+			_sampleStore = sampleStore;
+		}
+
+		void DoseStatistics::releaseSampleStore()
+		{
+			_sampleStore.reset();
+		}
+
+		bool DoseStatistics::hasSampleStore() const
+		{
+			return _sampleStore != nullptr;
+		}
+
+		const SortedDoseSampleStore& DoseStatistics::getSampleStore() const
+		{
+			if (!_sampleStore)
+			{
+				throw core::DataNotAvailableException("No sorted dose values are available, only precomputed values can be requested");
+			}
+
+			return *_sampleStore;
+		}
+
 		DoseStatistics::ResultListPointer DoseStatistics::getMaximumVoxelPositions() const
 		{
 			return _maximumVoxelPositions;
@@ -280,6 +305,36 @@ namespace rttb
 			return *_MinOCx;
 		}
 
+		VolumeType DoseStatistics::computeVx(DoseTypeGy xDoseAbsolute) const
+		{
+			return getSampleStore().computeVx(xDoseAbsolute);
+		}
+
+		DoseTypeGy DoseStatistics::computeDx(VolumeType xVolumeAbsolute) const
+		{
+			return getSampleStore().computeDx(xVolumeAbsolute, _minimum);
+		}
+
+		DoseTypeGy DoseStatistics::computeMOHx(VolumeType xVolumeAbsolute) const
+		{
+			return getSampleStore().computeMOHx(xVolumeAbsolute);
+		}
+
+		DoseTypeGy DoseStatistics::computeMOCx(VolumeType xVolumeAbsolute) const
+		{
+			return getSampleStore().computeMOCx(xVolumeAbsolute);
+		}
+
+		DoseTypeGy DoseStatistics::computeMaxOHx(VolumeType xVolumeAbsolute) const
+		{
+			return getSampleStore().computeMaxOHx(xVolumeAbsolute);
+		}
+
+		DoseTypeGy DoseStatistics::computeMinOCx(VolumeType xVolumeAbsolute) const
+		{
+			return getSampleStore().computeMinOCx(xVolumeAbsolute, _minimum, _maximum);
+		}
+
 
 
 	}//end namespace algorithms
@@ -29,6 +29,7 @@
 
 #include "rttbVolumeToDoseMeasureCollection.h"
 #include "rttbDoseToVolumeMeasureCollection.h"
+#include "rttbSortedDoseSampleStore.h"
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -43,6 +44,8 @@ namespace rttb
 
 		/*! @class DoseStatistics
 		@brief This is a data class storing different statistical values from a rt dose distribution
+		@details The complex statistics are stored for the precomputed x values (getDx(), getVx()...). If the sorted dose values
+		are attached (setSampleStore(), done by DoseStatisticsCalculator), they can be computed for any x as well (computeDx(), computeVx()...).
 		@sa DoseStatisticsCalculator
 		*/
 		class RTTBAlgorithms_EXPORT DoseStatistics
@@ -73,6 +76,10 @@ namespace rttb
 			VolumeToDoseMeasureCollection::Pointer _MaxOHx;
 			VolumeToDoseMeasureCollection::Pointer _MinOCx;
       DoseTypeGy _referenceDose; //for Vx computation
+			SortedDoseSampleStore::ConstPointer _sampleStore;
+
+			/*! @exception DataNotAvailableException if no sample store is attached*/
+			const SortedDoseSampleStore& getSampleStore() const;
 
 		public:
 			/*! @brief Standard Constructor
@@ -107,6 +114,16 @@ namespace rttb
 			void setMinOCx(VolumeToDoseMeasureCollection::Pointer MinOCxValues);
 			void setReferenceDose(DoseTypeGy referenceDose);
 
+			/*! @brief Attaches the sorted dose values, so the complex statistics can be computed for any x.*/
+			void setSampleStore(SortedDoseSampleStore::ConstPointer sampleStore);
+
+			/*! @brief Releases the sorted dose values (see SortedDoseSampleStore::getMemorySize()), only the precomputed complex
+				statistics are available afterwards. Must not be called while the statistics are queried by other threads.
+			*/
+			void releaseSampleStore();
+
+			bool hasSampleStore() const;
+
 			/*! @brief Get number of voxels in doseIterator, with sub-voxel accuracy.
 			*/
 			VoxelNumberType getNumberOfVoxels() const;
@@ -160,6 +177,31 @@ namespace rttb
 			VolumeToDoseMeasureCollection getMOCx() const;
 			VolumeToDoseMeasureCollection getMaxOHx() const;
 			VolumeToDoseMeasureCollection getMinOCx() const;
+
+			/*! @brief Computes the volume irradiated with a dose >= xDoseAbsolute in O(log n), also for x values that were not precomputed.
+				@exception DataNotAvailableException if no sample store is attached
+			*/
+			VolumeType computeVx(DoseTypeGy xDoseAbsolute) const;
+			/*! @brief Computes the minimal dose delivered to the volume xVolumeAbsolute in O(log n)
+				@exception DataNotAvailableException if no sample store is attached
+			*/
+			DoseTypeGy computeDx(VolumeType xVolumeAbsolute) const;
+			/*! @brief Computes the mean dose of the hottest volume xVolumeAbsolute in O(log n)
+				@exception DataNotAvailableException if no sample store is attached
+			*/
+			DoseTypeGy computeMOHx(VolumeType xVolumeAbsolute) const;
+			/*! @brief Computes the mean dose of the coldest volume xVolumeAbsolute in O(log n)
+				@exception DataNotAvailableException if no sample store is attached
+			*/
+			DoseTypeGy computeMOCx(VolumeType xVolumeAbsolute) const;
+			/*! @brief Computes the maximum dose outside of the hottest volume xVolumeAbsolute in O(log n)
+				@exception DataNotAvailableException if no sample store is attached
+			*/
+			DoseTypeGy computeMaxOHx(VolumeType xVolumeAbsolute) const;
+			/*! @brief Computes the minimum dose outside of the coldest volume xVolumeAbsolute in O(log n)
+				@exception DataNotAvailableException if no sample store is attached
+			*/
+			DoseTypeGy computeMinOCx(VolumeType xVolumeAbsolute) const;
 		};
 
 	}
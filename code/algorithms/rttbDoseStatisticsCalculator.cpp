@@ -15,6 +15,10 @@
 
 #include "rttbDoseStatisticsCalculator.h"
 
+#include <algorithm>
+#include <functional>
+#include <utility>
+
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/assign/list_of.hpp>
@@ -22,6 +26,8 @@
 #include "rttbNullPointerException.h"
 #include "rttbInvalidDoseException.h"
 #include "rttbInvalidParameterException.h"
+#include "rttbThreadPool.h"
+#include "rttbParallelSort.h"
 
 namespace rttb
 {
@@ -45,6 +51,10 @@ namespace rttb
 
 			_multiThreading = false;
 			_mutex = ::boost::make_shared<std::mutex>();
+
+			_dvhCalculationEnabled = false;
+			_dvhDeltaD = 0;
+			_dvhNumberOfBins = 0;
 		}
 
 
@@ -136,11 +146,10 @@ namespace rttb
 		void DoseStatisticsCalculator::calculateSimpleDoseStatistics(unsigned int maxNumberMinimaPositions,
 			unsigned int maxNumberMaximaPositions)
 		{
-			_doseVector.clear();
-			_voxelProportionVector.clear();
+			_sampleStore.reset();
 
-			std::multimap<double, int> doseValueVSIndexMap;
-			std::vector<double> voxelProportionVectorTemp;
+			//dose values with their voxel proportions, contiguous for sorting
+			std::vector<std::pair<DoseTypeGy, FractionType>> doseSamples;
 
 
 			DoseStatisticType maximumDose = 0;
@@ -154,6 +163,10 @@ namespace rttb
 			DoseTypeGy squareSum = 0;
 			VolumeType volume = 0;
 
+			//the first positions with the current extreme dose, they are discarded if a new extreme is found
+			ResultListPointer maximumVoxelPositions = boost::make_shared<std::vector<std::pair<DoseTypeGy, VoxelGridID> > >();
+			ResultListPointer minimumVoxelPositions = boost::make_shared<std::vector<std::pair<DoseTypeGy, VoxelGridID> > >();
+
 			_doseIterator->reset();
 			int i = 0;
 			DoseTypeGy doseValue = 0;
@@ -177,14 +190,25 @@ namespace rttb
 				if (doseValue > maximumDose)
 				{
 					maximumDose = doseValue;
+					maximumVoxelPositions->clear();
 				}
 				else if (doseValue < minimumDose)
 				{
 					minimumDose = doseValue;
+					minimumVoxelPositions->clear();
+				}
+
+				if (doseValue == maximumDose && maximumVoxelPositions->size() < maxNumberMaximaPositions)
+				{
+					maximumVoxelPositions->push_back(std::make_pair(doseValue, _doseIterator->getCurrentVoxelGridID()));
+				}
+
+				if (doseValue == minimumDose && minimumVoxelPositions->size() < maxNumberMinimaPositions)
+				{
+					minimumVoxelPositions->push_back(std::make_pair(doseValue, _doseIterator->getCurrentVoxelGridID()));
 				}
 
-				voxelProportionVectorTemp.push_back(voxelProportion);
-				doseValueVSIndexMap.insert(std::pair<double, int>(doseValue, i));
+				doseSamples.emplace_back(doseValue, voxelProportion);
 
 				i++;
 				_doseIterator->next();
@@ -216,11 +240,67 @@ namespace rttb
 
 			}
 
-			//sort dose values and corresponding volume fractions in member variables
-			for (auto & it : doseValueVSIndexMap)
+			//the DVH is binned from the collected dose values as well (same bins as core::DVHCalculator)
+			core::DVH::DataDifferentialType dvhDataDifferential;
+			DoseTypeGy dvhDeltaD = _dvhDeltaD;
+
+			if (_dvhCalculationEnabled)
+			{
+				if (dvhDeltaD == 0)
+				{
+					dvhDeltaD = std::max(maximumDose, 0.0) * 1.5 / _dvhNumberOfBins;
+
+					if (dvhDeltaD == 0)
+					{
+						dvhDeltaD = 0.1;
+					}
+				}
+
+				dvhDataDifferential.assign(_dvhNumberOfBins, 0);
+			}
+
+			//sort dose values and corresponding volume fractions, stable to keep equal doses in iteration order
+			core::parallelStableSort(doseSamples.begin(), doseSamples.end(), [](const std::pair<DoseTypeGy, FractionType>& a,
+			                         const std::pair<DoseTypeGy, FractionType>& b)
+			{
+				return a.first < b.first;
+			});
+
+			std::vector<DoseTypeGy> doseVector;
+			std::vector<double> voxelProportionVector;
+			doseVector.reserve(doseSamples.size());
+			voxelProportionVector.reserve(doseSamples.size());
+
+			for (const auto& sample : doseSamples)
+			{
+				const FractionType voxelProportion = sample.second;
+				doseVector.push_back(sample.first);
+				voxelProportionVector.push_back(voxelProportion);
+
+				if (_dvhCalculationEnabled)
+				{
+					auto dose_bin = static_cast<int>(sample.first / dvhDeltaD);
+
+					if (dose_bin < _dvhNumberOfBins)
+					{
+						dvhDataDifferential[dose_bin] += voxelProportion;
+					}
+					else
+					{
+						throw core::InvalidParameterException("_numberOfBins is too small: dose bin out of bounds! ");
+					}
+				}
+			}
+
+			doseSamples.clear();
+			doseSamples.shrink_to_fit();
+			_sampleStore = boost::make_shared<SortedDoseSampleStore>(std::move(doseVector), std::move(voxelProportionVector),
+			               _doseIterator->getCurrentVoxelVolume());
+
+			if (_dvhCalculationEnabled)
 			{
-				_doseVector.push_back((float)it.first);
-				_voxelProportionVector.push_back(voxelProportionVectorTemp.at(it.second));
+				_dvh = boost::make_shared<core::DVH>(dvhDataDifferential, dvhDeltaD, _doseIterator->getCurrentVoxelVolume(),
+				                                     _dvhStructureID, _dvhDoseID);
 			}
 
 			volume *= numVoxels;
@@ -231,11 +311,9 @@ namespace rttb
 
 			_simpleDoseStatisticsCalculated = true;
 
-			ResultListPointer minimumVoxelPositions = computeMinimumPositions(maxNumberMinimaPositions);
-			ResultListPointer maximumVoxelPositions = computeMaximumPositions(maxNumberMaximaPositions);
-
 			_statistics->setMinimumVoxelPositions(minimumVoxelPositions);
 			_statistics->setMaximumVoxelPositions(maximumVoxelPositions);
+			_statistics->setSampleStore(_sampleStore);
 		}
 
 
@@ -266,28 +344,25 @@ namespace rttb
 				precomputeVolumeValuesNonConst = defaultPrecomputeVolumeValues;
 			}
 
-			_Vx = ::boost::make_shared<VxDoseToVolumeMeasureCollectionCalculator>(precomputeDoseValuesNonConst, referenceDose, _doseIterator);
-			_Vx->compute();
+			_Vx = ::boost::make_shared<VxDoseToVolumeMeasureCollectionCalculator>(precomputeDoseValuesNonConst, referenceDose,
+				_sampleStore, _multiThreading);
 
 			_Dx = ::boost::make_shared<DxVolumeToDoseMeasureCollectionCalculator>(precomputeVolumeValuesNonConst, _statistics->getVolume(),
-				this->_doseVector, this->_voxelProportionVector, this->_doseIterator->getCurrentVoxelVolume(), _statistics->getMinimum());
-			_Dx->compute();
+				_sampleStore, _statistics->getMinimum(), _multiThreading);
 
 			_MOHx = ::boost::make_shared<MOHxVolumeToDoseMeasureCollectionCalculator>(precomputeVolumeValuesNonConst, _statistics->getVolume(),
-				this->_doseVector, this->_voxelProportionVector, this->_doseIterator->getCurrentVoxelVolume());
-			_MOHx->compute();
+				_sampleStore, _multiThreading);
 
 			_MOCx = ::boost::make_shared<MOCxVolumeToDoseMeasureCollectionCalculator>(precomputeVolumeValuesNonConst, _statistics->getVolume(),
-				this->_doseVector, this->_voxelProportionVector, this->_doseIterator->getCurrentVoxelVolume());
-			_MOCx->compute();
+				_sampleStore, _multiThreading);
 
 			_MaxOHx = ::boost::make_shared<MaxOHxVolumeToDoseMeasureCollectionCalculator>(precomputeVolumeValuesNonConst, _statistics->getVolume(),
-				this->_doseVector, this->_voxelProportionVector, this->_doseIterator->getCurrentVoxelVolume());
-			_MaxOHx->compute();
+				_sampleStore, _multiThreading);
 
 			_MinOCx = ::boost::make_shared<MinOCxVolumeToDoseMeasureCollectionCalculator>(precomputeVolumeValuesNonConst, _statistics->getVolume(),
-				this->_doseVector, this->_voxelProportionVector, this->_doseIterator->getCurrentVoxelVolume(), _statistics->getMinimum(), _statistics->getMaximum());
-			_MinOCx->compute();
+				_sampleStore, _statistics->getMinimum(), _statistics->getMaximum(), _multiThreading);
+
+			computeComplexDoseStatistics();
 
 			_statistics->setVx(_Vx->getMeasureCollection());
 			_statistics->setDx(_Dx->getMeasureCollection());
@@ -318,91 +393,59 @@ namespace rttb
 			{
 				throw core::InvalidDoseException("Complex DoseStatistics have to be computed in order to call recalculateDoseStatistics()");
 			}
-			_Vx->compute();			
-			_Dx->compute();
-			_MOHx->compute();
-			_MOCx->compute();
-			_MaxOHx->compute();
-			_MinOCx->compute();
+			computeComplexDoseStatistics();
 		}
 
-		DoseStatisticsCalculator::ResultListPointer DoseStatisticsCalculator::computeMaximumPositions(
-			unsigned int maxNumberMaxima) const
+		void DoseStatisticsCalculator::computeComplexDoseStatistics()
 		{
-			if (!_simpleDoseStatisticsCalculated)
-			{
-				throw core::InvalidDoseException("simple DoseStatistics have to be computed in order to call computeMaximumPositions()");
-			}
+			const std::vector<std::function<void()>> computations = { [this]() { _Vx->compute(); }, [this]() { _Dx->compute(); },
+				[this]() { _MOHx->compute(); }, [this]() { _MOCx->compute(); }, [this]() { _MaxOHx->compute(); },
+				[this]() { _MinOCx->compute(); } };
 
-			ResultListPointer maxVoxelVector =
-				boost::make_shared<std::vector<std::pair<DoseTypeGy, VoxelGridID> > >();
-
-			unsigned int count = 0;
-			this->_doseIterator->reset();
-			DoseTypeGy doseValue = 0;
-
-			while (_doseIterator->isPositionValid() && count < maxNumberMaxima)
+			if (_multiThreading)
 			{
-				doseValue = _doseIterator->getCurrentDoseValue();
+				//the calculators share no state, the values of each calculator are computed concurrently as well
+				core::TaskGroup tasks;
 
-				if (doseValue == _statistics->getMaximum())
+				for (const auto& computation : computations)
 				{
-					VoxelGridID currentID = _doseIterator->getCurrentVoxelGridID();
-					std::pair<DoseTypeGy, VoxelGridID> voxel(doseValue, currentID);
-					maxVoxelVector->push_back(voxel);
-					count++;
+					tasks.run(computation);
 				}
 
-				_doseIterator->next();
+				tasks.wait();
 			}
-
-			return maxVoxelVector;
-		}
-
-		DoseStatisticsCalculator::ResultListPointer DoseStatisticsCalculator::computeMinimumPositions(
-			unsigned int maxNumberMinima) const
-		{
-			if (!_simpleDoseStatisticsCalculated)
+			else
 			{
-				throw core::InvalidDoseException("simple DoseStatistics have to be computed in order to call computeMinimumPositions()");
-
+				for (const auto& computation : computations)
+				{
+					computation();
+				}
 			}
+		}
 
-			ResultListPointer minVoxelVector =
-				boost::make_shared<std::vector<std::pair<DoseTypeGy, VoxelGridID> > >();
-
-			/*! @todo: Architecture Annotation:
-				Finding the positions for the minimum only once reduces computation time,
-				but will require sensible use by the programmers. To be save the output vector
-				minVoxelVector will be always cleared here to garantee that no false values are
-				presented. This change may be revoced to increase computation speed later on
-				(only compute if(minVoxelVector->size()==0)).
-				*/
-			unsigned int count = 0;
-			this->_doseIterator->reset();
-			DoseTypeGy doseValue = 0;
+		void DoseStatisticsCalculator::setMultiThreading(const bool choice) 
+		{
+			_multiThreading = choice;
+		}
 
-			while (_doseIterator->isPositionValid() && count < maxNumberMinima)
+		void DoseStatisticsCalculator::enableDVHCalculation(const IDType& aStructureID, const IDType& aDoseID,
+		        DoseTypeGy aDeltaD, int aNumberOfBins)
+		{
+			if (aNumberOfBins <= 0 || aDeltaD < 0)
 			{
-				doseValue = _doseIterator->getCurrentDoseValue();
-
-				if (doseValue == _statistics->getMinimum())
-				{
-					VoxelGridID currentID = _doseIterator->getCurrentVoxelGridID();
-					std::pair<DoseTypeGy, VoxelGridID> voxel(doseValue, currentID);
-					minVoxelVector->push_back(voxel);
-					count++;
-				}
-
-				_doseIterator->next();
+				throw core::InvalidParameterException("aNumberOfBins/aDeltaD must be >0! ");
 			}
 
-			return minVoxelVector;
+			_dvhCalculationEnabled = true;
+			_dvhStructureID = aStructureID;
+			_dvhDoseID = aDoseID;
+			_dvhDeltaD = aDeltaD;
+			_dvhNumberOfBins = aNumberOfBins;
 		}
 
-		void DoseStatisticsCalculator::setMultiThreading(const bool choice) 
+		core::DVH::Pointer DoseStatisticsCalculator::getDVH() const
 		{
-			_multiThreading = choice;
+			return _dvh;
 		}
 
 	}//end namespace algorithms
@@ -23,6 +23,7 @@
 
 #include "rttbDoseIteratorInterface.h"
 #include "rttbDoseStatistics.h"
+#include "rttbDVH.h"
 
 #include "RTTBAlgorithmsExports.h"
 
@@ -49,7 +50,11 @@ namespace rttb
 		@details These values range from standard statistical values such as minimum, maximum and mean to more
 		complex dose specific measures such as Vx (volume irradiated with a dose >=x), Dx (minimal dose delivered
 		to x% of the VOI) or MOHx (mean in the hottest volume). For a complete list, see calculateDoseStatistics().
-		@note the complex dose statistics are precomputed and cannot be computed "on the fly" lateron! The doses/volumes that should be used for precomputation have to be set in calculateDoseStatistics()
+		@note the complex dose statistics are precomputed for the doses/volumes set in calculateDoseStatistics(). Other doses/volumes
+		can be computed "on the fly" lateron with DoseStatistics::computeVx(), computeDx()... as long as the sorted dose values
+		are not released (DoseStatistics::releaseSampleStore()).
+		@details If the DVH is needed as well, enableDVHCalculation() computes it from the dose values collected for the statistics,
+		so the dose is traversed only once for both.
 		*/
 		class RTTBAlgorithms_EXPORT DoseStatisticsCalculator
 		{
@@ -61,13 +66,11 @@ namespace rttb
 		private:
 			DoseIteratorPointer _doseIterator;
 
-			/*! @brief Contains relevant dose values sorted in descending order.
+			/*! @brief Contains relevant dose values sorted in ascending order with the corresponding voxel proportions.
+				Shared with the calculators of the complex statistics and the DoseStatistics.
 			*/
-			std::vector<DoseTypeGy> _doseVector;
+			SortedDoseSampleStore::Pointer _sampleStore;
 
-			/*! @brief Contains the corresponding voxel proportions to the values in doseVector.
-			*/
-			std::vector<double> _voxelProportionVector;
 			/*! @brief The doseStatistics are stored here.
 			*/
 			DoseStatisticsPointer _statistics;
@@ -77,6 +80,14 @@ namespace rttb
 
 			bool _multiThreading;
 
+			/*! @brief DVH computed together with the simple dose statistics (see enableDVHCalculation())*/
+			bool _dvhCalculationEnabled;
+			IDType _dvhStructureID;
+			IDType _dvhDoseID;
+			DoseTypeGy _dvhDeltaD;
+			int _dvhNumberOfBins;
+			core::DVH::Pointer _dvh;
+
 			::boost::shared_ptr<std::mutex> _mutex;
 
 			VxDoseToVolumeMeasureCollectionCalculator::Pointer _Vx;
@@ -86,18 +97,9 @@ namespace rttb
 			MaxOHxVolumeToDoseMeasureCollectionCalculator::Pointer _MaxOHx;
 			MinOCxVolumeToDoseMeasureCollectionCalculator::Pointer _MinOCx;
 
-			/*! @brief Calculates the positions where the dose has its maximum
-				@param maxNumberMaximaPositions the maximal amount of computed positions
-				@pre maximumDose must be defined in _statistics with the correct value
-			*/
-			ResultListPointer computeMaximumPositions(unsigned int maxNumberMaximaPositions) const;
-			/*! @brief Calculates the positions where the dose has its minimum
-				@param maxNumberMinimaPositions the maximal amount of computed positions (they are read sequentially using the iterator until maxNumberMinimaPositions have been read, other positions are not considered)
-				@pre minimumDose must be defined in _statistics with the correct value
-			*/
-			ResultListPointer computeMinimumPositions(unsigned int maxNumberMinimaPositions) const;
-			
 			/*! @brief Calculates simple dose statistics (min, mean, max, stdDev, minDosePositions, maxDosePositions)
+				@details All values are collected in one traversal of the dose iterator, the positions are the first ones (in iteration
+				order) with the minimum/maximum dose.
 				@param maxNumberMinimaPositions the maximal amount of computed positions where the dose has its minimum that is computed
 				@param maxNumberMaximaPositions the maximal amount of computed positions where the dose has its maximum that is computed
 			*/
@@ -110,6 +112,8 @@ namespace rttb
 			                                    const std::vector<double>& precomputeDoseValues,
 			                                    const std::vector<double>& precomputeVolumeValues);
 
+			/*! @brief Computes the not yet computed values of the six complex dose statistics, concurrently if multi threading is set*/
+			void computeComplexDoseStatistics();
 
 		public:
 			~DoseStatisticsCalculator();
@@ -146,7 +150,7 @@ namespace rttb
 			@param maxNumberMinimaPositions the maximal amount of computed positions where the dose has its minimum that is computed
 			@param maxNumberMaximaPositions the maximal amount of computed positions where the dose has its maximum that is computed
 			@warning If computeComplexMeasures==true, computations can take quite long (>1 min) for large structures as many statistics are precomputed
-			@note The complex dose statistics are precomputed and cannot be computed "on the fly" lateron! Only the default x values can be requested in DoseStatistics!
+			@note The complex dose statistics are precomputed for the default x values only! Other x values can be computed with DoseStatistics::computeVx(), computeDx()...
 			*/
 			DoseStatisticsPointer calculateDoseStatistics(bool computeComplexMeasures = false,
 			        unsigned int maxNumberMinimaPositions = 10,
@@ -158,7 +162,7 @@ namespace rttb
 			@param maxNumberMaximaPositions the maximal amount of computed positions where the dose has its maximum that is computed
 			@exception InvalidParameterException thrown if referenceDose <= 0
 			@warning Computations can take quite long (>1 min) for large structures as many statistics are precomputed
-			@note The complex dose statistics are precomputed and cannot be computed "on the fly" lateron! Only the default x values can be requested in DoseStatistics!
+			@note The complex dose statistics are precomputed for the default x values only! Other x values can be computed with DoseStatistics::computeVx(), computeDx()...
 			*/
 			DoseStatisticsPointer calculateDoseStatistics(DoseTypeGy referenceDose,
 			        unsigned int maxNumberMinimaPositions = 10,
@@ -171,7 +175,7 @@ namespace rttb
 			@param maxNumberMinimaPositions the maximal amount of computed positions where the dose has its minimum that is computed
 			@param maxNumberMaximaPositions the maximal amount of computed positions where the dose has its maximum that is computed
 			@warning Computations can take quite long (>1 min) for large structures as many statistics are precomputed
-			@note The complex dose statistics are precomputed and cannot be computed "on the fly" lateron! The doses/volumes that should be used for precomputation have to be set by in precomputeDoseValues and precomputeVolumeValues. Only these values can be requested in DoseStatistics!
+			@note The complex dose statistics are precomputed for precomputeDoseValues and precomputeVolumeValues only! Other values can be computed with DoseStatistics::computeVx(), computeDx()...
 			*/
 			DoseStatisticsPointer calculateDoseStatistics(const std::vector<double>& precomputeDoseValues,
 			        const std::vector<double>& precomputeVolumeValues, DoseTypeGy referenceDose = -1,
@@ -188,7 +192,21 @@ namespace rttb
 			*/
 			void recalculateDoseStatistics();
 
+			/*! @brief If set, the complex dose statistics and their values are computed concurrently on the core::ThreadPool*/
 			void setMultiThreading(bool choice);
+
+			/*! @brief The following calculateDoseStatistics() calls compute the DVH as well, from the same traversal of the dose.
+				The DVH is the same as computed by core::DVHCalculator with these parameters (up to the summation order of the bins).
+				@param aDeltaD the absolute dose value in Gy for dose_bin [i,i+1). If aDeltaD==0, it will be calculated using
+				aDeltaD=maximum dose*1.5/aNumberOfBins
+				@exception InvalidParameterException thrown if aNumberOfBins<=0 or aDeltaD<0
+				@remark calculateDoseStatistics() throws an InvalidParameterException if the maximum dose does not fit into the bins.
+			*/
+			void enableDVHCalculation(const IDType& aStructureID, const IDType& aDoseID, DoseTypeGy aDeltaD = 0,
+			                          int aNumberOfBins = 201);
+
+			/*! @brief The DVH of the last calculateDoseStatistics() call or nullptr if enableDVHCalculation() was not called before.*/
+			core::DVH::Pointer getDVH() const;
 		};
 
 	}
@@ -15,10 +15,11 @@
 
 #include "rttbDoseToVolumeMeasureCollectionCalculator.h"
 
-#include <thread>
+#include <vector>
 
 #include "rttbInvalidParameterException.h"
 #include "rttbUtils.h"
+#include "rttbThreadPool.h"
 
 #include <boost/make_shared.hpp>
 
@@ -37,29 +38,47 @@ namespace rttb
 
 		void DoseToVolumeMeasureCollectionCalculator::compute()
 		{
-			std::vector<std::thread> threads;
+			std::vector<double> xAbsoluteValues;
 
 			for (double _precomputeDoseValue : _precomputeDoseValues)
 			{
 				double xAbsolute = _precomputeDoseValue * _referenceDose;
-				if (!rttb::core::isKey(_measureCollection->getAllValues(), xAbsolute)) {
-					if (_multiThreading)
-					{
-						throw rttb::core::InvalidParameterException("MultiThreading is not implemented yet.");
-					}
-					else
+				if (!rttb::core::isKey(_measureCollection->getAllValues(), xAbsolute) && !rttb::core::isKey(xAbsoluteValues, xAbsolute)) {
+					xAbsoluteValues.push_back(xAbsolute);
+				}
+			}
+
+			std::vector<VolumeType> results(xAbsoluteValues.size());
+
+			if (_multiThreading)
+			{
+				//the values are computed concurrently and inserted afterwards by this thread
+				core::TaskGroup tasks;
+
+				for (size_t i = 0; i < xAbsoluteValues.size(); ++i)
+				{
+					tasks.run([this, &xAbsoluteValues, &results, i]()
 					{
-						insertIntoMeasureCollection(xAbsolute, this->computeSpecificValue(xAbsolute));
-					}
+						results[i] = this->computeSpecificValue(xAbsoluteValues[i]);
+					});
+				}
+
+				tasks.wait();
+			}
+			else
+			{
+				for (size_t i = 0; i < xAbsoluteValues.size(); ++i)
+				{
+					results[i] = this->computeSpecificValue(xAbsoluteValues[i]);
 				}
 			}
 
-			for (auto & thread : threads)
+			for (size_t i = 0; i < xAbsoluteValues.size(); ++i)
 			{
-				thread.join();
+				insertIntoMeasureCollection(xAbsoluteValues[i], results[i]);
 			}
 		}
-		
+
 		void DoseToVolumeMeasureCollectionCalculator::addPrecomputeDoseValues(const std::vector<double>& values)
 		{
 			for (double value : values) {
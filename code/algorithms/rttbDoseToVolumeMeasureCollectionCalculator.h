@@ -62,6 +62,7 @@ namespace rttb
 
 		public:
 			/*! @brief Computes not already computed values for the measureCollection. Algorithm for the specific complex Statistic has to be implemented in the corresponding subclass.
+				If multiThreading is set, the values are computed concurrently on the core::ThreadPool.
 			*/
 			void compute();
 			/*! @brief Adds additional values to the _precomputeDoseValues vector.
@@ -78,7 +79,7 @@ namespace rttb
 			void insertIntoMeasureCollection(DoseTypeGy xAbsolute, VolumeType resultVolume);
 
 			/*! @brief Computes the specific VolumeType depending on the complext statistic
-			@note has to be overwritten
+			@note has to be overwritten, it is called concurrently for different values if multiThreading is set
 			*/
 			virtual VolumeType computeSpecificValue(double xAbsolute) const = 0;
 		};
@@ -26,30 +26,14 @@ namespace rttb
 			VolumeToDoseMeasureCollectionCalculator(precomputeVolumeValues, volume, doseVector, voxelProportionVector, currentVoxelVolume,
 				VolumeToDoseMeasureCollection::Dx, multiThreading), _minimum(minimum) {}
 
+		DxVolumeToDoseMeasureCollectionCalculator::DxVolumeToDoseMeasureCollectionCalculator(const std::vector<double>& precomputeVolumeValues,
+			const VolumeType volume, SortedDoseSampleStore::ConstPointer sampleStore, const DoseStatisticType minimum, bool multiThreading) :
+			VolumeToDoseMeasureCollectionCalculator(precomputeVolumeValues, volume, sampleStore,
+				VolumeToDoseMeasureCollection::Dx, multiThreading), _minimum(minimum) {}
+
 		DoseTypeGy DxVolumeToDoseMeasureCollectionCalculator::computeSpecificValue(double xAbsolute) const
 		{
-			double noOfVoxel = xAbsolute / _currentVoxelVolume;
-			DoseTypeGy resultDose = 0;
-
-			double countVoxels = 0;
-			bool voxelOverflow = false;
-			for (auto i = _doseVector.size() - 1; i != static_cast<size_t>(-1); i--)
-			{
-				countVoxels += _voxelProportionVector.at(i);
-
-				if (countVoxels >= noOfVoxel)
-				{
-					voxelOverflow = true;
-					resultDose = _doseVector.at(i);
-					break;
-				}
-			}
-
-			if (!voxelOverflow)
-			{
-				resultDose = _minimum;
-			}
-			return resultDose;
+			return _sampleStore->computeDx(xAbsolute, _minimum);
 		}
 	}
 }
\ No newline at end of file
@@ -40,6 +40,12 @@ namespace rttb
 				const std::vector<DoseTypeGy>& doseVector, const std::vector<double>& voxelProportionVector, 
 				const DoseVoxelVolumeType currentVoxelVolume, const DoseStatisticType minimum, bool multiThreading = false);
 
+			/*! @brief Uses the sorted dose values of sampleStore, which can be shared with other calculators.
+				@exception NullPointerException if sampleStore is nullptr
+			*/
+			DxVolumeToDoseMeasureCollectionCalculator(const std::vector<double>& precomputeVolumeValues, const VolumeType volume,
+				SortedDoseSampleStore::ConstPointer sampleStore, const DoseStatisticType minimum, bool multiThreading = false);
+
 		protected:
 			DoseTypeGy computeSpecificValue(double xAbsolute) const override;
 		};
@@ -25,33 +25,14 @@ namespace rttb
 			const DoseVoxelVolumeType currentVoxelVolume, bool multiThreading) : VolumeToDoseMeasureCollectionCalculator(precomputeVolumeValues, volume,
 				doseVector, voxelProportionVector, currentVoxelVolume, VolumeToDoseMeasureCollection::MOCx, multiThreading) {}
 
+		MOCxVolumeToDoseMeasureCollectionCalculator::MOCxVolumeToDoseMeasureCollectionCalculator(const std::vector<double>& precomputeVolumeValues,
+			const VolumeType volume, SortedDoseSampleStore::ConstPointer sampleStore, bool multiThreading) :
+			VolumeToDoseMeasureCollectionCalculator(precomputeVolumeValues, volume, sampleStore,
+				VolumeToDoseMeasureCollection::MOCx, multiThreading) {}
+
 		DoseTypeGy MOCxVolumeToDoseMeasureCollectionCalculator::computeSpecificValue(double xAbsolute) const
 		{
-			double noOfVoxel = xAbsolute / _currentVoxelVolume;
-			if (noOfVoxel == 0)
-			{
-				return 0;
-			}
-			else
-			{
-				double countVoxels = 0;
-				double sum = 0;
-				auto it = _doseVector.begin();
-				auto itD = _voxelProportionVector.begin();
-
-				for (; it != _doseVector.end(); ++it, ++itD)
-				{
-					double voxelProportion = *itD;
-					countVoxels += voxelProportion;
-					sum += (*it) * voxelProportion;
-
-					if (countVoxels >= noOfVoxel)
-					{
-						break;
-					}
-				}
-				return static_cast<DoseTypeGy>(sum / noOfVoxel);
-			}
+			return _sampleStore->computeMOCx(xAbsolute);
 		}
 	}
 }
\ No newline at end of file
@@ -26,32 +26,14 @@ namespace rttb
 			VolumeToDoseMeasureCollectionCalculator(precomputeVolumeValues, volume, doseVector, voxelProportionVector, currentVoxelVolume,
 				VolumeToDoseMeasureCollection::MOHx, multiThreading) {}
 
+		MOHxVolumeToDoseMeasureCollectionCalculator::MOHxVolumeToDoseMeasureCollectionCalculator(const std::vector<double>& precomputeVolumeValues,
+			const VolumeType volume, SortedDoseSampleStore::ConstPointer sampleStore, bool multiThreading) :
+			VolumeToDoseMeasureCollectionCalculator(precomputeVolumeValues, volume, sampleStore,
+				VolumeToDoseMeasureCollection::MOHx, multiThreading) {}
+
 		DoseTypeGy MOHxVolumeToDoseMeasureCollectionCalculator::computeSpecificValue(double xAbsolute) const
 		{
-			double noOfVoxel = xAbsolute / _currentVoxelVolume;
-
-			if (noOfVoxel == 0)
-			{
-				return 0;
-			}
-			else
-			{
-				double countVoxels = 0;
-				double sum = 0;
-
-				for (auto i = _doseVector.size() - 1; i!=static_cast<size_t>(-1); i--)
-				{
-					double voxelProportion = _voxelProportionVector.at(i);
-					countVoxels += voxelProportion;
-					sum += _doseVector.at(i) * voxelProportion;
-
-					if (countVoxels >= noOfVoxel)
-					{
-						break;
-					}
-				}
-				return static_cast<DoseTypeGy>(sum / noOfVoxel);
-			}
+			return _sampleStore->computeMOHx(xAbsolute);
 		}
 	}
 }
\ No newline at end of file
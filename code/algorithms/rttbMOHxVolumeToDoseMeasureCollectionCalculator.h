@@ -39,6 +39,12 @@ namespace rttb
 				const std::vector<DoseTypeGy>& doseVector, const std::vector<double>& voxelProportionVector,
 				const DoseVoxelVolumeType currentVoxelVolume, bool multiThreading = false);
 
+			/*! @brief Uses the sorted dose values of sampleStore, which can be shared with other calculators.
+				@exception NullPointerException if sampleStore is nullptr
+			*/
+			MOHxVolumeToDoseMeasureCollectionCalculator(const std::vector<double>& precomputeVolumeValues, const VolumeType volume,
+				SortedDoseSampleStore::ConstPointer sampleStore, bool multiThreading = false);
+
 		protected:
 			DoseTypeGy computeSpecificValue(double xAbsolute) const override;
 		};
@@ -25,27 +25,14 @@ namespace rttb
 			const DoseVoxelVolumeType currentVoxelVolume, bool multiThreading) : VolumeToDoseMeasureCollectionCalculator(precomputeVolumeValues, volume,
 				doseVector, voxelProportionVector, currentVoxelVolume, VolumeToDoseMeasureCollection::MaxOHx, multiThreading) {}
 
+		MaxOHxVolumeToDoseMeasureCollectionCalculator::MaxOHxVolumeToDoseMeasureCollectionCalculator(const std::vector<double>& precomputeVolumeValues,
+			const VolumeType volume, SortedDoseSampleStore::ConstPointer sampleStore, bool multiThreading) :
+			VolumeToDoseMeasureCollectionCalculator(precomputeVolumeValues, volume, sampleStore,
+				VolumeToDoseMeasureCollection::MaxOHx, multiThreading) {}
+
 		DoseTypeGy MaxOHxVolumeToDoseMeasureCollectionCalculator::computeSpecificValue(double xAbsolute) const
 		{
-			double noOfVoxel = xAbsolute / _currentVoxelVolume;
-			DoseTypeGy resultDose = 0;
-
-			double countVoxels = 0;
-			for (auto i = _doseVector.size() - 1; i!=static_cast<size_t>(-1); i--)
-			{
-				countVoxels += _voxelProportionVector.at(i);
-
-				if (countVoxels >= noOfVoxel)
-				{
-					if (i > 0)
-					{
-						resultDose = _doseVector.at(i - 1);
-					}
-					break;
-				}
-			}
-
-			return resultDose;
+			return _sampleStore->computeMaxOHx(xAbsolute);
 		}
 	}
 }
\ No newline at end of file
@@ -27,43 +27,14 @@ namespace rttb
 				doseVector, voxelProportionVector, currentVoxelVolume, VolumeToDoseMeasureCollection::MinOCx, 
 				multiThreading), _minimum(minimum), _maximum(maximum) {}
 
+		MinOCxVolumeToDoseMeasureCollectionCalculator::MinOCxVolumeToDoseMeasureCollectionCalculator(const std::vector<double>& precomputeVolumeValues,
+			const VolumeType volume, SortedDoseSampleStore::ConstPointer sampleStore, const DoseStatisticType minimum, const DoseStatisticType maximum, bool multiThreading) :
+			VolumeToDoseMeasureCollectionCalculator(precomputeVolumeValues, volume, sampleStore,
+				VolumeToDoseMeasureCollection::MinOCx, multiThreading), _minimum(minimum), _maximum(maximum) {}
+
 		DoseTypeGy MinOCxVolumeToDoseMeasureCollectionCalculator::computeSpecificValue(double xAbsolute) const
 		{
-			double noOfVoxel = xAbsolute / _currentVoxelVolume;
-			DoseTypeGy resultDose = 0;
-
-			double countVoxels = 0;
-			auto it = _doseVector.begin();
-			auto itD = _voxelProportionVector.begin();
-
-			for (; itD != _voxelProportionVector.end(); ++itD, ++it)
-			{
-				countVoxels += *itD;
-
-				if (countVoxels >= noOfVoxel)
-				{
-					break;
-				}
-			}
-
-			if (it != _doseVector.end())
-			{
-				++it;
-
-				if (it != _doseVector.end())
-				{
-					resultDose = *it;
-				}
-				else
-				{
-					resultDose = (DoseTypeGy)_maximum;
-				}
-			}
-			else
-			{
-				resultDose = (DoseTypeGy)_minimum;
-			}
-			return resultDose;
+			return _sampleStore->computeMinOCx(xAbsolute, _minimum, _maximum);
 		}
 	}
 }
\ No newline at end of file
@@ -0,0 +1,205 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+
+#include "rttbSortedDoseSampleStore.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "rttbInvalidParameterException.h"
+
+namespace rttb
+{
+
+	namespace algorithms
+	{
+		SortedDoseSampleStore::SortedDoseSampleStore(std::vector<DoseTypeGy> doseVector,
+		        std::vector<double> voxelProportionVector, DoseVoxelVolumeType voxelVolume) :
+			_doseVector(std::move(doseVector)), _voxelProportionVector(std::move(voxelProportionVector)), _voxelVolume(voxelVolume)
+		{
+			if (_doseVector.size() != _voxelProportionVector.size())
+			{
+				throw core::InvalidParameterException("doseVector and voxelProportionVector must have the same size!");
+			}
+
+			const size_t numberOfSamples = _doseVector.size();
+			_voxelsFromTop.resize(numberOfSamples);
+			_dosesFromTop.resize(numberOfSamples);
+			_voxelsFromBottom.resize(numberOfSamples);
+			_dosesFromBottom.resize(numberOfSamples);
+
+			double countVoxels = 0;
+			double sum = 0;
+
+			for (auto i = numberOfSamples - 1; i != static_cast<size_t>(-1); i--)
+			{
+				countVoxels += _voxelProportionVector[i];
+				sum += _doseVector[i] * _voxelProportionVector[i];
+				_voxelsFromTop[i] = countVoxels;
+				_dosesFromTop[i] = sum;
+			}
+
+			countVoxels = 0;
+			sum = 0;
+
+			for (size_t i = 0; i < numberOfSamples; ++i)
+			{
+				countVoxels += _voxelProportionVector[i];
+				sum += _doseVector[i] * _voxelProportionVector[i];
+				_voxelsFromBottom[i] = countVoxels;
+				_dosesFromBottom[i] = sum;
+			}
+		}
+
+		const std::vector<DoseTypeGy>& SortedDoseSampleStore::getDoseVector() const
+		{
+			return _doseVector;
+		}
+
+		const std::vector<double>& SortedDoseSampleStore::getVoxelProportionVector() const
+		{
+			return _voxelProportionVector;
+		}
+
+		DoseVoxelVolumeType SortedDoseSampleStore::getVoxelVolume() const
+		{
+			return _voxelVolume;
+		}
+
+		size_t SortedDoseSampleStore::size() const
+		{
+			return _doseVector.size();
+		}
+
+		size_t SortedDoseSampleStore::getMemorySize() const
+		{
+			return _doseVector.size() * sizeof(DoseTypeGy) + (_voxelProportionVector.size() + _voxelsFromTop.size() +
+			        _dosesFromTop.size() + _voxelsFromBottom.size() + _dosesFromBottom.size()) * sizeof(double);
+		}
+
+		size_t SortedDoseSampleStore::findFromTop(double noOfVoxel) const
+		{
+			//_voxelsFromTop is non increasing
+			const auto firstTooFew = std::partition_point(_voxelsFromTop.cbegin(), _voxelsFromTop.cend(),
+			                         [noOfVoxel](double countVoxels)
+			{
+				return countVoxels >= noOfVoxel;
+			});
+
+			if (firstTooFew == _voxelsFromTop.cbegin())
+			{
+				return size();
+			}
+
+			return static_cast<size_t>(firstTooFew - _voxelsFromTop.cbegin()) - 1;
+		}
+
+		size_t SortedDoseSampleStore::findFromBottom(double noOfVoxel) const
+		{
+			//_voxelsFromBottom is non decreasing
+			return static_cast<size_t>(std::lower_bound(_voxelsFromBottom.cbegin(), _voxelsFromBottom.cend(),
+			                           noOfVoxel) - _voxelsFromBottom.cbegin());
+		}
+
+		VolumeType SortedDoseSampleStore::computeVx(DoseTypeGy xDoseAbsolute) const
+		{
+			//first dose value >= xDoseAbsolute, all following voxels receive at least xDoseAbsolute
+			const auto firstIndex = static_cast<size_t>(std::lower_bound(_doseVector.cbegin(), _doseVector.cend(),
+			                        xDoseAbsolute) - _doseVector.cbegin());
+
+			if (firstIndex == size())
+			{
+				return 0;
+			}
+
+			return _voxelsFromTop[firstIndex] * _voxelVolume;
+		}
+
+		DoseTypeGy SortedDoseSampleStore::computeDx(VolumeType xVolumeAbsolute, DoseStatisticType minimum) const
+		{
+			const size_t index = findFromTop(xVolumeAbsolute / _voxelVolume);
+
+			if (index == size())
+			{
+				return minimum;
+			}
+
+			return _doseVector[index];
+		}
+
+		DoseTypeGy SortedDoseSampleStore::computeMOHx(VolumeType xVolumeAbsolute) const
+		{
+			const double noOfVoxel = xVolumeAbsolute / _voxelVolume;
+
+			if (noOfVoxel == 0 || _doseVector.empty())
+			{
+				return 0;
+			}
+
+			const size_t index = findFromTop(noOfVoxel);
+			//not enough voxels: the mean over all voxels, but with respect to noOfVoxel
+			const double sum = (index == size()) ? _dosesFromTop.front() : _dosesFromTop[index];
+
+			return static_cast<DoseTypeGy>(sum / noOfVoxel);
+		}
+
+		DoseTypeGy SortedDoseSampleStore::computeMOCx(VolumeType xVolumeAbsolute) const
+		{
+			const double noOfVoxel = xVolumeAbsolute / _voxelVolume;
+
+			if (noOfVoxel == 0 || _doseVector.empty())
+			{
+				return 0;
+			}
+
+			const size_t index = findFromBottom(noOfVoxel);
+			const double sum = (index == size()) ? _dosesFromBottom.back() : _dosesFromBottom[index];
+
+			return static_cast<DoseTypeGy>(sum / noOfVoxel);
+		}
+
+		DoseTypeGy SortedDoseSampleStore::computeMaxOHx(VolumeType xVolumeAbsolute) const
+		{
+			const size_t index = findFromTop(xVolumeAbsolute / _voxelVolume);
+
+			if (index == size() || index == 0)
+			{
+				return 0;
+			}
+
+			return _doseVector[index - 1];
+		}
+
+		DoseTypeGy SortedDoseSampleStore::computeMinOCx(VolumeType xVolumeAbsolute, DoseStatisticType minimum,
+		        DoseStatisticType maximum) const
+		{
+			const size_t index = findFromBottom(xVolumeAbsolute / _voxelVolume);
+
+			if (index == size())
+			{
+				return static_cast<DoseTypeGy>(minimum);
+			}
+			else if (index + 1 < size())
+			{
+				return _doseVector[index + 1];
+			}
+			else
+			{
+				return static_cast<DoseTypeGy>(maximum);
+			}
+		}
+	}
+}
@@ -0,0 +1,110 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+
+#ifndef __SORTED_DOSE_SAMPLE_STORE_H
+#define __SORTED_DOSE_SAMPLE_STORE_H
+
+#include <vector>
+
+#include <rttbCommon.h>
+
+#include "rttbBaseType.h"
+
+#include "RTTBAlgorithmsExports.h"
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace rttb
+{
+
+	namespace algorithms
+	{
+		/*! @class SortedDoseSampleStore
+		@brief Read only store of the dose values of a structure (sorted in ascending order) with their voxel proportions.
+		@details The voxel proportions and the dose weighted voxel proportions are summed up once from the highest and from the
+		lowest dose on. Vx, Dx, MOHx, MOCx, MaxOHx and MinOCx are answered by binary search on these sums in O(log n) for
+		any x, with the same results as summing up the voxels one by one.
+		The store needs about 6*8 byte per voxel (see getMemorySize()). All methods are const, so the store can be queried by
+		several threads at once.
+		*/
+		class RTTBAlgorithms_EXPORT SortedDoseSampleStore
+		{
+		public:
+			rttbClassMacroNoParent(SortedDoseSampleStore)
+
+		private:
+			std::vector<DoseTypeGy> _doseVector;
+			std::vector<double> _voxelProportionVector;
+			DoseVoxelVolumeType _voxelVolume;
+
+			/*! @brief _voxelsFromTop[i] is the sum of the voxel proportions of i..n-1, summed up from n-1 downwards*/
+			std::vector<double> _voxelsFromTop;
+			/*! @brief _dosesFromTop[i] is the sum of dose*proportion of i..n-1, summed up from n-1 downwards*/
+			std::vector<double> _dosesFromTop;
+			/*! @brief _voxelsFromBottom[i] is the sum of the voxel proportions of 0..i*/
+			std::vector<double> _voxelsFromBottom;
+			/*! @brief _dosesFromBottom[i] is the sum of dose*proportion of 0..i*/
+			std::vector<double> _dosesFromBottom;
+
+			/*! @brief Returns the highest index i with _voxelsFromTop[i]>=noOfVoxel or size() if there are not enough voxels.*/
+			size_t findFromTop(double noOfVoxel) const;
+
+			/*! @brief Returns the lowest index i with _voxelsFromBottom[i]>=noOfVoxel or size() if there are not enough voxels.*/
+			size_t findFromBottom(double noOfVoxel) const;
+
+		public:
+			/*! @param doseVector the dose values sorted in ascending order
+				@param voxelProportionVector the corresponding voxel proportions (>=0)
+				@param voxelVolume the volume of one voxel
+				@exception InvalidParameterException If the sizes of doseVector and voxelProportionVector differ.
+			*/
+			SortedDoseSampleStore(std::vector<DoseTypeGy> doseVector, std::vector<double> voxelProportionVector,
+			                      DoseVoxelVolumeType voxelVolume);
+
+			const std::vector<DoseTypeGy>& getDoseVector() const;
+			const std::vector<double>& getVoxelProportionVector() const;
+			DoseVoxelVolumeType getVoxelVolume() const;
+
+			/*! @brief number of stored dose values*/
+			size_t size() const;
+
+			/*! @brief Returns the size of the stored data in byte*/
+			size_t getMemorySize() const;
+
+			/*! @brief Volume irradiated with a dose >= xDoseAbsolute*/
+			VolumeType computeVx(DoseTypeGy xDoseAbsolute) const;
+			/*! @brief Minimal dose delivered to the volume xVolumeAbsolute, minimum if the volume is larger than the structure*/
+			DoseTypeGy computeDx(VolumeType xVolumeAbsolute, DoseStatisticType minimum) const;
+			/*! @brief Mean dose of the hottest volume xVolumeAbsolute*/
+			DoseTypeGy computeMOHx(VolumeType xVolumeAbsolute) const;
+			/*! @brief Mean dose of the coldest volume xVolumeAbsolute*/
+			DoseTypeGy computeMOCx(VolumeType xVolumeAbsolute) const;
+			/*! @brief Maximum dose outside of the hottest volume xVolumeAbsolute*/
+			DoseTypeGy computeMaxOHx(VolumeType xVolumeAbsolute) const;
+			/*! @brief Minimum dose outside of the coldest volume xVolumeAbsolute*/
+			DoseTypeGy computeMinOCx(VolumeType xVolumeAbsolute, DoseStatisticType minimum, DoseStatisticType maximum) const;
+		};
+	}
+}
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif
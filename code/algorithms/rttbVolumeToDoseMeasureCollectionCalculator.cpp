@@ -15,10 +15,12 @@
 
 #include "rttbVolumeToDoseMeasureCollectionCalculator.h"
 
-#include <thread>
+#include <vector>
 
 #include "rttbInvalidParameterException.h"
+#include "rttbNullPointerException.h"
 #include "rttbUtils.h"
+#include "rttbThreadPool.h"
 
 #include <boost/make_shared.hpp>
 
@@ -29,39 +31,69 @@ namespace rttb
 	{
 		VolumeToDoseMeasureCollectionCalculator::VolumeToDoseMeasureCollectionCalculator(const std::vector<double>& precomputeVolumeValues, const VolumeType volume,
 			const std::vector<DoseTypeGy>& doseVector, const std::vector<double>& voxelProportionVector, const DoseVoxelVolumeType currentVoxelVolume,
-			VolumeToDoseMeasureCollection::complexStatistics name, bool multiThreading) : _doseVector(doseVector), _currentVoxelVolume(currentVoxelVolume), _voxelProportionVector(voxelProportionVector),
+			VolumeToDoseMeasureCollection::complexStatistics name, bool multiThreading) :
+			_sampleStore(::boost::make_shared<SortedDoseSampleStore>(doseVector, voxelProportionVector, currentVoxelVolume)),
 			_volume(volume), _measureCollection(::boost::make_shared<VolumeToDoseMeasureCollection>(name)),  _multiThreading(multiThreading)
         {
             addPrecomputeVolumeValues(precomputeVolumeValues);
         }
 
+		VolumeToDoseMeasureCollectionCalculator::VolumeToDoseMeasureCollectionCalculator(const std::vector<double>& precomputeVolumeValues, const VolumeType volume,
+			SortedDoseSampleStore::ConstPointer sampleStore, VolumeToDoseMeasureCollection::complexStatistics name, bool multiThreading) :
+			_sampleStore(sampleStore), _volume(volume), _measureCollection(::boost::make_shared<VolumeToDoseMeasureCollection>(name)),
+			_multiThreading(multiThreading)
+		{
+			if (!_sampleStore)
+			{
+				throw rttb::core::NullPointerException("sampleStore must not be nullptr!");
+			}
+
+			addPrecomputeVolumeValues(precomputeVolumeValues);
+		}
+
 		void VolumeToDoseMeasureCollectionCalculator::compute()
 		{
-			std::vector<std::thread> threads;
+			std::vector<double> xAbsoluteValues;
 
 			for (double _precomputeVolumeValue : _precomputeVolumeValues)
 			{
 				double xAbsolute = _precomputeVolumeValue * _volume;
-				if (!rttb::core::isKey(_measureCollection->getAllValues(), xAbsolute)) {
-					if (_multiThreading)
-					{
-						throw rttb::core::InvalidParameterException("MultiThreading is not implemented yet.");
-					}
-					else
+				if (!rttb::core::isKey(_measureCollection->getAllValues(), xAbsolute) && !rttb::core::isKey(xAbsoluteValues, xAbsolute)) {
+					xAbsoluteValues.push_back(xAbsolute);
+				}
+			}
+
+			std::vector<DoseTypeGy> results(xAbsoluteValues.size());
+
+			if (_multiThreading)
+			{
+				//the values are computed concurrently and inserted afterwards by this thread
+				core::TaskGroup tasks;
+
+				for (size_t i = 0; i < xAbsoluteValues.size(); ++i)
+				{
+					tasks.run([this, &xAbsoluteValues, &results, i]()
 					{
-						insertIntoMeasureCollection(xAbsolute, this->computeSpecificValue(xAbsolute));
-					}
-				}				
+						results[i] = this->computeSpecificValue(xAbsoluteValues[i]);
+					});
+				}
+
+				tasks.wait();
+			}
+			else
+			{
+				for (size_t i = 0; i < xAbsoluteValues.size(); ++i)
+				{
+					results[i] = this->computeSpecificValue(xAbsoluteValues[i]);
+				}
 			}
 
-			for (auto & thread : threads)
+			for (size_t i = 0; i < xAbsoluteValues.size(); ++i)
 			{
-        if (thread.joinable())
-        {
-          thread.join();
-        }
+				insertIntoMeasureCollection(xAbsoluteValues[i], results[i]);
 			}
 		}
+
 		void VolumeToDoseMeasureCollectionCalculator::addPrecomputeVolumeValues(const std::vector<double>& values)
 		{
 			for (double value : values) {
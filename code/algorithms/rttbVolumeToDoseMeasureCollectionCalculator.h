@@ -17,6 +17,7 @@
 #define __VOLUME_TO_DOSE_MEASURE_COLLECTION_CALCULATOR_H
 
 #include "rttbVolumeToDoseMeasureCollection.h"
+#include "rttbSortedDoseSampleStore.h"
 #include <rttbCommon.h>
 #include "rttbDoseStatistics.h"
 
@@ -43,9 +44,8 @@ namespace rttb
 			typedef std::map<VolumeType, DoseTypeGy> VolumeToDoseFunctionType;
 
 		protected:
-			std::vector<DoseTypeGy> _doseVector;
-			DoseVoxelVolumeType _currentVoxelVolume;
-			std::vector<double> _voxelProportionVector;
+			/*! @brief the sorted dose values, may be shared with other calculators*/
+			SortedDoseSampleStore::ConstPointer _sampleStore;
 
 		private:
       std::vector<double> _precomputeVolumeValues;
@@ -55,6 +55,7 @@ namespace rttb
 
 		public:
 			/*!  @brief Computes not already computed values for the measureCollection. Algorithm for the specific complex Statistic has to be implemented in the corresponding subclass.
+				If multiThreading is set, the values are computed concurrently on the core::ThreadPool.
 			*/
 			void compute();
 			/*! @brief Adds additional values to the _precomputeVolumeValues vector.
@@ -68,10 +69,14 @@ namespace rttb
 				const std::vector<DoseTypeGy>& doseVector, const std::vector<double>& voxelProportionVector,
 				const DoseVoxelVolumeType currentVoxelVolume, VolumeToDoseMeasureCollection::complexStatistics name, bool multiThreading);
 
+			/*! @exception NullPointerException if sampleStore is nullptr*/
+			VolumeToDoseMeasureCollectionCalculator(const std::vector<double>& precomputeVolumeValues, const VolumeType volume,
+				SortedDoseSampleStore::ConstPointer sampleStore, VolumeToDoseMeasureCollection::complexStatistics name, bool multiThreading);
+
 			void insertIntoMeasureCollection(VolumeType xAbsolute, DoseTypeGy resultDose);
 
 			/*! @brief Computes the specific DoseTypeGy depending on the complext statistic
-			@note has to be overwritten
+			@note has to be overwritten, it is called concurrently for different values if multiThreading is set
 			*/
 			virtual DoseTypeGy computeSpecificValue(double xAbsolute) const = 0;
 		};
@@ -15,6 +15,10 @@
 
 #include "rttbVxDoseToVolumeMeasureCollectionCalculator.h"
 
+#include <boost/make_shared.hpp>
+
+#include "rttbNullPointerException.h"
+
 namespace rttb
 {
 
@@ -24,8 +28,32 @@ namespace rttb
 			const DoseTypeGy referenceDose, const core::DoseIteratorInterface::Pointer doseIterator, bool multiThreading) :
 			DoseToVolumeMeasureCollectionCalculator(precomputeDoseValues, referenceDose, doseIterator, DoseToVolumeMeasureCollection::Vx, multiThreading) {}
 
+		VxDoseToVolumeMeasureCollectionCalculator::VxDoseToVolumeMeasureCollectionCalculator(const std::vector<double>& precomputeDoseValues,
+			const DoseTypeGy referenceDose, const std::vector<DoseTypeGy>& doseVector, const std::vector<double>& voxelProportionVector,
+			const DoseVoxelVolumeType currentVoxelVolume, bool multiThreading) :
+			DoseToVolumeMeasureCollectionCalculator(precomputeDoseValues, referenceDose, nullptr, DoseToVolumeMeasureCollection::Vx, multiThreading),
+			_sampleStore(::boost::make_shared<SortedDoseSampleStore>(doseVector, voxelProportionVector, currentVoxelVolume)) {}
+
+		VxDoseToVolumeMeasureCollectionCalculator::VxDoseToVolumeMeasureCollectionCalculator(const std::vector<double>& precomputeDoseValues,
+			const DoseTypeGy referenceDose, SortedDoseSampleStore::ConstPointer sampleStore, bool multiThreading) :
+			DoseToVolumeMeasureCollectionCalculator(precomputeDoseValues, referenceDose, nullptr, DoseToVolumeMeasureCollection::Vx, multiThreading),
+			_sampleStore(sampleStore)
+		{
+			if (!_sampleStore)
+			{
+				throw core::NullPointerException("sampleStore must not be nullptr!");
+			}
+		}
+
 		VolumeType VxDoseToVolumeMeasureCollectionCalculator::computeSpecificValue(double xAbsolute) const
 		{
+			if (_sampleStore)
+			{
+				return _sampleStore->computeVx(xAbsolute);
+			}
+
+			//the dose iterator has a single position, it cannot be traversed by several threads at once
+			std::lock_guard<std::mutex> lock(_doseIteratorMutex);
 
 			rttb::FractionType count = 0;
 			_doseIterator->reset();
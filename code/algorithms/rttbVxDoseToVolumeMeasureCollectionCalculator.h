@@ -16,7 +16,11 @@
 #ifndef __DV_DOSE_TO_VOLUME_MEASURE_CALCULATOR_H
 #define __DV_DOSE_TO_VOLUME_MEASURE_CALCULATOR_H
 
+#include <mutex>
+#include <vector>
+
 #include "rttbDoseToVolumeMeasureCollectionCalculator.h"
+#include "rttbSortedDoseSampleStore.h"
 
 #include <rttbCommon.h>
 
@@ -27,15 +31,41 @@ namespace rttb
 	{
 		/*! @class VxDoseToVolumeMeasureCollectionCalculator
 		@brief Class for calculating Vx DoseToVolume measures
+		@details If the sorted dose values of the structure are given, every Vx is found by binary search
+		(see SortedDoseSampleStore::computeVx()). Otherwise the dose iterator is traversed once per
+		requested dose (one value at a time, also if multiThreading is set).
 		*/
 		class RTTBAlgorithms_EXPORT VxDoseToVolumeMeasureCollectionCalculator : public DoseToVolumeMeasureCollectionCalculator {
 
 		public:			
       rttbClassMacro(VxDoseToVolumeMeasureCollectionCalculator, DoseToVolumeMeasureCollectionCalculator)
+
+		private:
+			/*! @brief the sorted dose values (nullptr if the dose iterator is used)*/
+			SortedDoseSampleStore::ConstPointer _sampleStore;
+			/*! @brief Serializes the traversals of the dose iterator.*/
+			mutable std::mutex _doseIteratorMutex;
+
+		public:
 			VxDoseToVolumeMeasureCollectionCalculator(const std::vector<double>& precomputeDoseValues,
 				const DoseTypeGy referenceDose, const core::DoseIteratorInterface::Pointer doseIterator,
 				bool multiThreading = false);
 
+			/*! @brief Computes Vx from dose values sorted in ascending order (as used by DoseStatisticsCalculator)
+				and the corresponding voxel proportions.
+				@exception InvalidParameterException If the sizes of doseVector and voxelProportionVector differ.
+			*/
+			VxDoseToVolumeMeasureCollectionCalculator(const std::vector<double>& precomputeDoseValues,
+				const DoseTypeGy referenceDose, const std::vector<DoseTypeGy>& doseVector,
+				const std::vector<double>& voxelProportionVector, const DoseVoxelVolumeType currentVoxelVolume,
+				bool multiThreading = false);
+
+			/*! @brief Computes Vx from the sorted dose values of sampleStore, which can be shared with other calculators.
+				@exception NullPointerException if sampleStore is nullptr
+			*/
+			VxDoseToVolumeMeasureCollectionCalculator(const std::vector<double>& precomputeDoseValues,
+				const DoseTypeGy referenceDose, SortedDoseSampleStore::ConstPointer sampleStore, bool multiThreading = false);
+
 		protected:
 			VolumeType computeSpecificValue(double xAbsolute) const override;
 		};
@@ -1,17 +1,20 @@
 SET(CPP_FILES 
   rttbAccessorWithGeoInfoBase.cpp
+  rttbCompactMaskVoxelList.cpp
   rttbDoseIteratorInterface.cpp
   rttbDVH.cpp
   rttbDVHCalculator.cpp
   rttbDVHSet.cpp
   rttbGenericDoseIterator.cpp
   rttbGenericMaskedDoseIterator.cpp
+  rttbGenericMutableDoseAccessor.cpp
   rttbGeometricInfo.cpp
   rttbMaskedDoseIteratorInterface.cpp
   rttbMaskVoxel.cpp
   rttbStructure.cpp
   rttbStructureSet.cpp
   rttbStrVectorStructureSetGenerator.cpp
+  rttbThreadPool.cpp
   rttbUtils.cpp
   )
 
@@ -19,6 +22,7 @@ SET(H_FILES
   rttbAccessorInterface.h
   rttbAccessorWithGeoInfoBase.h
   rttbBaseType.h
+  rttbCompactMaskVoxelList.h
   rttbDataNotAvailableException.h
   rttbDoseAccessorInterface.h
   rttbDoseIteratorInterface.h
@@ -32,6 +36,7 @@ SET(H_FILES
   rttbExceptionMacros.h
   rttbGenericDoseIterator.h
   rttbGenericMaskedDoseIterator.h
+  rttbGenericMutableDoseAccessor.h
   rttbGeometricInfo.h
   rttbIndexConversionInterface.h
   rttbIndexOutOfBoundsException.h
@@ -49,10 +54,13 @@ SET(H_FILES
   rttbMutableMaskAccessorInterface.h
   rttbNullPointerException.h
   rttbPaddingException.h
+  rttbParallelReduce.h
+  rttbParallelSort.h
   rttbStructure.h
   rttbStructureSet.h
   rttbStructureSetGeneratorInterface.h
   rttbStrVectorStructureSetGenerator.h
+  rttbThreadPool.h
   rttbUtils.h
   rttbCommon.h
 )
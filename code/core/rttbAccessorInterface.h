@@ -16,11 +16,14 @@
 #ifndef __ACCESSOR_INTERFACE_H
 #define __ACCESSOR_INTERFACE_H
 
+#include <cstdint>
+
 #include <boost/shared_ptr.hpp>
 
 #include "rttbBaseType.h"
 #include "rttbGeometricInfo.h"
 #include "rttbIndexConversionInterface.h"
+#include "rttbIndexOutOfBoundsException.h"
 #include "rttbCommon.h"
 
 #include <RTTBCoreExports.h>
@@ -37,6 +40,9 @@ namespace rttb
 
 		/*! @class AccessorInterface
 			@brief Interface for any sort of Accessor
+			@details Besides the access to single values (getValueAt()), the interface provides bulk access to contiguous
+			ID ranges, rows, slices and sorted ID lists. Accessors with direct access to their data override
+			getValuesUnchecked() and gatherValuesUnchecked(), the default implementations call getValueAt() for every voxel.
 		*/
 		class RTTBCore_EXPORT AccessorInterface : public IndexConversionInterface
 		{
@@ -78,6 +84,76 @@ namespace rttb
 
 			virtual GenericValueType getValueAt(const VoxelGridIndex3D& aIndex) const = 0;
 
+			/*! @brief Writes the values of the voxels [aFirstID, aFirstID+aNumberOfValues) to aValues.
+				@pre aValues has room for aNumberOfValues values
+				@exception IndexOutOfBoundsException if the ID range is not inside the grid
+			*/
+			void getValues(const VoxelGridID aFirstID, const size_t aNumberOfValues, GenericValueType* aValues) const
+			{
+				if (aNumberOfValues == 0)
+				{
+					return;
+				}
+
+				if (aFirstID < 0 || static_cast<size_t>(aFirstID) + aNumberOfValues > static_cast<size_t>(getGridSize()))
+				{
+					throw IndexOutOfBoundsException("ID range is not inside the grid! ");
+				}
+
+				getValuesUnchecked(aFirstID, aNumberOfValues, aValues);
+			};
+
+			/*! @brief Writes the values of the row aRow in the slice aSlice (getNumColumns() values) to aValues.
+				@exception IndexOutOfBoundsException if the row is not inside the grid
+			*/
+			void getRowValues(const unsigned int aRow, const unsigned int aSlice, GenericValueType* aValues) const
+			{
+				const GeometricInfo& geoInfo = this->getGeometricInfo();
+
+				if (aRow >= geoInfo.getNumRows() || aSlice >= geoInfo.getNumSlices())
+				{
+					throw IndexOutOfBoundsException("Row is not inside the grid! ");
+				}
+
+				const size_t firstID = (static_cast<size_t>(aSlice) * geoInfo.getNumRows() + aRow) * geoInfo.getNumColumns();
+				getValues(static_cast<VoxelGridID>(firstID), geoInfo.getNumColumns(), aValues);
+			};
+
+			/*! @brief Writes the values of the slice aSlice (getNumColumns()*getNumRows() values) to aValues.
+				@exception IndexOutOfBoundsException if the slice is not inside the grid
+			*/
+			void getSliceValues(const unsigned int aSlice, GenericValueType* aValues) const
+			{
+				const GeometricInfo& geoInfo = this->getGeometricInfo();
+
+				if (aSlice >= geoInfo.getNumSlices())
+				{
+					throw IndexOutOfBoundsException("Slice is not inside the grid! ");
+				}
+
+				const size_t sliceSize = static_cast<size_t>(geoInfo.getNumColumns()) * geoInfo.getNumRows();
+				getValues(static_cast<VoxelGridID>(aSlice * sliceSize), sliceSize, aValues);
+			};
+
+			/*! @brief Writes the values of the voxels aSortedIDs[0, aNumberOfIDs) to aValues.
+				@pre the IDs are sorted ascending and aValues has room for aNumberOfIDs values
+				@exception IndexOutOfBoundsException if the first or the last ID is not inside the grid
+			*/
+			void gatherValues(const VoxelGridID* aSortedIDs, const size_t aNumberOfIDs, GenericValueType* aValues) const
+			{
+				if (aNumberOfIDs == 0)
+				{
+					return;
+				}
+
+				if (!validID(aSortedIDs[0]) || !validID(aSortedIDs[aNumberOfIDs - 1]))
+				{
+					throw IndexOutOfBoundsException("ID is not inside the grid! ");
+				}
+
+				gatherValuesUnchecked(aSortedIDs, aNumberOfIDs, aValues);
+			};
+
 			/*! @brief is true if dose is on a homogeneous grid
 				@remarks Inhomogeneous grids are not supported at the moment, but if they will be supported in the future
 				the interface does not need to change.
@@ -89,6 +165,39 @@ namespace rttb
 
 			virtual const IDType getUID() const = 0;
 
+			/*! @brief Direct access to the values of accessors that store them as unsigned 16 bit integers with one scaling
+				factor for all voxels (getValueAt() returns exactly raw value * aScaling, e.g. DICOM RT dose). Computations can then work on the
+				raw values, e.g. with lookup tables.
+				@param aScaling is set to the scaling factor if the raw values are available
+				@return the raw values of all voxels (indexed by VoxelGridID) or nullptr if the accessor does not store raw
+				values (default)
+			*/
+			virtual const std::uint16_t* getRawUInt16Values(GenericValueType& aScaling) const
+			{
+				return nullptr;
+			};
+
+		protected:
+			/*! @brief Implementation of getValues(), the ID range is inside the grid.*/
+			virtual void getValuesUnchecked(const VoxelGridID aFirstID, const size_t aNumberOfValues,
+			                                GenericValueType* aValues) const
+			{
+				for (size_t i = 0; i < aNumberOfValues; ++i)
+				{
+					aValues[i] = getValueAt(static_cast<VoxelGridID>(aFirstID + i));
+				}
+			};
+
+			/*! @brief Implementation of gatherValues(), all IDs are inside the grid.*/
+			virtual void gatherValuesUnchecked(const VoxelGridID* aSortedIDs, const size_t aNumberOfIDs,
+			                                   GenericValueType* aValues) const
+			{
+				for (size_t i = 0; i < aNumberOfIDs; ++i)
+				{
+					aValues[i] = getValueAt(aSortedIDs[i]);
+				}
+			};
+
 		};
 	}
 }
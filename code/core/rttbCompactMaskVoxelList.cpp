@@ -0,0 +1,129 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include "rttbCompactMaskVoxelList.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "rttbInvalidParameterException.h"
+
+namespace rttb
+{
+	namespace core
+	{
+		const std::uint32_t CompactMaskVoxelList::fullyInside = std::numeric_limits<std::uint32_t>::max();
+		const std::uint16_t CompactMaskVoxelList::quantizationSteps = std::numeric_limits<std::uint16_t>::max();
+
+		CompactMaskVoxelList::CompactMaskVoxelList() : _quantized(false), _numberOfVoxels(0)
+		{
+		}
+
+		CompactMaskVoxelList::CompactMaskVoxelList(const MaskVoxelList& aVoxelList, bool quantizeFractions) :
+			_quantized(quantizeFractions), _numberOfVoxels(aVoxelList.size())
+		{
+			auto lessID = [](const MaskVoxel& a, const MaskVoxel& b)
+			{
+				return a.getVoxelGridID() < b.getVoxelGridID();
+			};
+
+			//the voxel lists of the mask accessors are mostly sorted already, a sorted copy is only needed otherwise
+			MaskVoxelList sortedVoxelList;
+			const MaskVoxelList* voxelList = &aVoxelList;
+
+			if (!std::is_sorted(aVoxelList.begin(), aVoxelList.end(), lessID))
+			{
+				sortedVoxelList = aVoxelList;
+				std::stable_sort(sortedVoxelList.begin(), sortedVoxelList.end(), lessID);
+				voxelList = &sortedVoxelList;
+			}
+
+			size_t numberOfFractions = 0;
+			bool currentSpanFullyInside = false;
+
+			for (const auto& voxel : *voxelList)
+			{
+				const VoxelGridID id = voxel.getVoxelGridID();
+				const FractionType fraction = voxel.getRelevantVolumeFraction();
+				const bool fullyInsideVoxel = (fraction == 1);
+
+				const bool continuesSpan = !_spanStarts.empty() && currentSpanFullyInside == fullyInsideVoxel &&
+				                           static_cast<long long>(id) == static_cast<long long>(_spanStarts.back()) + _spanLengths.back() &&
+				                           _spanLengths.back() < std::numeric_limits<SpanLengthType>::max();
+
+				if (continuesSpan)
+				{
+					++_spanLengths.back();
+				}
+				else
+				{
+					if (!fullyInsideVoxel && numberOfFractions >= fullyInside)
+					{
+						throw InvalidParameterException("Too many mask voxels with partial volume fractions! ");
+					}
+
+					_spanStarts.push_back(id);
+					_spanLengths.push_back(1);
+					_spanFractionOffsets.push_back(fullyInsideVoxel ? fullyInside : static_cast<std::uint32_t>(numberOfFractions));
+					currentSpanFullyInside = fullyInsideVoxel;
+				}
+
+				if (!fullyInsideVoxel)
+				{
+					if (_quantized)
+					{
+						_quantizedFractions.push_back(static_cast<std::uint16_t>(std::lround(fraction * quantizationSteps)));
+					}
+					else
+					{
+						_fractions.push_back(fraction);
+					}
+
+					++numberOfFractions;
+				}
+			}
+
+			_spanStarts.shrink_to_fit();
+			_spanLengths.shrink_to_fit();
+			_spanFractionOffsets.shrink_to_fit();
+			_fractions.shrink_to_fit();
+			_quantizedFractions.shrink_to_fit();
+		}
+
+		CompactMaskVoxelList::MaskVoxelList CompactMaskVoxelList::toMaskVoxelList() const
+		{
+			MaskVoxelList voxelList;
+			voxelList.reserve(_numberOfVoxels);
+
+			for (SpanIndexType span = 0; span < getNumberOfSpans(); ++span)
+			{
+				for (SpanLengthType offset = 0; offset < _spanLengths[span]; ++offset)
+				{
+					voxelList.emplace_back(_spanStarts[span] + static_cast<VoxelGridID>(offset), getFraction(span, offset));
+				}
+			}
+
+			return voxelList;
+		}
+
+		size_t CompactMaskVoxelList::getMemorySize() const
+		{
+			return _spanStarts.size() * sizeof(VoxelGridID) + _spanLengths.size() * sizeof(SpanLengthType) +
+			       _spanFractionOffsets.size() * sizeof(std::uint32_t) + _fractions.size() * sizeof(FractionType) +
+			       _quantizedFractions.size() * sizeof(std::uint16_t);
+		}
+	}
+}
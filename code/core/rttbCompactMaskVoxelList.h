@@ -0,0 +1,149 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __COMPACT_MASK_VOXEL_LIST_H
+#define __COMPACT_MASK_VOXEL_LIST_H
+
+#include <cstdint>
+#include <vector>
+
+#include "rttbCommon.h"
+#include "rttbBaseType.h"
+#include "rttbMaskVoxel.h"
+
+#include "RTTBCoreExports.h"
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace rttb
+{
+	namespace core
+	{
+		/*! @class CompactMaskVoxelList
+			@brief Memory efficient, read only alternative to a vector of MaskVoxel, sorted by ascending VoxelGridID.
+			@details The voxels are stored as spans of consecutive voxel grid IDs (structure of arrays: start IDs, lengths and
+			offsets into the fraction array). Voxels completely inside the mask (relevant volume fraction 1) are stored as spans only,
+			the fractions of the other voxels are stored in one contiguous array, optionally quantized to 16 bit.
+			Iterating over the spans accesses the dose grid in ascending order.
+		*/
+		class RTTBCore_EXPORT CompactMaskVoxelList
+		{
+		public:
+			rttbClassMacroNoParent(CompactMaskVoxelList);
+			using MaskVoxelList = std::vector<MaskVoxel>;
+			using SpanIndexType = size_t;
+			using SpanLengthType = std::uint32_t;
+
+			/*! fraction offset of the spans that are completely inside of the mask*/
+			static const std::uint32_t fullyInside;
+			/*! resolution of the quantized fractions*/
+			static const std::uint16_t quantizationSteps;
+
+		private:
+			std::vector<VoxelGridID> _spanStarts;
+			std::vector<SpanLengthType> _spanLengths;
+			std::vector<std::uint32_t> _spanFractionOffsets;
+
+			std::vector<FractionType> _fractions;
+			std::vector<std::uint16_t> _quantizedFractions;
+			bool _quantized;
+
+			size_t _numberOfVoxels;
+
+		public:
+			CompactMaskVoxelList();
+
+			/*! @brief Converts a mask voxel list. The voxels are sorted by their ID (stable, so duplicates keep their order).
+				@param quantizeFractions If true, the fractions (always within [0,1]) are stored with 16 bit, the absolute error is at
+				most 1/(2*65535).
+			*/
+			explicit CompactMaskVoxelList(const MaskVoxelList& aVoxelList, bool quantizeFractions = false);
+
+			virtual ~CompactMaskVoxelList() = default;
+
+			/*! @brief number of voxels*/
+			inline size_t size() const
+			{
+				return _numberOfVoxels;
+			};
+
+			inline bool empty() const
+			{
+				return _numberOfVoxels == 0;
+			};
+
+			inline SpanIndexType getNumberOfSpans() const
+			{
+				return _spanStarts.size();
+			};
+
+			/*! @brief voxel grid ID of the first voxel of the span, the IDs of the span are getSpanStart()+[0, getSpanLength())*/
+			inline VoxelGridID getSpanStart(SpanIndexType aSpan) const
+			{
+				return _spanStarts[aSpan];
+			};
+
+			inline SpanLengthType getSpanLength(SpanIndexType aSpan) const
+			{
+				return _spanLengths[aSpan];
+			};
+
+			/*! @brief true if all voxels of the span have the relevant volume fraction 1*/
+			inline bool isSpanFullyInside(SpanIndexType aSpan) const
+			{
+				return _spanFractionOffsets[aSpan] == fullyInside;
+			};
+
+			/*! @brief relevant volume fraction of the voxel aOffset of the span aSpan*/
+			inline FractionType getFraction(SpanIndexType aSpan, SpanLengthType aOffset) const
+			{
+				const std::uint32_t fractionOffset = _spanFractionOffsets[aSpan];
+
+				if (fractionOffset == fullyInside)
+				{
+					return 1;
+				}
+				else if (_quantized)
+				{
+					return static_cast<FractionType>(_quantizedFractions[fractionOffset + aOffset]) / quantizationSteps;
+				}
+				else
+				{
+					return _fractions[fractionOffset + aOffset];
+				}
+			};
+
+			bool areFractionsQuantized() const
+			{
+				return _quantized;
+			};
+
+			/*! @brief Returns the voxels as mask voxel list (sorted by ID)*/
+			MaskVoxelList toMaskVoxelList() const;
+
+			/*! @brief Returns the size of the stored data in byte*/
+			size_t getMemorySize() const;
+		};
+	}
+}
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif
@@ -13,9 +13,17 @@
 //
 //------------------------------------------------------------------------
 
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
 #include <boost/make_shared.hpp>
 
 #include "rttbDVHCalculator.h"
+#include "rttbGenericMaskedDoseIterator.h"
+#include "rttbParallelReduce.h"
 #include "rttbNullPointerException.h"
 #include "rttbInvalidParameterException.h"
 
@@ -23,6 +31,56 @@ namespace rttb
 {
 	namespace core
 	{
+		namespace
+		{
+			/*! @brief Calls aVisitor(DoseTypeGy doseValue, FractionType relevantVolumeFraction) for all voxels of the (reset) iterator.
+				Masked iterators stream the sorted mask spans directly (see GenericMaskedDoseIterator::visitVoxels()).
+			*/
+			template <typename Visitor>
+			void visitDose(DoseIteratorInterface& anIterator, Visitor aVisitor)
+			{
+				auto maskedDoseIterator = dynamic_cast<GenericMaskedDoseIterator*>(&anIterator);
+
+				if (maskedDoseIterator)
+				{
+					maskedDoseIterator->visitVoxels([&aVisitor](VoxelGridID, DoseTypeGy currentVal, FractionType voxelProportion)
+					{
+						aVisitor(currentVal, voxelProportion);
+					});
+				}
+				else
+				{
+					for (anIterator.reset(); anIterator.isPositionValid(); anIterator.next())
+					{
+						aVisitor(anIterator.getCurrentDoseValue(), anIterator.getCurrentRelevantVolumeFraction());
+					}
+				}
+			}
+
+			/*! @brief Calls aVisitor(std::uint16_t rawValue, FractionType relevantVolumeFraction) for all voxels of the (reset) iterator
+				without reading the dose values, the raw values are taken from aRawDoseValues (see AccessorInterface::getRawUInt16Values()).
+			*/
+			template <typename Visitor>
+			void visitRawDose(DoseIteratorInterface& anIterator, const std::uint16_t* aRawDoseValues, Visitor aVisitor)
+			{
+				auto maskedDoseIterator = dynamic_cast<GenericMaskedDoseIterator*>(&anIterator);
+
+				if (maskedDoseIterator)
+				{
+					maskedDoseIterator->visitMaskVoxels([&aVisitor, aRawDoseValues](VoxelGridID id, FractionType voxelProportion)
+					{
+						aVisitor(aRawDoseValues[id], voxelProportion);
+					});
+				}
+				else
+				{
+					for (anIterator.reset(); anIterator.isPositionValid(); anIterator.next())
+					{
+						aVisitor(aRawDoseValues[anIterator.getCurrentVoxelGridID()], anIterator.getCurrentRelevantVolumeFraction());
+					}
+				}
+			}
+		}
 
 		DVHCalculator::DVHCalculator(DoseIteratorPointer aDoseIterator, const IDType& aStructureID,
 		                             const IDType& aDoseID,
@@ -47,20 +105,43 @@ namespace rttb
 
 			if (_deltaD == 0)
 			{
-				aDoseIterator->reset();
+				GenericValueType doseGridScaling = 0;
+				const std::uint16_t* rawDoseValues = aDoseIterator->getDoseAccessor()->getRawUInt16Values(doseGridScaling);
 				DoseTypeGy max = 0;
 
-				while (aDoseIterator->isPositionValid())
+				//maximum of the parts of the iterator, computed on the thread pool
+				if (rawDoseValues && doseGridScaling >= 0)
 				{
-					DoseTypeGy currentVal = 0;
-					currentVal = aDoseIterator->getCurrentDoseValue();
-
-					if (currentVal > max)
+					//the scaling is monotonic, so the maximal raw value gives the maximal dose
+					const std::uint16_t maxRawValue = parallelReduce(*aDoseIterator, std::uint16_t(0), [rawDoseValues](
+					                                      DoseIteratorInterface& part, std::uint16_t& partMax)
 					{
-						max = currentVal;
-					}
+						visitRawDose(part, rawDoseValues, [&partMax](std::uint16_t rawValue, FractionType)
+						{
+							partMax = std::max(partMax, rawValue);
+						});
+					}, [](std::uint16_t& maxRaw, std::uint16_t partMax)
+					{
+						maxRaw = std::max(maxRaw, partMax);
+					});
 
-					aDoseIterator->next();
+					max = maxRawValue * doseGridScaling;
+				}
+				else
+				{
+					max = parallelReduce(*aDoseIterator, DoseTypeGy(0), [](DoseIteratorInterface& part, DoseTypeGy& partMax)
+					{
+						visitDose(part, [&partMax](DoseTypeGy currentVal, FractionType)
+						{
+							if (currentVal > partMax)
+							{
+								partMax = currentVal;
+							}
+						});
+					}, [](DoseTypeGy& max, DoseTypeGy partMax)
+					{
+						max = std::max(max, partMax);
+					});
 				}
 
 				_deltaD = (max * 1.5 / _numberOfBins);
@@ -78,31 +159,70 @@ namespace rttb
 		DVH::Pointer DVHCalculator::generateDVH()
 		{
 
-			std::deque<DoseCalcType> dataDifferential(_numberOfBins, 0);
-
-			// calculate DVH
-			_doseIteratorPtr->reset();
+			using Histogram = std::vector<DoseCalcType>;
 
-			while (_doseIteratorPtr->isPositionValid())
+			auto addToBin = [this](Histogram& partHistogram, int dose_bin, FractionType voxelProportion)
 			{
-				DoseTypeGy currentVal = 0;
-				FractionType voxelProportion = _doseIteratorPtr->getCurrentRelevantVolumeFraction();
-				currentVal = _doseIteratorPtr->getCurrentDoseValue();
-
-				auto dose_bin = static_cast<int>(currentVal / _deltaD);
-
 				if (dose_bin < _numberOfBins)
 				{
-					dataDifferential[dose_bin] += voxelProportion;
+					partHistogram[dose_bin] += voxelProportion;
 				}
 				else
 				{
 					throw InvalidParameterException("_numberOfBins is too small: dose bin out of bounds! ");
 				}
+			};
+
+			//doses stored as raw integers (e.g. DICOM) are binned with a lookup table instead of scaling and dividing every voxel
+			GenericValueType doseGridScaling = 0;
+			const std::uint16_t* rawDoseValues = _doseIteratorPtr->getDoseAccessor()->getRawUInt16Values(doseGridScaling);
+			std::vector<int> binLookupTable;
 
-				_doseIteratorPtr->next();
+			if (rawDoseValues)
+			{
+				binLookupTable.resize(static_cast<size_t>(std::numeric_limits<std::uint16_t>::max()) + 1);
+
+				for (size_t rawValue = 0; rawValue < binLookupTable.size(); ++rawValue)
+				{
+					//the same computation as for the scaled dose values below, so the bins are identical
+					const DoseTypeGy currentVal = rawValue * doseGridScaling;
+					const DoseTypeGy bin = currentVal / _deltaD;
+					//bins beyond the histogram are only reported if a voxel has this value
+					binLookupTable[rawValue] = (bin < _numberOfBins) ? static_cast<int>(bin) : _numberOfBins;
+				}
 			}
 
+			// calculate DVH: every part of the iterator is binned into an own histogram on the thread pool
+			const Histogram histogram = parallelReduce(*_doseIteratorPtr, Histogram(_numberOfBins, 0),
+			                            [this, &addToBin, rawDoseValues, &binLookupTable](DoseIteratorInterface& part,
+			                                    Histogram& partHistogram)
+			{
+				if (rawDoseValues)
+				{
+					visitRawDose(part, rawDoseValues, [&addToBin, &binLookupTable, &partHistogram](std::uint16_t rawValue,
+					             FractionType voxelProportion)
+					{
+						addToBin(partHistogram, binLookupTable[rawValue], voxelProportion);
+					});
+				}
+				else
+				{
+					visitDose(part, [this, &addToBin, &partHistogram](DoseTypeGy currentVal, FractionType voxelProportion)
+					{
+						addToBin(partHistogram, static_cast<int>(currentVal / _deltaD), voxelProportion);
+					});
+				}
+			}, [](Histogram& histogram, const Histogram& partHistogram)
+			{
+				std::transform(histogram.begin(), histogram.end(), partHistogram.begin(), histogram.begin(),
+				               std::plus<DoseCalcType>());
+			});
+
+			const std::deque<DoseCalcType> dataDifferential(histogram.begin(), histogram.end());
+
+			//the voxel volume is set by reset()
+			_doseIteratorPtr->reset();
+
 			if (boost::dynamic_pointer_cast<MaskedDoseIteratorPointer>(_doseIteratorPtr))
 			{
 				_dvh = boost::make_shared<DVH>(dataDifferential, _deltaD, _doseIteratorPtr->getCurrentVoxelVolume(),
@@ -35,6 +35,9 @@ namespace rttb
 
 		/*! @class DVHCalculator
 			@brief Calculates a DVH for a given DoseIterator.
+			@details If the iterator can be split (see DoseIteratorInterface::split()), the parts are binned into own histograms
+			on the thread pool of the library (see ThreadPool) and merged afterwards. The maximum dose needed for aDeltaD==0 is
+			determined the same way.
 		*/
         class RTTBCore_EXPORT DVHCalculator : public DVHGeneratorInterface
 		{
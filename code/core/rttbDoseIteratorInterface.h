@@ -17,6 +17,8 @@
 #define __DOSE_ITERATOR_INTERFACE_NEW_H
 
 
+#include <vector>
+
 #include "rttbBaseType.h"
 #include "rttbCommon.h"
 #include "rttbDoseAccessorInterface.h"
@@ -33,6 +35,8 @@ namespace rttb
         class GeometricInfo;
 		/*! @class DoseIteratorInterface
 		@brief This class represents the dose iterator interface.
+		@details An iterator is a single cursor and must not be shared between threads. Iterators that support split() can be
+		divided into independent iterators over parts of their voxels, which can be used concurrently (see parallelReduce()).
 		*/
 		class DoseIteratorInterface
 		{
@@ -89,6 +93,22 @@ namespace rttb
 				return _spDoseAccessor->getUID();
 			};
 
+			DoseAccessorPointer getDoseAccessor() const
+			{
+				return _spDoseAccessor;
+			};
+
+			/*! @brief Splits the iteration into at most aNumberOfParts iterators over consecutive, disjoint parts of the voxels of
+				this iterator. The parts share no state with this iterator or each other, so each of them may be used by another thread.
+				Visited one after the other, the parts visit the same voxels in the same order as this iterator.
+				The parts have to be reset() before they are used.
+				@return the parts in iteration order (at least one part) or an empty vector if the iterator cannot be split.
+			*/
+			virtual std::vector<Pointer> split(unsigned int aNumberOfParts) const
+			{
+				return std::vector<Pointer>();
+			};
+
 		}; //end class
 	}//end: namespace core
 }//end: namespace rttb
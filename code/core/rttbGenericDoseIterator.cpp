@@ -14,6 +14,11 @@
 //------------------------------------------------------------------------
 
 #include "rttbGenericDoseIterator.h"
+
+#include <algorithm>
+
+#include <boost/make_shared.hpp>
+
 #include "rttbInvalidParameterException.h"
 
 namespace rttb
@@ -26,11 +31,26 @@ namespace rttb
 		{
 			_currentDoseVoxelGridID = 0;
 			_currentVoxelVolume = 0;
+			_beginID = 0;
+			_endID = static_cast<VoxelGridID>(_spDoseAccessor->getGeometricInfo().getNumberOfVoxels());
+		}
+
+		GenericDoseIterator::GenericDoseIterator(DoseAccessorPointer aDoseAccessor, VoxelGridID aBeginID,
+		        VoxelGridID aEndID) : GenericDoseIterator(aDoseAccessor)
+		{
+			if (aBeginID < 0 || aBeginID > aEndID || aEndID > _endID)
+			{
+				throw InvalidParameterException("The voxel grid ID range is not within the dose grid!");
+			}
+
+			_currentDoseVoxelGridID = aBeginID;
+			_beginID = aBeginID;
+			_endID = aEndID;
 		}
 
 		bool GenericDoseIterator::reset()
 		{
-			_currentDoseVoxelGridID = 0;
+			_currentDoseVoxelGridID = _beginID;
 
 			if (_spDoseAccessor->isGridHomogeneous())
 			{
@@ -48,7 +68,7 @@ namespace rttb
 
 		void GenericDoseIterator::next()
 		{
-			if (_spDoseAccessor->getGeometricInfo().getNumberOfVoxels() > _currentDoseVoxelGridID)
+			if (_currentDoseVoxelGridID < _endID)
 			{
 				++_currentDoseVoxelGridID;
 			}
@@ -56,7 +76,7 @@ namespace rttb
 
 		bool GenericDoseIterator::isPositionValid() const
 		{
-			return _spDoseAccessor->getGeometricInfo().validID(_currentDoseVoxelGridID);
+			return _currentDoseVoxelGridID < _endID && _spDoseAccessor->getGeometricInfo().validID(_currentDoseVoxelGridID);
 		}
 
 		DoseVoxelVolumeType GenericDoseIterator::getCurrentVoxelVolume() const
@@ -83,5 +103,23 @@ namespace rttb
 			}
 		}
 
+		std::vector<GenericDoseIterator::DoseIteratorPointer> GenericDoseIterator::split(unsigned int aNumberOfParts) const
+		{
+			const long long numberOfIDs = static_cast<long long>(_endID) - _beginID;
+			const long long numberOfParts = std::max(1LL, std::min(static_cast<long long>(aNumberOfParts), numberOfIDs));
+
+			std::vector<DoseIteratorPointer> parts;
+			parts.reserve(static_cast<size_t>(numberOfParts));
+
+			for (long long part = 0; part < numberOfParts; ++part)
+			{
+				const auto partBegin = static_cast<VoxelGridID>(_beginID + numberOfIDs * part / numberOfParts);
+				const auto partEnd = static_cast<VoxelGridID>(_beginID + numberOfIDs * (part + 1) / numberOfParts);
+				parts.push_back(::boost::make_shared<GenericDoseIterator>(_spDoseAccessor, partBegin, partEnd));
+			}
+
+			return parts;
+		}
+
 	}//end: namespace core
 }//end: namespace rttb
\ No newline at end of file
@@ -50,6 +50,10 @@ namespace rttb
 			VoxelGridID _currentDoseVoxelGridID;
 			DoseVoxelVolumeType _currentVoxelVolume;
 
+			/*! the iterated voxel grid IDs [_beginID, _endID)*/
+			VoxelGridID _beginID;
+			VoxelGridID _endID;
+
 			GenericDoseIterator(const GenericDoseIterator&) = delete; //not implemented on purpose -> non-copyable
 			GenericDoseIterator& operator=(const
 			                               GenericDoseIterator&) = delete;//not implemented on purpose -> non-copyable
@@ -61,6 +65,11 @@ namespace rttb
 			*/
 			explicit GenericDoseIterator(DoseAccessorPointer aDoseAccessor);
 
+			/*! @brief Constructor of an iterator over the voxel grid IDs [aBeginID, aEndID) of the dose
+				@exception InvalidParameterException if the range is not within the dose grid
+			*/
+			GenericDoseIterator(DoseAccessorPointer aDoseAccessor, VoxelGridID aBeginID, VoxelGridID aEndID);
+
 			/*! @brief Set the itterator to the start of the Dose.
 				@exception InvalidParameterException if a inhomogeneous grid is defined in the dose accessors, because
 				these grids are currently not supported.
@@ -95,6 +104,9 @@ namespace rttb
 				return _currentDoseVoxelGridID;
 			};
 
+			/*! @brief Splits the voxel grid IDs of the iterator into ranges of (almost) equal size.*/
+			std::vector<DoseIteratorPointer> split(unsigned int aNumberOfParts) const override;
+
 		};
 	}
 }
@@ -21,10 +21,46 @@ namespace rttb
 	namespace core
 	{
 
+		GenericMaskedDoseIterator::GenericMaskedDoseIterator(MaskAccessorPointer aSpMask, DoseAccessorPointer aDoseAccessor,
+		        MaskVoxelListPointer aMaskVoxelVec, CompactMaskVoxelListPointer aCompactMaskVoxelList,
+		        CompactMaskVoxelList::SpanIndexType aBeginSpan, CompactMaskVoxelList::SpanLengthType aBeginSpanOffset,
+		        CompactMaskVoxelList::SpanIndexType anEndSpan, CompactMaskVoxelList::SpanLengthType anEndSpanOffset)
+			: MaskedDoseIteratorInterface(aSpMask, aDoseAccessor), _currentSpan(aBeginSpan), _currentSpanOffset(aBeginSpanOffset),
+			  _beginSpan(aBeginSpan), _beginSpanOffset(aBeginSpanOffset), _endSpan(anEndSpan), _endSpanOffset(anEndSpanOffset),
+			  _isPart(true), _maskVoxelVec(aMaskVoxelVec), _compactMaskVoxelList(aCompactMaskVoxelList)
+		{
+		}
+
+		void GenericMaskedDoseIterator::getMaskVoxelLists(MaskVoxelListPointer& aMaskVoxelVec,
+		        CompactMaskVoxelListPointer& aCompactMaskVoxelList) const
+		{
+			//the conversion to the compact list is not cached by every mask, so the lists are not taken again on every reset()
+			if (!_isPart && _compactMaskVoxelList != nullptr && _maskVoxelListsUID == _spMask->getMaskUID() &&
+			    _maskVoxelListsRevision == _spMask->getMaskRevision())
+			{
+				aMaskVoxelVec = _maskVoxelVec;
+				aCompactMaskVoxelList = _compactMaskVoxelList;
+			}
+			else
+			{
+				aMaskVoxelVec = _spMask->getRelevantVoxelVector();
+				aCompactMaskVoxelList = _spMask->getCompactRelevantVoxelList();
+			}
+		}
+
 		bool GenericMaskedDoseIterator::reset()
 		{
-			_maskVoxelVec = _spMask->getRelevantVoxelVector();
-			_currentMaskPos = _maskVoxelVec->begin();
+			if (!_isPart)
+			{
+				getMaskVoxelLists(_maskVoxelVec, _compactMaskVoxelList);
+				_maskVoxelListsUID = _spMask->getMaskUID();
+				_maskVoxelListsRevision = _spMask->getMaskRevision();
+				_endSpan = _compactMaskVoxelList->getNumberOfSpans();
+				_endSpanOffset = 0;
+			}
+
+			_currentSpan = _beginSpan;
+			_currentSpanOffset = _beginSpanOffset;
 
 			core::GeometricInfo geoInfo = _spDoseAccessor->getGeometricInfo();
 			_currentVoxelVolume = geoInfo.getSpacing()(0) * geoInfo.getSpacing()(1) * geoInfo.getSpacing()(
@@ -35,7 +71,16 @@ namespace rttb
 
 		void GenericMaskedDoseIterator::next()
 		{
-			++_currentMaskPos;
+			if (isBeforeEnd(_currentSpan, _currentSpanOffset))
+			{
+				++_currentSpanOffset;
+
+				if (_currentSpanOffset == _compactMaskVoxelList->getSpanLength(_currentSpan))
+				{
+					++_currentSpan;
+					_currentSpanOffset = 0;
+				}
+			}
 		}
 
 		DoseVoxelVolumeType GenericMaskedDoseIterator::getCurrentVoxelVolume() const
@@ -52,10 +97,10 @@ namespace rttb
 
 		FractionType GenericMaskedDoseIterator::getCurrentRelevantVolumeFraction() const
 		{
-			if (!(_currentMaskPos == _maskVoxelVec->end()))
+			if (isBeforeEnd(_currentSpan, _currentSpanOffset))
 			{
-				assert(_spMask->getGeometricInfo().validID(_currentMaskPos->getVoxelGridID()));
-				return _currentMaskPos->getRelevantVolumeFraction();
+				assert(_spMask->getGeometricInfo().validID(getCurrentVoxelGridID()));
+				return _compactMaskVoxelList->getFraction(_currentSpan, _currentSpanOffset);
 			}
 
 			return 0;
@@ -63,18 +108,19 @@ namespace rttb
 
 		bool GenericMaskedDoseIterator::isPositionValid() const
 		{
-			if (_currentMaskPos == _maskVoxelVec->end())
+			if (!isBeforeEnd(_currentSpan, _currentSpanOffset))
 			{
 				return false;
 			}
 
-			return _spDoseAccessor->getGeometricInfo().validID(_currentMaskPos->getVoxelGridID()) &&
-			       _spMask->getGeometricInfo().validID(_currentMaskPos->getVoxelGridID());
+			const VoxelGridID currentID = getCurrentVoxelGridID();
+			return _spDoseAccessor->getGeometricInfo().validID(currentID) &&
+			       _spMask->getGeometricInfo().validID(currentID);
 		}
 
 		VoxelGridID GenericMaskedDoseIterator::getCurrentVoxelGridID() const
 		{
-			return _currentMaskPos->getVoxelGridID();
+			return _compactMaskVoxelList->getSpanStart(_currentSpan) + static_cast<VoxelGridID>(_currentSpanOffset);
 		}
 
 
@@ -86,8 +132,48 @@ namespace rttb
 
 		DoseTypeGy GenericMaskedDoseIterator::getCurrentDoseValue() const
 		{
-			assert(_spDoseAccessor->getGeometricInfo().validID(_currentMaskPos->getVoxelGridID()));
-			return _spDoseAccessor->getValueAt(_currentMaskPos->getVoxelGridID());
+			assert(_spDoseAccessor->getGeometricInfo().validID(getCurrentVoxelGridID()));
+			return _spDoseAccessor->getValueAt(getCurrentVoxelGridID());
+		}
+
+		std::vector<GenericMaskedDoseIterator::DoseIteratorPointer> GenericMaskedDoseIterator::split(
+		    unsigned int aNumberOfParts) const
+		{
+			MaskVoxelListPointer maskVoxelVec;
+			CompactMaskVoxelListPointer compactMaskVoxelList;
+			getMaskVoxelLists(maskVoxelVec, compactMaskVoxelList);
+
+			const size_t numberOfVoxels = compactMaskVoxelList->size();
+			const size_t numberOfParts = std::max<size_t>(1, std::min<size_t>(aNumberOfParts, numberOfVoxels));
+
+			std::vector<DoseIteratorPointer> parts;
+			parts.reserve(numberOfParts);
+
+			CompactMaskVoxelList::SpanIndexType partBeginSpan = 0;
+			CompactMaskVoxelList::SpanLengthType partBeginSpanOffset = 0;
+			CompactMaskVoxelList::SpanIndexType span = 0;
+			//number of voxels in the spans before span
+			size_t numberOfPreviousVoxels = 0;
+
+			for (size_t part = 1; part <= numberOfParts; ++part)
+			{
+				const size_t partEndVoxel = numberOfVoxels * part / numberOfParts;
+
+				while (span < compactMaskVoxelList->getNumberOfSpans() &&
+				       numberOfPreviousVoxels + compactMaskVoxelList->getSpanLength(span) <= partEndVoxel)
+				{
+					numberOfPreviousVoxels += compactMaskVoxelList->getSpanLength(span);
+					++span;
+				}
+
+				const auto partEndSpanOffset = static_cast<CompactMaskVoxelList::SpanLengthType>(partEndVoxel - numberOfPreviousVoxels);
+				parts.push_back(DoseIteratorPointer(new GenericMaskedDoseIterator(_spMask, _spDoseAccessor, maskVoxelVec,
+				                                    compactMaskVoxelList, partBeginSpan, partBeginSpanOffset, span, partEndSpanOffset)));
+				partBeginSpan = span;
+				partBeginSpanOffset = partEndSpanOffset;
+			}
+
+			return parts;
 		}
 
 	}//end namespace core
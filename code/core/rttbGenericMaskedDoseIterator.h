@@ -16,11 +16,16 @@
 #ifndef __GENERIC_MASKED_DOSE_ITERATOR_NEW_H
 #define __GENERIC_MASKED_DOSE_ITERATOR_NEW_H
 
+#include <algorithm>
+#include <vector>
+
 #include <boost/shared_ptr.hpp>
 
 #include "rttbBaseType.h"
 #include "rttbMaskedDoseIteratorInterface.h"
 #include "rttbMaskAccessorInterface.h"
+#include "rttbCompactMaskVoxelList.h"
+#include "rttbGeometricInfo.h"
 
 #include "RTTBCoreExports.h"
 
@@ -35,6 +40,10 @@ namespace rttb
 	{
 		/*! @class GenericMaskedDoseIterator
 			@brief This is a templated class representing a generic masked dose iterator for a VoxelizationPolicy.
+			@details The iterator uses the CompactMaskVoxelList of the mask (see MaskAccessorInterface::getCompactRelevantVoxelList()),
+			so the voxels are visited in ascending VoxelGridID order. The voxel lists are taken from the mask by the first reset() and
+			only taken again if the UID or the revision of the mask changes (see MaskAccessorInterface::getMaskRevision()), split()
+			hands them to the parts.
 			@see testing/GenericMaskedDoseIteratorTest.cpp for more information.
 		*/
         class RTTBCore_EXPORT GenericMaskedDoseIterator : public MaskedDoseIteratorInterface
@@ -42,27 +51,96 @@ namespace rttb
 		public:
 			using MaskVoxelListPointer = MaskAccessorInterface::MaskVoxelListPointer;
 			using MaskVoxelList = MaskAccessorInterface::MaskVoxelList;
+			using CompactMaskVoxelListPointer = MaskAccessorInterface::CompactMaskVoxelListPointer;
 			using MaskAccessorPointer = MaskedDoseIteratorInterface::MaskAccessorPointer;
 			using DoseAccessorPointer = MaskedDoseIteratorInterface::DoseAccessorPointer;
 
 		private:
 
-			using MaskVoxelListIterator = MaskVoxelList::const_iterator;
+			/*! The current span of _compactMaskVoxelList and the current voxel in this span*/
+			CompactMaskVoxelList::SpanIndexType _currentSpan;
+			CompactMaskVoxelList::SpanLengthType _currentSpanOffset;
 
-			/*! The current index position of the vector _maskVoxelVec*/
-			MaskVoxelListIterator _currentMaskPos;
+			/*! The iterated voxels of _compactMaskVoxelList, from the begin position (span, offset) to the end position (exclusive).
+				An iterator over the whole mask takes the current mask voxels in reset(), a part (see split()) keeps its voxel lists.*/
+			CompactMaskVoxelList::SpanIndexType _beginSpan;
+			CompactMaskVoxelList::SpanLengthType _beginSpanOffset;
+			CompactMaskVoxelList::SpanIndexType _endSpan;
+			CompactMaskVoxelList::SpanLengthType _endSpanOffset;
+			bool _isPart;
 
 			/*! vector of MaskVoxel, as defined in the voxelization*/
 			MaskVoxelListPointer _maskVoxelVec;
 
+			/*! the mask voxels sorted by ID, used for the iteration*/
+			CompactMaskVoxelListPointer _compactMaskVoxelList;
+
+			/*! UID and revision of the mask the voxel lists were taken from*/
+			IDType _maskVoxelListsUID;
+			std::size_t _maskVoxelListsRevision{0};
+
 			/*! the volume in cm^3 of the current dose voxel*/
 			DoseVoxelVolumeType _currentVoxelVolume;
 
+			/*! @brief Constructor of a part of an iterator (see split())*/
+			GenericMaskedDoseIterator(MaskAccessorPointer aSpMask, DoseAccessorPointer aDoseAccessor,
+			                          MaskVoxelListPointer aMaskVoxelVec, CompactMaskVoxelListPointer aCompactMaskVoxelList,
+			                          CompactMaskVoxelList::SpanIndexType aBeginSpan, CompactMaskVoxelList::SpanLengthType aBeginSpanOffset,
+			                          CompactMaskVoxelList::SpanIndexType anEndSpan, CompactMaskVoxelList::SpanLengthType anEndSpanOffset);
+
+			/*! @brief Returns the voxel lists of the iterator if they were taken from the current mask (same UID), otherwise the
+				voxel lists of the mask.
+			*/
+			void getMaskVoxelLists(MaskVoxelListPointer& aMaskVoxelVec, CompactMaskVoxelListPointer& aCompactMaskVoxelList) const;
+
+			/*! @brief true if the position (aSpan, anOffset) is before the end position of the iterator*/
+			inline bool isBeforeEnd(CompactMaskVoxelList::SpanIndexType aSpan, CompactMaskVoxelList::SpanLengthType anOffset) const
+			{
+				return aSpan < _endSpan || (aSpan == _endSpan && anOffset < _endSpanOffset);
+			};
+
+			/*! @brief Calls aSpanVisitor(span, firstOffset, endOffset) for the offsets [firstOffset, endOffset) of every span that
+				reset() followed by next() visits while isPositionValid().
+				@post the iterator is reset
+			*/
+			template <typename SpanVisitor>
+			void visitSpans(SpanVisitor aSpanVisitor)
+			{
+				reset();
+
+				const CompactMaskVoxelList& voxelList = *_compactMaskVoxelList;
+				//the iteration ends at the first ID that is not valid in the dose or the mask grid
+				const long long numberOfValidIDs = std::min(
+				                                       static_cast<long long>(_spDoseAccessor->getGeometricInfo().getNumberOfVoxels()),
+				                                       static_cast<long long>(_spMask->getGeometricInfo().getNumberOfVoxels()));
+
+				for (CompactMaskVoxelList::SpanIndexType span = _beginSpan; isBeforeEnd(span, 0); ++span)
+				{
+					const VoxelGridID start = voxelList.getSpanStart(span);
+					const CompactMaskVoxelList::SpanLengthType firstOffset = (span == _beginSpan) ? _beginSpanOffset : 0;
+					const long long end = static_cast<long long>(start) + ((span == _endSpan) ? _endSpanOffset :
+					                      voxelList.getSpanLength(span));
+
+					if (start < 0 || start + static_cast<long long>(firstOffset) >= numberOfValidIDs)
+					{
+						return;
+					}
+
+					aSpanVisitor(span, firstOffset, static_cast<CompactMaskVoxelList::SpanLengthType>(std::min(end,
+					             numberOfValidIDs) - start));
+
+					if (end > numberOfValidIDs)
+					{
+						return;
+					}
+				}
+			}
 
 		public:
 
 			GenericMaskedDoseIterator(MaskAccessorPointer aSpMask, DoseAccessorPointer aDoseAccessor)
-				: MaskedDoseIteratorInterface(aSpMask, aDoseAccessor) {};
+				: MaskedDoseIteratorInterface(aSpMask, aDoseAccessor), _currentSpan(0), _currentSpanOffset(0), _beginSpan(0),
+				  _beginSpanOffset(0), _endSpan(0), _endSpanOffset(0), _isPart(false) {};
 
 			/*! @brief Set the position on the first index. Use also as initialization.
 			*/
@@ -85,6 +163,68 @@ namespace rttb
 				return _maskVoxelVec;
 			};
 
+			inline CompactMaskVoxelListPointer getCompactMaskVoxelList() const
+			{
+				return _compactMaskVoxelList;
+			};
+
+			/*! @brief Calls aVisitor(VoxelGridID, DoseTypeGy doseValue, FractionType relevantVolumeFraction) for every position
+				that reset() followed by next() visits while isPositionValid(), without the virtual calls per voxel.
+				The dose values of each span are read in bulk (see AccessorInterface::getValues()).
+				@post the iterator is reset
+			*/
+			template <typename Visitor>
+			void visitVoxels(Visitor aVisitor)
+			{
+				//long spans are read in chunks
+				const CompactMaskVoxelList::SpanLengthType maxChunkLength = 4096;
+				std::vector<GenericValueType> doseValues(maxChunkLength);
+
+				visitSpans([this, &aVisitor, &doseValues, maxChunkLength](CompactMaskVoxelList::SpanIndexType span,
+				           CompactMaskVoxelList::SpanLengthType firstOffset, CompactMaskVoxelList::SpanLengthType endOffset)
+				{
+					const CompactMaskVoxelList& voxelList = *_compactMaskVoxelList;
+					const VoxelGridID start = voxelList.getSpanStart(span);
+
+					for (CompactMaskVoxelList::SpanLengthType chunkStart = firstOffset; chunkStart < endOffset;
+					     chunkStart += maxChunkLength)
+					{
+						const CompactMaskVoxelList::SpanLengthType chunkEnd = std::min(endOffset, chunkStart + maxChunkLength);
+						_spDoseAccessor->getValues(start + static_cast<VoxelGridID>(chunkStart), chunkEnd - chunkStart, doseValues.data());
+
+						for (CompactMaskVoxelList::SpanLengthType offset = chunkStart; offset < chunkEnd; ++offset)
+						{
+							aVisitor(start + static_cast<VoxelGridID>(offset), doseValues[offset - chunkStart],
+							         voxelList.getFraction(span, offset));
+						}
+					}
+				});
+			}
+
+			/*! @brief Like visitVoxels(), but without reading the dose: calls aVisitor(VoxelGridID, FractionType relevantVolumeFraction).
+				@post the iterator is reset
+			*/
+			template <typename Visitor>
+			void visitMaskVoxels(Visitor aVisitor)
+			{
+				visitSpans([this, &aVisitor](CompactMaskVoxelList::SpanIndexType span, CompactMaskVoxelList::SpanLengthType firstOffset,
+				                             CompactMaskVoxelList::SpanLengthType endOffset)
+				{
+					const CompactMaskVoxelList& voxelList = *_compactMaskVoxelList;
+					const VoxelGridID start = voxelList.getSpanStart(span);
+
+					for (CompactMaskVoxelList::SpanLengthType offset = firstOffset; offset < endOffset; ++offset)
+					{
+						aVisitor(start + static_cast<VoxelGridID>(offset), voxelList.getFraction(span, offset));
+					}
+				});
+			}
+
+			/*! @brief Splits the mask voxels of the iterator into parts with (almost) the same number of voxels.
+				The parts use the mask voxels of the mask accessor at the time of the call.
+			*/
+			std::vector<DoseIteratorPointer> split(unsigned int aNumberOfParts) const override;
+
 			/*! Check first if the position inside the maskedVoxelVector is valid. If so, check if the gridID at the
 				current position in the MaskedVoxelVector is valid in the dose and mask grid.
 			*/
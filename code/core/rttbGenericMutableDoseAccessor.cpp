@@ -0,0 +1,97 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include "rttbGenericMutableDoseAccessor.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include <boost/uuid/uuid.hpp>
+#include <boost/uuid/uuid_generators.hpp>
+#include <boost/uuid/uuid_io.hpp>
+
+namespace rttb
+{
+	namespace core
+	{
+		GenericMutableDoseAccessor::GenericMutableDoseAccessor(const core::GeometricInfo& aGeometricInfo,
+		        const IDType& aUID) : _geoInfo(aGeometricInfo), _doseData(aGeometricInfo.getNumberOfVoxels(), 0),
+			_doseUID(aUID)
+		{
+			if (_doseUID.empty())
+			{
+				boost::uuids::random_generator generator;
+				std::stringstream ss;
+				ss << generator();
+				_doseUID = "GenericMutableDose_" + ss.str();
+			}
+		}
+
+		GenericValueType GenericMutableDoseAccessor::getValueAt(const VoxelGridID aID) const
+		{
+			if (_geoInfo.validID(aID))
+			{
+				return _doseData[aID];
+			}
+
+			return -1;
+		}
+
+		GenericValueType GenericMutableDoseAccessor::getValueAt(const VoxelGridIndex3D& aIndex) const
+		{
+			VoxelGridID aVoxelGridID;
+
+			if (_geoInfo.convert(aIndex, aVoxelGridID))
+			{
+				return _doseData[aVoxelGridID];
+			}
+
+			return -1;
+		}
+
+		void GenericMutableDoseAccessor::setDoseAt(const VoxelGridID aID, DoseTypeGy value)
+		{
+			if (_geoInfo.validID(aID))
+			{
+				_doseData[aID] = value;
+			}
+		}
+
+		void GenericMutableDoseAccessor::setDoseAt(const VoxelGridIndex3D& aIndex, DoseTypeGy value)
+		{
+			VoxelGridID aVoxelGridID;
+
+			if (_geoInfo.convert(aIndex, aVoxelGridID))
+			{
+				_doseData[aVoxelGridID] = value;
+			}
+		}
+
+		void GenericMutableDoseAccessor::getValuesUnchecked(const VoxelGridID aFirstID, const size_t aNumberOfValues,
+		        GenericValueType* aValues) const
+		{
+			std::copy(_doseData.begin() + aFirstID, _doseData.begin() + aFirstID + aNumberOfValues, aValues);
+		}
+
+		void GenericMutableDoseAccessor::gatherValuesUnchecked(const VoxelGridID* aSortedIDs, const size_t aNumberOfIDs,
+		        GenericValueType* aValues) const
+		{
+			for (size_t i = 0; i < aNumberOfIDs; ++i)
+			{
+				aValues[i] = _doseData[aSortedIDs[i]];
+			}
+		}
+	}
+}
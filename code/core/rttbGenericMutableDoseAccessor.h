@@ -0,0 +1,109 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __GENERIC_MUTABLE_DOSE_ACCESSOR_H
+#define __GENERIC_MUTABLE_DOSE_ACCESSOR_H
+
+#include <vector>
+
+#include "rttbMutableDoseAccessorInterface.h"
+#include "rttbBaseType.h"
+#include "rttbGeometricInfo.h"
+
+#include "RTTBCoreExports.h"
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace rttb
+{
+	namespace core
+	{
+		/*! @class GenericMutableDoseAccessor
+			@brief Default implementation of MutableDoseAccessorInterface that stores the dose values of all voxels in one dense
+			vector (indexed by VoxelGridID). Used e.g. as output of computations that fill a whole dose grid.
+			@see MutableDoseAccessorInterface
+		*/
+		class RTTBCore_EXPORT GenericMutableDoseAccessor: public MutableDoseAccessorInterface
+		{
+		public:
+			rttbClassMacro(GenericMutableDoseAccessor, MutableDoseAccessorInterface)
+
+		private:
+			core::GeometricInfo _geoInfo;
+
+			/*! dose values of all voxels (absolute Gy dose)*/
+			std::vector<DoseTypeGy> _doseData;
+
+			IDType _doseUID;
+
+		public:
+			/*! @brief Constructor. All voxels have the dose 0.
+				@param aUID UID of the dose, a new UID is generated if it is empty
+			*/
+			explicit GenericMutableDoseAccessor(const core::GeometricInfo& aGeometricInfo, const IDType& aUID = "");
+
+			~GenericMutableDoseAccessor() override = default;
+
+			const core::GeometricInfo& getGeometricInfo() const override
+			{
+				return _geoInfo;
+			};
+
+			/*! @return the dose of the voxel or -1 if aID is not inside the grid*/
+			GenericValueType getValueAt(const VoxelGridID aID) const override;
+
+			/*! @return the dose of the voxel or -1 if aIndex is not inside the grid*/
+			GenericValueType getValueAt(const VoxelGridIndex3D& aIndex) const override;
+
+			/*! @brief Sets the dose of the voxel, IDs outside of the grid are ignored.*/
+			void setDoseAt(const VoxelGridID aID, DoseTypeGy value) override;
+
+			/*! @brief Sets the dose of the voxel, indices outside of the grid are ignored.*/
+			void setDoseAt(const VoxelGridIndex3D& aIndex, DoseTypeGy value) override;
+
+			/*! @brief Direct access to the dose values of all voxels (getNumberOfVoxels() values, indexed by VoxelGridID)*/
+			std::vector<DoseTypeGy>& getDoseVector()
+			{
+				return _doseData;
+			};
+
+			const std::vector<DoseTypeGy>& getDoseVector() const
+			{
+				return _doseData;
+			};
+
+			const IDType getUID() const override
+			{
+				return _doseUID;
+			};
+
+		protected:
+			void getValuesUnchecked(const VoxelGridID aFirstID, const size_t aNumberOfValues,
+			                        GenericValueType* aValues) const override;
+
+			void gatherValuesUnchecked(const VoxelGridID* aSortedIDs, const size_t aNumberOfIDs,
+			                           GenericValueType* aValues) const override;
+		};
+	}
+}
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif
@@ -86,6 +86,12 @@ namespace rttb
 				return _orientationMatrix;
 			};
 
+			/*! @brief The inverse of the orientation matrix (used to convert world coordinates to indices)*/
+			const OrientationMatrix& getInvertedOrientationMatrix() const
+			{
+				return _invertedOrientationMatrix;
+			};
+
 			void setImageSize(const ImageSize& aSize);
 
 			const ImageSize getImageSize() const;
@@ -16,9 +16,14 @@
 #ifndef __MASK_ACCESSOR_INTERFACE_NEW_H
 #define __MASK_ACCESSOR_INTERFACE_NEW_H
 
+#include <cstddef>
+
+#include <boost/make_shared.hpp>
+
 #include "rttbCommon.h"
 #include "rttbBaseType.h"
 #include "rttbMaskVoxel.h"
+#include "rttbCompactMaskVoxelList.h"
 #include "rttbIndexConversionInterface.h"
 
 #ifdef _MSC_VER
@@ -40,6 +45,7 @@ namespace rttb
       rttbClassMacro(MaskAccessorInterface, IndexConversionInterface);
 			using MaskVoxelList = std::vector<core::MaskVoxel>;
 			using MaskVoxelListPointer = boost::shared_ptr<MaskVoxelList>;
+			using CompactMaskVoxelListPointer = CompactMaskVoxelList::ConstPointer;
 
 		private:
 			MaskAccessorInterface(const MaskAccessorInterface&) = delete; //not implemented on purpose -> non-copyable
@@ -67,6 +73,23 @@ namespace rttb
 			*/
 			virtual MaskVoxelListPointer getRelevantVoxelVector(float lowerThreshold) = 0;
 
+			/*! @brief Get all relevant voxels as CompactMaskVoxelList (sorted by ascending VoxelGridID).
+			@details The default implementation converts getRelevantVoxelVector() on every call (GenericMaskedDoseIterator takes the
+			list only once per mask UID and revision). Accessors whose mask does not change after updateMask() should cache the
+			converted list.
+			*/
+			virtual CompactMaskVoxelListPointer getCompactRelevantVoxelList()
+			{
+				MaskVoxelListPointer voxelList = getRelevantVoxelVector();
+
+				if (voxelList == nullptr)
+				{
+					return boost::make_shared<CompactMaskVoxelList>();
+				}
+
+				return boost::make_shared<CompactMaskVoxelList>(*voxelList);
+			}
+
 			/*! @brief Get masked voxel value corresponding to a given VoxelGridID.
 				@post after a valid call voxel contains the mask information corresponding to aID.
 				If aID is not valid, voxel values are undefined.
@@ -95,6 +118,15 @@ namespace rttb
 			}
 
 			virtual IDType getMaskUID() const = 0;
+
+			/*! @brief Get the revision of the mask. It changes whenever the relevant voxels of the mask are changed (e.g. by
+			MutableMaskAccessorInterface::setMaskAt()), so users can tell if voxel lists taken earlier are still valid.
+			@details The default implementation returns 0 for masks that do not change after updateMask().
+			*/
+			virtual std::size_t getMaskRevision() const
+			{
+				return 0;
+			}
 		};
 	}
 }
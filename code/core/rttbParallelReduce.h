@@ -0,0 +1,125 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __PARALLEL_REDUCE_H
+#define __PARALLEL_REDUCE_H
+
+#include <algorithm>
+#include <vector>
+
+#include "rttbThreadPool.h"
+#include "rttbDoseIteratorInterface.h"
+
+namespace rttb
+{
+	namespace core
+	{
+		/*! @brief number of parts per thread of the pool used by parallelReduce(), more parts than threads balance the load*/
+		const unsigned int parallelReducePartsPerThread = 4;
+
+		/*! @brief Reduces the index range [aBegin, aEnd) on the thread pool.
+			@details The range is split into consecutive chunks of at least aMinChunkSize indices. aBody(chunkBegin, chunkEnd, chunkResult)
+			is called once per chunk, chunkResult is a copy of anIdentity. The chunk results are joined in ascending order by
+			aJoin(ResultType& result, const ResultType& chunkResult), so the result does not depend on the scheduling of the chunks
+			(but on the number of chunks, i.e. the concurrency of the pool).
+			@exception rethrows the first exception thrown by aBody
+		*/
+		template <typename ResultType, typename Body, typename Join>
+		ResultType parallelReduce(size_t aBegin, size_t aEnd, const ResultType& anIdentity, Body aBody, Join aJoin,
+		                          size_t aMinChunkSize = 1, ThreadPool& aPool = ThreadPool::getInstance())
+		{
+			ResultType result = anIdentity;
+
+			if (aBegin >= aEnd)
+			{
+				return result;
+			}
+
+			const size_t size = aEnd - aBegin;
+			const size_t maxNumberOfChunks = (size + std::max<size_t>(aMinChunkSize, 1) - 1) / std::max<size_t>(aMinChunkSize, 1);
+			const size_t numberOfChunks = std::min<size_t>(maxNumberOfChunks,
+			                              static_cast<size_t>(aPool.getConcurrency()) * parallelReducePartsPerThread);
+
+			if (numberOfChunks <= 1 || aPool.getConcurrency() == 1)
+			{
+				aBody(aBegin, aEnd, result);
+				return result;
+			}
+
+			std::vector<ResultType> chunkResults(numberOfChunks, anIdentity);
+			TaskGroup tasks(aPool);
+
+			for (size_t chunk = 0; chunk < numberOfChunks; ++chunk)
+			{
+				const size_t chunkBegin = aBegin + size * chunk / numberOfChunks;
+				const size_t chunkEnd = aBegin + size * (chunk + 1) / numberOfChunks;
+				ResultType& chunkResult = chunkResults[chunk];
+
+				tasks.run([&aBody, chunkBegin, chunkEnd, &chunkResult]()
+				{
+					aBody(chunkBegin, chunkEnd, chunkResult);
+				});
+			}
+
+			tasks.wait();
+
+			for (const auto& chunkResult : chunkResults)
+			{
+				aJoin(result, chunkResult);
+			}
+
+			return result;
+		}
+
+		/*! @brief Reduces the voxels of a dose iterator on the thread pool.
+			@details The iterator is split into parts (see DoseIteratorInterface::split()). aBody(DoseIteratorInterface& part,
+			ResultType& partResult) is called once per part with the reset part, partResult is a copy of anIdentity. The part results
+			are joined in iteration order by aJoin(ResultType& result, const ResultType& partResult).
+			If the iterator cannot be split or the pool has a concurrency of 1, aBody is called once with the reset anIterator.
+			@exception rethrows the first exception thrown by aBody
+		*/
+		template <typename ResultType, typename Body, typename Join>
+		ResultType parallelReduce(DoseIteratorInterface& anIterator, const ResultType& anIdentity, Body aBody, Join aJoin,
+		                          ThreadPool& aPool = ThreadPool::getInstance())
+		{
+			std::vector<DoseIteratorInterface::Pointer> parts;
+
+			if (aPool.getConcurrency() > 1)
+			{
+				parts = anIterator.split(aPool.getConcurrency() * parallelReducePartsPerThread);
+			}
+
+			if (parts.size() <= 1)
+			{
+				ResultType result = anIdentity;
+				anIterator.reset();
+				aBody(anIterator, result);
+				return result;
+			}
+
+			return parallelReduce(0, parts.size(), anIdentity, [&parts, &aBody](size_t aFirstPart, size_t anEndPart,
+			                      ResultType& partResult)
+			{
+				for (size_t part = aFirstPart; part < anEndPart; ++part)
+				{
+					parts[part]->reset();
+					aBody(*(parts[part]), partResult);
+				}
+			}, aJoin, 1, aPool);
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,104 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __PARALLEL_SORT_H
+#define __PARALLEL_SORT_H
+
+#include <algorithm>
+#include <vector>
+
+#include "rttbThreadPool.h"
+
+namespace rttb
+{
+	namespace core
+	{
+		/*! @brief Sorts the range [aFirst, aLast) stably on the thread pool.
+			@details The range is split into one chunk of at least aMinChunkSize elements per thread, the chunks are sorted with
+			std::stable_sort and neighbouring chunks are merged pairwise (std::inplace_merge) until one range remains. The result is
+			the same as of std::stable_sort(aFirst, aLast, aComp), independent of the concurrency of the pool.
+			@exception rethrows the first exception thrown by aComp
+		*/
+		template <typename RandomIt, typename Compare>
+		void parallelStableSort(RandomIt aFirst, RandomIt aLast, Compare aComp, size_t aMinChunkSize = 4096,
+		                        ThreadPool& aPool = ThreadPool::getInstance())
+		{
+			const size_t size = static_cast<size_t>(aLast - aFirst);
+			const size_t minChunkSize = std::max<size_t>(aMinChunkSize, 1);
+			const size_t numberOfChunks = std::min<size_t>((size + minChunkSize - 1) / minChunkSize, aPool.getConcurrency());
+
+			if (numberOfChunks <= 1)
+			{
+				std::stable_sort(aFirst, aLast, aComp);
+				return;
+			}
+
+			std::vector<size_t> chunkBounds;
+
+			for (size_t chunk = 0; chunk <= numberOfChunks; ++chunk)
+			{
+				chunkBounds.push_back(size * chunk / numberOfChunks);
+			}
+
+			TaskGroup sortTasks(aPool);
+
+			for (size_t chunk = 0; chunk < numberOfChunks; ++chunk)
+			{
+				const RandomIt chunkFirst = aFirst + chunkBounds[chunk];
+				const RandomIt chunkLast = aFirst + chunkBounds[chunk + 1];
+
+				sortTasks.run([chunkFirst, chunkLast, &aComp]()
+				{
+					std::stable_sort(chunkFirst, chunkLast, aComp);
+				});
+			}
+
+			sortTasks.wait();
+
+			//only neighbouring chunks are merged, which keeps the order of equal elements
+			while (chunkBounds.size() > 2)
+			{
+				std::vector<size_t> mergedBounds;
+				TaskGroup mergeTasks(aPool);
+				size_t chunk = 0;
+
+				for (; chunk + 2 < chunkBounds.size(); chunk += 2)
+				{
+					const RandomIt chunkFirst = aFirst + chunkBounds[chunk];
+					const RandomIt chunkMiddle = aFirst + chunkBounds[chunk + 1];
+					const RandomIt chunkLast = aFirst + chunkBounds[chunk + 2];
+					mergedBounds.push_back(chunkBounds[chunk]);
+
+					mergeTasks.run([chunkFirst, chunkMiddle, chunkLast, &aComp]()
+					{
+						std::inplace_merge(chunkFirst, chunkMiddle, chunkLast, aComp);
+					});
+				}
+
+				//an odd chunk at the end is merged in the next round
+				for (; chunk + 1 < chunkBounds.size(); ++chunk)
+				{
+					mergedBounds.push_back(chunkBounds[chunk]);
+				}
+
+				mergedBounds.push_back(size);
+				mergeTasks.wait();
+				chunkBounds.swap(mergedBounds);
+			}
+		}
+	}
+}
+
+#endif
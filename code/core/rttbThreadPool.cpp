@@ -0,0 +1,291 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include "rttbThreadPool.h"
+
+#include <chrono>
+
+#include "rttbInvalidParameterException.h"
+
+namespace rttb
+{
+	namespace core
+	{
+		namespace
+		{
+			/*! pool and queue index of the current thread if it is a worker thread of a pool (nullptr otherwise)*/
+			thread_local const ThreadPool* currentPool = nullptr;
+			thread_local unsigned int currentWorkerIndex = 0;
+
+			std::mutex& getConcurrencyMutex()
+			{
+				static std::mutex concurrencyMutex;
+				return concurrencyMutex;
+			}
+
+			unsigned int requestedConcurrency = 0;
+			bool isPoolCreated = false;
+
+			unsigned int resolveConcurrency(unsigned int concurrency)
+			{
+				if (concurrency == 0)
+				{
+					concurrency = std::thread::hardware_concurrency();
+				}
+
+				return concurrency == 0 ? 1 : concurrency;
+			}
+		}
+
+		ThreadPool& ThreadPool::getInstance()
+		{
+			unsigned int concurrency;
+			{
+				std::lock_guard<std::mutex> lock(getConcurrencyMutex());
+				isPoolCreated = true;
+				concurrency = requestedConcurrency;
+			}
+
+			static ThreadPool pool(concurrency);
+			return pool;
+		}
+
+		void ThreadPool::setConcurrency(unsigned int concurrency)
+		{
+			std::lock_guard<std::mutex> lock(getConcurrencyMutex());
+
+			if (isPoolCreated && resolveConcurrency(concurrency) != resolveConcurrency(requestedConcurrency))
+			{
+				throw InvalidParameterException("Error: the concurrency of the thread pool can only be set before the thread pool is used.");
+			}
+
+			requestedConcurrency = concurrency;
+		}
+
+		ThreadPool::ThreadPool(unsigned int concurrency) : _numberOfPendingTasks(0), _stop(false)
+		{
+			//the thread waiting for a task group works as well
+			const unsigned int numberOfWorkers = resolveConcurrency(concurrency) - 1;
+
+			for (unsigned int i = 0; i <= numberOfWorkers; ++i)
+			{
+				_queues.push_back(std::unique_ptr<TaskQueue>(new TaskQueue()));
+			}
+
+			for (unsigned int i = 0; i < numberOfWorkers; ++i)
+			{
+				_workers.emplace_back(&ThreadPool::workerLoop, this, i);
+			}
+		}
+
+		ThreadPool::~ThreadPool()
+		{
+			{
+				std::lock_guard<std::mutex> lock(_wakeMutex);
+				_stop = true;
+			}
+			_wakeCondition.notify_all();
+
+			for (auto& worker : _workers)
+			{
+				worker.join();
+			}
+		}
+
+		unsigned int ThreadPool::getConcurrency() const
+		{
+			return static_cast<unsigned int>(_workers.size()) + 1;
+		}
+
+		void ThreadPool::submit(Task aTask)
+		{
+			//tasks of a worker go to its own queue, all others to the shared queue
+			TaskQueue& queue = (currentPool == this) ? *_queues[currentWorkerIndex] : *_queues.back();
+
+			{
+				std::lock_guard<std::mutex> lock(_wakeMutex);
+				++_numberOfPendingTasks;
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(queue.mutex);
+				queue.tasks.push_back(std::move(aTask));
+			}
+
+			_wakeCondition.notify_one();
+		}
+
+		bool ThreadPool::popTask(Task& aTask)
+		{
+			const size_t numberOfQueues = _queues.size();
+			const size_t ownQueue = (currentPool == this) ? currentWorkerIndex : numberOfQueues - 1;
+
+			//own queue: newest task first (depth first for nested tasks)
+			{
+				TaskQueue& queue = *_queues[ownQueue];
+				std::lock_guard<std::mutex> lock(queue.mutex);
+
+				if (!queue.tasks.empty())
+				{
+					aTask = std::move(queue.tasks.back());
+					queue.tasks.pop_back();
+					return true;
+				}
+			}
+
+			//other queues (shared queue first): steal the oldest task
+			for (size_t i = 1; i < numberOfQueues; ++i)
+			{
+				TaskQueue& queue = *_queues[(ownQueue + numberOfQueues - i) % numberOfQueues];
+				std::lock_guard<std::mutex> lock(queue.mutex);
+
+				if (!queue.tasks.empty())
+				{
+					aTask = std::move(queue.tasks.front());
+					queue.tasks.pop_front();
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		bool ThreadPool::runPendingTask()
+		{
+			Task task;
+
+			if (!popTask(task))
+			{
+				return false;
+			}
+
+			--_numberOfPendingTasks;
+			task();
+			return true;
+		}
+
+		void ThreadPool::workerLoop(unsigned int workerIndex)
+		{
+			currentPool = this;
+			currentWorkerIndex = workerIndex;
+
+			while (true)
+			{
+				if (runPendingTask())
+				{
+					continue;
+				}
+
+				std::unique_lock<std::mutex> lock(_wakeMutex);
+				_wakeCondition.wait(lock, [this]()
+				{
+					return _stop || _numberOfPendingTasks > 0;
+				});
+
+				if (_stop && _numberOfPendingTasks == 0)
+				{
+					return;
+				}
+			}
+		}
+
+		TaskGroup::TaskGroup(ThreadPool& aPool) : _pool(aPool), _numberOfUnfinishedTasks(0)
+		{
+		}
+
+		TaskGroup::~TaskGroup()
+		{
+			waitForTasks();
+		}
+
+		void TaskGroup::run(ThreadPool::Task aTask)
+		{
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				++_numberOfUnfinishedTasks;
+			}
+
+			_pool.submit([this, aTask]()
+			{
+				std::exception_ptr exception;
+
+				try
+				{
+					aTask();
+				}
+				catch (...)
+				{
+					exception = std::current_exception();
+				}
+
+				//notify while holding the lock: the group may be destroyed as soon as the waiting thread gets the lock
+				std::lock_guard<std::mutex> lock(_mutex);
+
+				if (exception && !_exception)
+				{
+					_exception = exception;
+				}
+
+				--_numberOfUnfinishedTasks;
+				_finishedCondition.notify_all();
+			});
+		}
+
+		void TaskGroup::wait()
+		{
+			waitForTasks();
+
+			std::exception_ptr exception;
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				exception = _exception;
+				_exception = nullptr;
+			}
+
+			if (exception)
+			{
+				std::rethrow_exception(exception);
+			}
+		}
+
+		void TaskGroup::waitForTasks()
+		{
+			while (true)
+			{
+				{
+					std::lock_guard<std::mutex> lock(_mutex);
+
+					if (_numberOfUnfinishedTasks == 0)
+					{
+						return;
+					}
+				}
+
+				//help instead of blocking, this also runs nested tasks the tasks of the group are waiting for
+				if (_pool.runPendingTask())
+				{
+					continue;
+				}
+
+				std::unique_lock<std::mutex> lock(_mutex);
+				_finishedCondition.wait_for(lock, std::chrono::milliseconds(1), [this]()
+				{
+					return _numberOfUnfinishedTasks == 0;
+				});
+			}
+		}
+
+	}
+}
@@ -0,0 +1,143 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __THREAD_POOL_H
+#define __THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "RTTBCoreExports.h"
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace rttb
+{
+	namespace core
+	{
+		/*! @class ThreadPool
+		@brief Work-stealing thread pool shared by all parallel computations of the library.
+		@details The concurrency of the pool (number of threads working on tasks at the same time, the thread waiting in
+		TaskGroup::wait() included) is set once for the whole library with setConcurrency() before the pool is used the first time.
+		A concurrency of 1 runs all tasks in the calling thread, which gives reproducible single-threaded runs (e.g. for benchmarking).
+		Tasks are submitted with a TaskGroup. Each worker thread has its own task queue, idle workers steal tasks from the others.
+		Waiting threads execute pending tasks instead of blocking, so tasks may start and wait for nested task groups.
+		*/
+		class RTTBCore_EXPORT ThreadPool
+		{
+		public:
+			using Task = std::function<void()>;
+
+			/*! @brief Returns the pool of the library. It is created with the concurrency set by setConcurrency() on the first call.*/
+			static ThreadPool& getInstance();
+
+			/*! @brief Sets the concurrency of the pool of the library.
+			@param concurrency maximal number of threads working on tasks at the same time. 0 means the number of hardware threads/cores.
+			@exception InvalidParameterException thrown if the pool was already created with a different concurrency
+			*/
+			static void setConcurrency(unsigned int concurrency);
+
+			/*! @brief Creates an own pool. Usually the pool of the library (getInstance()) is used.
+			@param concurrency maximal number of threads working on tasks at the same time. 0 means the number of hardware threads/cores.
+			*/
+			explicit ThreadPool(unsigned int concurrency);
+
+			~ThreadPool();
+
+			ThreadPool(const ThreadPool&) = delete;
+			ThreadPool& operator=(const ThreadPool&) = delete;
+
+			/*! @brief The maximal number of threads working on tasks at the same time (worker threads + 1 waiting thread)*/
+			unsigned int getConcurrency() const;
+
+		private:
+			friend class TaskGroup;
+
+			struct TaskQueue
+			{
+				std::mutex mutex;
+				std::deque<Task> tasks;
+			};
+
+			/*! one queue per worker thread, the last one takes the tasks submitted by other threads*/
+			std::vector<std::unique_ptr<TaskQueue> > _queues;
+			std::vector<std::thread> _workers;
+
+			std::mutex _wakeMutex;
+			std::condition_variable _wakeCondition;
+			std::atomic<size_t> _numberOfPendingTasks;
+			bool _stop;
+
+			void submit(Task aTask);
+
+			/*! @brief Executes one pending task in the calling thread
+			@return false if there was no pending task
+			*/
+			bool runPendingTask();
+
+			bool popTask(Task& aTask);
+
+			void workerLoop(unsigned int workerIndex);
+		};
+
+		/*! @class TaskGroup
+		@brief Runs tasks on a ThreadPool and waits for their completion.
+		@details The first exception thrown by a task is rethrown by wait().
+		*/
+		class RTTBCore_EXPORT TaskGroup
+		{
+		public:
+			explicit TaskGroup(ThreadPool& aPool = ThreadPool::getInstance());
+
+			/*! @brief Waits for all tasks, exceptions of the tasks are ignored here (call wait() to get them).*/
+			~TaskGroup();
+
+			TaskGroup(const TaskGroup&) = delete;
+			TaskGroup& operator=(const TaskGroup&) = delete;
+
+			void run(ThreadPool::Task aTask);
+
+			/*! @brief Waits until all tasks of the group are finished. The calling thread executes pending tasks meanwhile.
+			@exception rethrows the first exception thrown by a task of the group
+			*/
+			void wait();
+
+		private:
+			ThreadPool& _pool;
+			std::mutex _mutex;
+			std::condition_variable _finishedCondition;
+			size_t _numberOfUnfinishedTasks;
+			std::exception_ptr _exception;
+
+			void waitForTasks();
+		};
+	}
+}
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif
@@ -16,6 +16,9 @@
 #include "rttbITKTransformation.h"
 #include "rttbNullPointerException.h"
 
+#include "itkMatrixOffsetTransformBase.h"
+#include "itkTranslationTransform.h"
+
 namespace rttb
 {
 	namespace interpolation
@@ -68,6 +71,77 @@ namespace rttb
 			return true;
 		}
 
+		bool ITKTransformation::transformInverseBatch(const WorldCoordinate3D* worldCoordinatesTarget,
+		        size_t aNumberOfPoints, WorldCoordinate3D* worldCoordinatesMoving) const
+		{
+			const Transform3D3DType& transformation = *_pTransformation;
+			InputPointType aTargetPoint;
+			OutputPointType aMovingPoint;
+
+			for (size_t i = 0; i < aNumberOfPoints; ++i)
+			{
+				const WorldCoordinate3D& worldCoordinateTarget = worldCoordinatesTarget[i];
+				aTargetPoint[0] = worldCoordinateTarget(0);
+				aTargetPoint[1] = worldCoordinateTarget(1);
+				aTargetPoint[2] = worldCoordinateTarget(2);
+
+				aMovingPoint = transformation.TransformPoint(aTargetPoint);
+
+				WorldCoordinate3D& worldCoordinateMoving = worldCoordinatesMoving[i];
+				worldCoordinateMoving(0) = aMovingPoint[0];
+				worldCoordinateMoving(1) = aMovingPoint[1];
+				worldCoordinateMoving(2) = aMovingPoint[2];
+			}
+
+			//TransformPoint has no return value...
+			return true;
+		}
+
+		bool ITKTransformation::getInverseAffineParameters(std::array<std::array<double, 3>, 3>& aMatrix,
+		        std::array<double, 3>& aOffset) const
+		{
+			typedef itk::MatrixOffsetTransformBase<TransformScalarType, InputDimension3D, OutputDimension3D>
+			MatrixOffsetTransformType;
+			typedef itk::TranslationTransform<TransformScalarType, InputDimension3D> TranslationTransformType;
+
+			if (const auto* matrixOffsetTransform = dynamic_cast<const MatrixOffsetTransformType*>(_pTransformation))
+			{
+				//TransformPoint computes matrix * point + offset
+				const MatrixOffsetTransformType::MatrixType& matrix = matrixOffsetTransform->GetMatrix();
+				const MatrixOffsetTransformType::OutputVectorType& offset = matrixOffsetTransform->GetOffset();
+
+				for (unsigned int i = 0; i < 3; ++i)
+				{
+					for (unsigned int j = 0; j < 3; ++j)
+					{
+						aMatrix[i][j] = matrix(i, j);
+					}
+
+					aOffset[i] = offset[i];
+				}
+
+				return true;
+			}
+			else if (const auto* translationTransform = dynamic_cast<const TranslationTransformType*>(_pTransformation))
+			{
+				const TranslationTransformType::OutputVectorType& offset = translationTransform->GetOffset();
+
+				for (unsigned int i = 0; i < 3; ++i)
+				{
+					for (unsigned int j = 0; j < 3; ++j)
+					{
+						aMatrix[i][j] = (i == j) ? 1.0 : 0.0;
+					}
+
+					aOffset[i] = offset[i];
+				}
+
+				return true;
+			}
+
+			return false;
+		}
+
 		bool ITKTransformation::transform(const WorldCoordinate3D&
 		                                  worldCoordinateMoving, WorldCoordinate3D& worldCoordinateTarget) const
 		{
@@ -13,9 +13,14 @@
 //
 //------------------------------------------------------------------------
 
+#include <exception>
+
 #include "rttbMatchPointTransformation.h"
 #include "rttbNullPointerException.h"
 
+#include "mapPreCachedRegistrationKernel.h"
+#include "itkMatrixOffsetTransformBase.h"
+
 namespace rttb
 {
 	namespace interpolation
@@ -66,6 +71,81 @@ namespace rttb
 			return ok;
 		}
 
+		bool MatchPointTransformation::transformInverseBatch(const WorldCoordinate3D* worldCoordinatesTarget,
+		        size_t aNumberOfPoints, WorldCoordinate3D* worldCoordinatesMoving) const
+		{
+			const Registration3D3DType& registration = *_pRegistration;
+			TargetPointType aTargetPoint;
+			MovingPointType aMovingPoint;
+			bool ok = true;
+
+			for (size_t i = 0; i < aNumberOfPoints; ++i)
+			{
+				const WorldCoordinate3D& worldCoordinateTarget = worldCoordinatesTarget[i];
+				aTargetPoint[0] = worldCoordinateTarget(0);
+				aTargetPoint[1] = worldCoordinateTarget(1);
+				aTargetPoint[2] = worldCoordinateTarget(2);
+
+				ok = registration.mapPointInverse(aTargetPoint, aMovingPoint) && ok;
+
+				WorldCoordinate3D& worldCoordinateMoving = worldCoordinatesMoving[i];
+				worldCoordinateMoving(0) = aMovingPoint[0];
+				worldCoordinateMoving(1) = aMovingPoint[1];
+				worldCoordinateMoving(2) = aMovingPoint[2];
+			}
+
+			return ok;
+		}
+
+		bool MatchPointTransformation::getInverseAffineParameters(std::array<std::array<double, 3>, 3>& aMatrix,
+		        std::array<double, 3>& aOffset) const
+		{
+			typedef map::core::PreCachedRegistrationKernel<TargetDimension3D, MovingDimension3D> PreCachedKernelType;
+			typedef itk::MatrixOffsetTransformBase<PreCachedKernelType::TransformType::ScalarType, TargetDimension3D,
+			        MovingDimension3D> MatrixOffsetTransformType;
+
+			const PreCachedKernelType* pInverseKernel = nullptr;
+
+			try
+			{
+				pInverseKernel = dynamic_cast<const PreCachedKernelType*>(&(_pRegistration->getInverseMapping()));
+			}
+			//no inverse kernel available, the registration can only be used via mapPointInverse()
+			catch (const std::exception& /*e*/)
+			{
+				return false;
+			}
+
+			if (pInverseKernel == nullptr)
+			{
+				return false;
+			}
+
+			const MatrixOffsetTransformType* pMatrixOffsetTransform = dynamic_cast<const MatrixOffsetTransformType*>
+			        (pInverseKernel->getTransformModel());
+
+			if (pMatrixOffsetTransform == nullptr)
+			{
+				return false;
+			}
+
+			//TransformPoint computes matrix * point + offset
+			const MatrixOffsetTransformType::MatrixType& matrix = pMatrixOffsetTransform->GetMatrix();
+			const MatrixOffsetTransformType::OutputVectorType& offset = pMatrixOffsetTransform->GetOffset();
+
+			for (unsigned int i = 0; i < 3; ++i)
+			{
+				for (unsigned int j = 0; j < 3; ++j)
+				{
+					aMatrix[i][j] = matrix(i, j);
+				}
+
+				aOffset[i] = offset[i];
+			}
+
+			return true;
+		}
+
 		bool MatchPointTransformation::transform(const WorldCoordinate3D& worldCoordinateMoving,
 		        WorldCoordinate3D& worldCoordinateTarget) const
 		{
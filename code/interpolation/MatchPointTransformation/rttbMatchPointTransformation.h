@@ -56,6 +56,18 @@ namespace rttb
 			bool transformInverse(const WorldCoordinate3D& worldCoordinateTarget,
 			                      WorldCoordinate3D& worldCoordinateMoving) const override;
 
+			/*! @brief performs a transformation targetImage --> movingImage for aNumberOfPoints points.
+				The MatchPoint points are reused for all points, so no point is converted via a temporary.
+			*/
+			bool transformInverseBatch(const WorldCoordinate3D* worldCoordinatesTarget, size_t aNumberOfPoints,
+			                           WorldCoordinate3D* worldCoordinatesMoving) const override;
+
+			/*! @brief returns the matrix and offset of the inverse kernel of the registration if it is a pre cached kernel with a
+				matrix offset transform model (e.g. rigid or affine registrations)
+			*/
+			bool getInverseAffineParameters(std::array<std::array<double, 3>, 3>& aMatrix,
+			                                std::array<double, 3>& aOffset) const override;
+
 			/*! @brief performs a transformation movingImage --> targetImage
 			*/
 			bool transform(const WorldCoordinate3D& worldCoordinateMoving,
@@ -1,9 +1,12 @@
 SET(CPP_FILES
+	rttbMappableDoseAccessorInterface.cpp
 	rttbRosuMappableDoseAccessor.cpp
 	rttbSimpleMappableDoseAccessor.cpp
 	rttbInterpolationBase.cpp
 	rttbNearestNeighborInterpolation.cpp
 	rttbLinearInterpolation.cpp
+	rttbTransformationInterface.cpp
+	rttbDisplacementFieldTransformation.cpp
    )
 
 SET(H_FILES
@@ -14,4 +17,5 @@ SET(H_FILES
 	rttbNearestNeighborInterpolation.h
 	rttbLinearInterpolation.h
 	rttbTransformationInterface.h
+	rttbDisplacementFieldTransformation.h
    )
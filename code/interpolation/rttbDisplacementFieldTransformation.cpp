@@ -0,0 +1,367 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+
+#include "rttbDisplacementFieldTransformation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+#include <boost/make_shared.hpp>
+
+#include "rttbInvalidParameterException.h"
+#include "rttbThreadPool.h"
+
+namespace rttb
+{
+	namespace interpolation
+	{
+		namespace
+		{
+			/*! signature and version at the beginning of a displacement field file*/
+			const char fileSignature[] = "RTTBDisplacementField";
+			const std::uint32_t fileVersion = 1;
+			/*! upper bound of the stored transformation identifier (protects against corrupt files)*/
+			const std::uint32_t maximumIdentifierLength = 4096;
+			/*! continuous indices closer to a voxel center are snapped to it (in voxels)*/
+			const double voxelCenterTolerance = 1e-9;
+
+			template <typename TValue>
+			void writeValues(std::ofstream& aStream, const TValue* aValues, size_t aNumberOfValues)
+			{
+				aStream.write(reinterpret_cast<const char*>(aValues), aNumberOfValues * sizeof(TValue));
+			}
+
+			template <typename TValue>
+			void readValues(std::ifstream& aStream, TValue* aValues, size_t aNumberOfValues)
+			{
+				aStream.read(reinterpret_cast<char*>(aValues), aNumberOfValues * sizeof(TValue));
+
+				if (!aStream)
+				{
+					throw core::InvalidParameterException("Displacement field file invalid: unexpected end of file!");
+				}
+			}
+		}
+
+		DisplacementFieldTransformation::DisplacementFieldTransformation(const TransformationInterface& aTransformation,
+		        const core::GeometricInfo& aFieldGeometry) : _fieldGeometry(aFieldGeometry),
+			_displacements(3 * static_cast<size_t>(std::max<GridSizeType>(aFieldGeometry.getNumberOfVoxels(), 0)))
+		{
+			initializeGeometry();
+
+			const size_t numberOfColumns = _imageSize[0];
+			const size_t numberOfRows = _imageSize[1];
+
+			core::TaskGroup tasks;
+
+			for (size_t slice = 0; slice < _imageSize[2]; ++slice)
+			{
+				tasks.run([this, &aTransformation, slice, numberOfColumns, numberOfRows]()
+				{
+					std::vector<WorldCoordinate3D> targetCoordinates(numberOfColumns);
+					std::vector<WorldCoordinate3D> movingCoordinates(numberOfColumns);
+
+					for (size_t row = 0; row < numberOfRows; ++row)
+					{
+						for (size_t column = 0; column < numberOfColumns; ++column)
+						{
+							_fieldGeometry.indexToWorldCoordinate(VoxelGridIndex3D(static_cast<GridIndexType>(column),
+							                                      static_cast<GridIndexType>(row), static_cast<GridIndexType>(slice)), targetCoordinates[column]);
+						}
+
+						const bool allTransformed = aTransformation.transformInverseBatch(targetCoordinates.data(), numberOfColumns,
+						                            movingCoordinates.data());
+						double* displacement = _displacements.data() + 3 * ((slice * numberOfRows + row) * numberOfColumns);
+
+						for (size_t column = 0; column < numberOfColumns; ++column, displacement += 3)
+						{
+							//the batch only reports if all points succeeded, so failed rows are checked point by point
+							if (allTransformed || aTransformation.transformInverse(targetCoordinates[column], movingCoordinates[column]))
+							{
+								for (unsigned int i = 0; i < 3; ++i)
+								{
+									displacement[i] = movingCoordinates[column](i) - targetCoordinates[column](i);
+								}
+							}
+							else
+							{
+								std::fill(displacement, displacement + 3, std::numeric_limits<double>::quiet_NaN());
+							}
+						}
+					}
+				});
+			}
+
+			tasks.wait();
+		}
+
+		DisplacementFieldTransformation::DisplacementFieldTransformation(const core::GeometricInfo& aFieldGeometry,
+		        DisplacementVectorType aDisplacements) : _fieldGeometry(aFieldGeometry),
+			_displacements(std::move(aDisplacements))
+		{
+			initializeGeometry();
+		}
+
+		void DisplacementFieldTransformation::initializeGeometry()
+		{
+			if (_fieldGeometry.getNumberOfVoxels() <= 0)
+			{
+				throw core::InvalidParameterException("Field geometry invalid: the geometry has no voxels!");
+			}
+
+			if (_displacements.size() != 3 * static_cast<size_t>(_fieldGeometry.getNumberOfVoxels()))
+			{
+				throw core::InvalidParameterException("Displacements invalid: 3 values per voxel of the field geometry required!");
+			}
+
+			const OrientationMatrix& invertedOrientation = _fieldGeometry.getInvertedOrientationMatrix();
+			const SpacingVectorType3D& spacing = _fieldGeometry.getSpacing();
+			const WorldCoordinate3D& imagePosition = _fieldGeometry.getImagePositionPatient();
+
+			for (unsigned int i = 0; i < 3; ++i)
+			{
+				for (unsigned int j = 0; j < 3; ++j)
+				{
+					_invertedOrientation[i][j] = invertedOrientation(i, j);
+				}
+
+				_spacing[i] = spacing(i);
+				_imagePosition[i] = imagePosition(i);
+			}
+
+			_imageSize = {{_fieldGeometry.getNumColumns(), _fieldGeometry.getNumRows(), _fieldGeometry.getNumSlices()}};
+		}
+
+		DisplacementFieldTransformation::Pointer DisplacementFieldTransformation::read(const FileNameString& aFileName)
+		{
+			std::ifstream stream(aFileName, std::ios::binary);
+
+			if (!stream)
+			{
+				throw core::InvalidParameterException("Displacement field file name invalid: could not open the file!");
+			}
+
+			char signature[sizeof(fileSignature)];
+			std::uint32_t version = 0;
+			stream.read(signature, sizeof(fileSignature));
+			stream.read(reinterpret_cast<char*>(&version), sizeof(version));
+
+			if (!stream || std::memcmp(signature, fileSignature, sizeof(fileSignature)) != 0 || version != fileVersion)
+			{
+				throw core::InvalidParameterException("Displacement field file invalid: unknown file format or version!");
+			}
+
+			std::uint32_t identifierLength = 0;
+			readValues(stream, &identifierLength, 1);
+
+			if (identifierLength > maximumIdentifierLength)
+			{
+				throw core::InvalidParameterException("Displacement field file invalid: transformation identifier too long!");
+			}
+
+			std::string transformationIdentifier(identifierLength, '\0');
+			readValues(stream, &transformationIdentifier[0], identifierLength);
+
+			std::uint32_t imageSize[3];
+			double spacing[3];
+			double imagePosition[3];
+			double orientation[9];
+			readValues(stream, imageSize, 3);
+			readValues(stream, spacing, 3);
+			readValues(stream, imagePosition, 3);
+			readValues(stream, orientation, 9);
+
+			core::GeometricInfo fieldGeometry;
+			fieldGeometry.setImageSize(ImageSize(imageSize[0], imageSize[1], imageSize[2]));
+			fieldGeometry.setSpacing(SpacingVectorType3D(spacing[0], spacing[1], spacing[2]));
+			fieldGeometry.setImagePositionPatient(WorldCoordinate3D(imagePosition[0], imagePosition[1], imagePosition[2]));
+			OrientationMatrix orientationMatrix;
+
+			for (unsigned int i = 0; i < 3; ++i)
+			{
+				for (unsigned int j = 0; j < 3; ++j)
+				{
+					orientationMatrix(i, j) = orientation[3 * i + j];
+				}
+			}
+
+			fieldGeometry.setOrientationMatrix(orientationMatrix);
+
+			if (fieldGeometry.getNumberOfVoxels() <= 0)
+			{
+				throw core::InvalidParameterException("Displacement field file invalid: the field geometry has no voxels!");
+			}
+
+			DisplacementVectorType displacements(3 * static_cast<size_t>(fieldGeometry.getNumberOfVoxels()));
+			readValues(stream, displacements.data(), displacements.size());
+
+			auto field = boost::make_shared<DisplacementFieldTransformation>(fieldGeometry, std::move(displacements));
+			field->setTransformationIdentifier(transformationIdentifier);
+			return field;
+		}
+
+		void DisplacementFieldTransformation::write(const FileNameString& aFileName) const
+		{
+			std::ofstream stream(aFileName, std::ios::binary | std::ios::trunc);
+
+			if (!stream)
+			{
+				throw core::InvalidParameterException("Displacement field file name invalid: could not open the file for writing!");
+			}
+
+			const std::uint32_t imageSize[3] = {static_cast<std::uint32_t>(_imageSize[0]), static_cast<std::uint32_t>(_imageSize[1]),
+			                                    static_cast<std::uint32_t>(_imageSize[2])
+			                                   };
+			const OrientationMatrix& orientationMatrix = _fieldGeometry.getOrientationMatrix();
+			double orientation[9];
+
+			for (unsigned int i = 0; i < 3; ++i)
+			{
+				for (unsigned int j = 0; j < 3; ++j)
+				{
+					orientation[3 * i + j] = orientationMatrix(i, j);
+				}
+			}
+
+			writeValues(stream, fileSignature, sizeof(fileSignature));
+			writeValues(stream, &fileVersion, 1);
+			const std::uint32_t identifierLength = static_cast<std::uint32_t>(_transformationIdentifier.size());
+			writeValues(stream, &identifierLength, 1);
+			writeValues(stream, _transformationIdentifier.data(), _transformationIdentifier.size());
+			writeValues(stream, imageSize, 3);
+			writeValues(stream, _spacing.data(), 3);
+			writeValues(stream, _imagePosition.data(), 3);
+			writeValues(stream, orientation, 9);
+			writeValues(stream, _displacements.data(), _displacements.size());
+			stream.close();
+
+			if (!stream)
+			{
+				throw core::InvalidParameterException("Write displacement field failed: could not write the file!");
+			}
+		}
+
+		bool DisplacementFieldTransformation::lookup(const WorldCoordinate3D& worldCoordinateTarget,
+		        WorldCoordinate3D& worldCoordinateMoving) const
+		{
+			//continuous index in the field geometry (same computation as core::GeometricInfo::worldCoordinateToContinuousIndex())
+			const double distance[3] = {worldCoordinateTarget.x() - _imagePosition[0], worldCoordinateTarget.y() - _imagePosition[1],
+			                            worldCoordinateTarget.z() - _imagePosition[2]
+			                           };
+			size_t lower[3];
+			size_t upper[3];
+			double weight[3];
+
+			for (unsigned int i = 0; i < 3; ++i)
+			{
+				const double continuousIndex = (_invertedOrientation[i][0] * distance[0] + _invertedOrientation[i][1] * distance[1] +
+				                                _invertedOrientation[i][2] * distance[2]) / _spacing[i];
+				const double lastIndex = static_cast<double>(_imageSize[i] - 1);
+
+				//the negated comparison also rejects NaN
+				if (!(continuousIndex >= -0.5 && continuousIndex <= lastIndex + 0.5))
+				{
+					worldCoordinateMoving = WorldCoordinate3D(std::numeric_limits<double>::quiet_NaN());
+					return false;
+				}
+
+				double clampedIndex = std::min(std::max(continuousIndex, 0.0), lastIndex);
+				const double nearestIndex = std::round(clampedIndex);
+
+				//voxel centers of the field geometry (up to rounding errors) get exactly the stored displacement
+				if (std::abs(clampedIndex - nearestIndex) < voxelCenterTolerance)
+				{
+					clampedIndex = nearestIndex;
+				}
+
+				lower[i] = static_cast<size_t>(clampedIndex);
+				upper[i] = std::min(lower[i] + 1, _imageSize[i] - 1);
+				weight[i] = clampedIndex - static_cast<double>(lower[i]);
+			}
+
+			const size_t sliceSize = _imageSize[0] * _imageSize[1];
+			const size_t rowOffsets[2] = {lower[1]* _imageSize[0], upper[1]* _imageSize[0]};
+			const size_t sliceOffsets[2] = {lower[2]* sliceSize, upper[2]* sliceSize};
+			double displacement[3] = {0, 0, 0};
+
+			for (unsigned int corner = 0; corner < 8; ++corner)
+			{
+				const unsigned int x = corner & 1;
+				const unsigned int y = (corner >> 1) & 1;
+				const unsigned int z = (corner >> 2) & 1;
+				const double cornerWeight = (x ? weight[0] : 1 - weight[0]) * (y ? weight[1] : 1 - weight[1]) *
+				                            (z ? weight[2] : 1 - weight[2]);
+
+				//skipped, so an undefined neighbor does not affect the points on the border of the defined region
+				if (cornerWeight == 0)
+				{
+					continue;
+				}
+
+				const double* cornerDisplacement = _displacements.data() + 3 * ((x ? upper[0] : lower[0]) + rowOffsets[y] +
+				                                   sliceOffsets[z]);
+
+				for (unsigned int i = 0; i < 3; ++i)
+				{
+					displacement[i] += cornerWeight * cornerDisplacement[i];
+				}
+			}
+
+			if (std::isnan(displacement[0]) || std::isnan(displacement[1]) || std::isnan(displacement[2]))
+			{
+				worldCoordinateMoving = WorldCoordinate3D(std::numeric_limits<double>::quiet_NaN());
+				return false;
+			}
+
+			for (unsigned int i = 0; i < 3; ++i)
+			{
+				worldCoordinateMoving(i) = worldCoordinateTarget(i) + displacement[i];
+			}
+
+			return true;
+		}
+
+		bool DisplacementFieldTransformation::transformInverse(const WorldCoordinate3D& worldCoordinateTarget,
+		        WorldCoordinate3D& worldCoordinateMoving) const
+		{
+			return lookup(worldCoordinateTarget, worldCoordinateMoving);
+		}
+
+		bool DisplacementFieldTransformation::transformInverseBatch(const WorldCoordinate3D* worldCoordinatesTarget,
+		        size_t aNumberOfPoints, WorldCoordinate3D* worldCoordinatesMoving) const
+		{
+			bool ok = true;
+
+			for (size_t i = 0; i < aNumberOfPoints; ++i)
+			{
+				ok = lookup(worldCoordinatesTarget[i], worldCoordinatesMoving[i]) && ok;
+			}
+
+			return ok;
+		}
+
+		bool DisplacementFieldTransformation::transform(const WorldCoordinate3D& /*worldCoordinateMoving*/,
+		        WorldCoordinate3D& /*worldCoordinateTarget*/) const
+		{
+			return false;
+		}
+
+	}
+}
@@ -0,0 +1,154 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+
+#ifndef __DISPLACEMENT_FIELD_TRANSFORMATION_H
+#define __DISPLACEMENT_FIELD_TRANSFORMATION_H
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "rttbBaseType.h"
+#include "rttbGeometricInfo.h"
+#include "rttbTransformationInterface.h"
+
+#include "RTTBInterpolationExports.h"
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace rttb
+{
+	namespace interpolation
+	{
+
+		/*! @class DisplacementFieldTransformation
+			@brief Transformation targetImage --> movingImage given by a dense displacement field (worldCoordinateMoving =
+			worldCoordinateTarget + displacement) that is trilinearly interpolated between the voxel centers of the field geometry.
+			@details The field is typically computed once from an expensive transformation (e.g. a deformable MatchPoint registration)
+			on the target geometry of the mapping and stored with write(). Later mappings through the same registration read() it
+			and only pay the cost of the lookup. At the voxel centers of the field geometry the lookup returns the displacement of
+			the original transformation, in between it is an approximation.
+			Voxels where the original transformation failed are stored as NaN, points whose interpolation involves such a voxel
+			cannot be transformed. Points that cannot be transformed are mapped to NaN, so the mappable dose accessors treat them
+			as outside of the moving image.
+			@ingroup interpolation
+		*/
+		class RTTBInterpolation_EXPORT DisplacementFieldTransformation : public TransformationInterface
+		{
+		public:
+			rttbClassMacro(DisplacementFieldTransformation, TransformationInterface)
+
+			using DisplacementVectorType = std::vector<double>;
+
+			/*! @brief Computes the displacement field of aTransformation at the voxel centers of aFieldGeometry (in parallel, one
+				slice per task, see core::ThreadPool).
+				@exception core::InvalidParameterException if aFieldGeometry has no voxels
+			*/
+			DisplacementFieldTransformation(const TransformationInterface& aTransformation,
+			                                const core::GeometricInfo& aFieldGeometry);
+
+			/*! @brief Constructor from a given field.
+				@param aDisplacements displacement (x, y, z in world coordinates) of every voxel of aFieldGeometry, ordered by voxel grid ID
+				@exception core::InvalidParameterException if aFieldGeometry has no voxels or aDisplacements does not contain 3 values per voxel
+			*/
+			DisplacementFieldTransformation(const core::GeometricInfo& aFieldGeometry, DisplacementVectorType aDisplacements);
+
+			~DisplacementFieldTransformation() override = default;
+
+			/*! @brief Reads a field written by write().
+				@exception core::InvalidParameterException if the file cannot be read or is no displacement field file
+			*/
+			static Pointer read(const FileNameString& aFileName);
+
+			/*! @brief Writes the transformation identifier, the field geometry and the displacements to a binary file (native byte
+				order, doubles).
+				@exception core::InvalidParameterException if the file cannot be written
+			*/
+			void write(const FileNameString& aFileName) const;
+
+			/*! @brief performs a transformation targetImage --> movingImage
+				@return false if worldCoordinateTarget is outside of the field geometry (more than half a voxel beyond the outer voxel
+				centers, up to this border the field is extended constantly) or the field is undefined there
+			*/
+			bool transformInverse(const WorldCoordinate3D& worldCoordinateTarget,
+			                      WorldCoordinate3D& worldCoordinateMoving) const override;
+
+			/*! @brief performs a transformation targetImage --> movingImage for aNumberOfPoints points without virtual calls
+			*/
+			bool transformInverseBatch(const WorldCoordinate3D* worldCoordinatesTarget, size_t aNumberOfPoints,
+			                           WorldCoordinate3D* worldCoordinatesMoving) const override;
+
+			/*! @brief The field only describes the transformation targetImage --> movingImage, the inverse is not available.
+				@return always false, worldCoordinateTarget is not changed
+			*/
+			bool transform(const WorldCoordinate3D& worldCoordinateMoving,
+			               WorldCoordinate3D& worldCoordinateTarget) const override;
+
+			const core::GeometricInfo& getFieldGeometry() const
+			{
+				return _fieldGeometry;
+			};
+
+			/*! @brief displacements of all voxels of the field geometry (3 values per voxel, ordered by voxel grid ID)*/
+			const DisplacementVectorType& getDisplacements() const
+			{
+				return _displacements;
+			};
+
+			/*! @brief Sets an identifier of the transformation the field was computed from (e.g. a checksum of the registration
+				file). It is stored by write(), so users of a cached field can check that it belongs to their transformation.
+			*/
+			void setTransformationIdentifier(const std::string& anIdentifier)
+			{
+				_transformationIdentifier = anIdentifier;
+			};
+
+			/*! @brief identifier of the transformation the field was computed from, empty if not set*/
+			const std::string& getTransformationIdentifier() const
+			{
+				return _transformationIdentifier;
+			};
+
+		private:
+			/*! @brief Caches the field geometry as plain arrays for the lookup
+				@exception core::InvalidParameterException if the field geometry has no voxels or the number of displacements does not match
+			*/
+			void initializeGeometry();
+
+			/*! @brief trilinear lookup of the displacement, see transformInverse()*/
+			bool lookup(const WorldCoordinate3D& worldCoordinateTarget, WorldCoordinate3D& worldCoordinateMoving) const;
+
+			core::GeometricInfo _fieldGeometry;
+			DisplacementVectorType _displacements;
+			std::string _transformationIdentifier;
+
+			std::array<std::array<double, 3>, 3> _invertedOrientation;
+			std::array<double, 3> _spacing;
+			std::array<double, 3> _imagePosition;
+			std::array<size_t, 3> _imageSize;
+		};
+
+	}
+}
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif
@@ -13,7 +13,7 @@
 //
 //------------------------------------------------------------------------
 
-#include <list>
+#include <algorithm>
 #include <cassert>
 
 #include "rttbInterpolationBase.h"
@@ -30,6 +30,25 @@ namespace rttb
 			if (originalData != nullptr)
 			{
 				_spOriginalData = originalData;
+
+				const core::GeometricInfo& geoInfo = _spOriginalData->getGeometricInfo();
+				const OrientationMatrix& invertedOrientation = geoInfo.getInvertedOrientationMatrix();
+				const SpacingVectorType3D& spacing = geoInfo.getSpacing();
+				const WorldCoordinate3D& imagePosition = geoInfo.getImagePositionPatient();
+
+				for (unsigned int i = 0; i < 3; ++i)
+				{
+					for (unsigned int j = 0; j < 3; ++j)
+					{
+						_invertedOrientation[i][j] = invertedOrientation(i, j);
+					}
+
+					_spacing[i] = spacing(i);
+					_imagePosition[i] = imagePosition(i);
+				}
+
+				_imageSize = {{geoInfo.getNumColumns(), geoInfo.getNumRows(), geoInfo.getNumSlices()}};
+				_rawValues = _spOriginalData->getRawUInt16Values(_rawScaling);
 			}
 			else
 			{
@@ -37,155 +56,166 @@ namespace rttb
 			}
 		};
 
-		void InterpolationBase::getNeighborhoodVoxelValues(
-		    const WorldCoordinate3D& aWorldCoordinate,
-		    unsigned int neighborhood, std::array<double, 3>& target,
-		    boost::shared_ptr<DoseTypeGy[]> values) const
+		void InterpolationBase::getValues(const WorldCoordinate3D* aWorldCoordinates, size_t aNumberOfCoordinates,
+		                                  DoseTypeGy* aValues) const
+		{
+			for (size_t i = 0; i < aNumberOfCoordinates; ++i)
+			{
+				aValues[i] = getValue(aWorldCoordinates[i]);
+			}
+		}
+
+		bool InterpolationBase::isInside(const WorldCoordinate3D& aWorldCoordinate) const
 		{
 			if (_spOriginalData == nullptr)
 			{
 				throw core::NullPointerException("originalDose is nullptr!");
 			}
 
-			//Determine target (abs(desired worldCoordinate- corner pixel world coordinate/pixel spacing) and values of corner pixels (from originalDose)
-			VoxelGridIndex3D aIndex;
+			std::array<double, 3> continuousIndex;
+			worldCoordinateToContinuousIndex(aWorldCoordinate, continuousIndex);
+			return isInsideImage(continuousIndex);
+		}
 
-			if (_spOriginalData->getGeometricInfo().worldCoordinateToIndex(aWorldCoordinate, aIndex))
+		void InterpolationBase::getInsideRangeOnLine(const std::array<double, 3>& aStart,
+		        const std::array<double, 3>& aStep, size_t aNumberOfPoints, size_t& aFirst, size_t& aEnd) const
+		{
+			if (_spOriginalData == nullptr)
 			{
-				//determine just the nearest voxel to the world coordinate
-				if (neighborhood == 0)
-				{
-					values[0] = _spOriginalData->getValueAt(aIndex);
-				}
-				//determine the 8 voxels around the world coordinate
-				else if (neighborhood == 8)
-				{
-					std::list<VoxelGridIndex3D> cornerPoints;
+				throw core::NullPointerException("originalDose is nullptr!");
+			}
 
-					WorldCoordinate3D theNextVoxel;
-					_spOriginalData->getGeometricInfo().indexToWorldCoordinate(aIndex, theNextVoxel);
-					SpacingVectorType3D pixelSpacing = (_spOriginalData->getGeometricInfo()).getSpacing();
-					VoxelGridIndex3D leftTopFrontCoordinate;
+			//each coordinate of the points is monotonic along the line, so the inside points are contiguous
+			std::array<double, 3> continuousIndex;
+			aFirst = 0;
 
-					//find the voxel with the smallest coordinate values in each dimension. This defines the standard cube
-					for (unsigned int i = 0; i < 3; i++)
-					{
+			while (aFirst < aNumberOfPoints)
+			{
+				getPointOnLine(aStart, aStep, aFirst, continuousIndex);
 
-						if (aWorldCoordinate[i] < theNextVoxel[i])
-						{
-							if (aIndex[i] > 0)
-							{
-								leftTopFrontCoordinate[i] = aIndex[i] - 1;
-								target[i] = (aWorldCoordinate[i] - (theNextVoxel[i] - pixelSpacing[i])) / pixelSpacing[i];
-							}
-							//@todo: see T22315
-							else
-							{
-								leftTopFrontCoordinate[i] = aIndex[i];
-								target[i] = (aWorldCoordinate[i] - (theNextVoxel[i] - pixelSpacing[i])) / pixelSpacing[i];
-							}
-						}
-						else
-						{
-							leftTopFrontCoordinate[i] = aIndex[i];
-							target[i] = (aWorldCoordinate[i] - theNextVoxel[i]) / pixelSpacing[i];
-						}
-					}
+				if (isInsideImage(continuousIndex))
+				{
+					break;
+				}
 
-					for (unsigned int zIncr = 0; zIncr < 2; zIncr++)
-					{
-						for (unsigned int yIncr = 0; yIncr < 2; yIncr++)
-						{
-							for (unsigned int xIncr = 0; xIncr < 2; xIncr++)
-							{
-								cornerPoints.emplace_back(leftTopFrontCoordinate[0] + xIncr,
-								                                        leftTopFrontCoordinate[1] + yIncr,
-								                                        leftTopFrontCoordinate[2] + zIncr);
-							}
-						}
-					}
+				++aFirst;
+			}
 
-					//target range has to be always [0,1]
-					for (unsigned int i = 0; i < 3; i++)
-					{
-						assert(target[i] >= 0.0 && target[i] <= 1.0);
-					}
+			aEnd = aNumberOfPoints;
 
-					unsigned int count = 0;
+			while (aEnd > aFirst)
+			{
+				getPointOnLine(aStart, aStep, aEnd - 1, continuousIndex);
 
-					//now just get the values of all (dose) voxels and store them in values
-					for (auto cornerPointsIterator = cornerPoints.begin(); cornerPointsIterator != cornerPoints.end();
-					     ++cornerPointsIterator, ++count)
-					{
-						if (_spOriginalData->getGeometricInfo().isInside(*cornerPointsIterator))
-						{
-							values[count] = _spOriginalData->getValueAt(*cornerPointsIterator);
-						}
-						else
-						{
-							//outside value! boundary treatment
-							values[count] = getNearestInsideVoxelValue(*cornerPointsIterator);
-						}
-
-						assert(values[count] != -1);
-					}
-				}
-				else
+				if (isInsideImage(continuousIndex))
 				{
-					throw core::InvalidParameterException("neighborhoods other than 0 and 8 not yet supported in Interpolation");
+					break;
 				}
+
+				--aEnd;
 			}
-			else
+		}
+
+		void InterpolationBase::getValuesOnLine(const std::array<double, 3>& aStart, const std::array<double, 3>& aStep,
+		                                        size_t aFirst, size_t aEnd, DoseTypeGy* aValues) const
+		{
+			if (_spOriginalData == nullptr)
 			{
-				throw core::MappingOutsideOfImageException("Error in conversion from world coordinates to index");
+				throw core::NullPointerException("originalDose is nullptr!");
+			}
+
+			const core::GeometricInfo& geoInfo = _spOriginalData->getGeometricInfo();
+			std::array<double, 3> continuousIndex;
+			WorldCoordinate3D worldCoordinate;
+
+			for (size_t i = aFirst; i < aEnd; ++i)
+			{
+				getPointOnLine(aStart, aStep, i, continuousIndex);
+				geoInfo.continuousIndexToWorldCoordinate(ContinuousVoxelGridIndex3D(continuousIndex[0], continuousIndex[1],
+				        continuousIndex[2]), worldCoordinate);
+				aValues[i - aFirst] = getValue(worldCoordinate);
 			}
 		}
 
-		DoseTypeGy InterpolationBase::getNearestInsideVoxelValue(const VoxelGridIndex3D& currentVoxelIndex)
-		const
+		void InterpolationBase::getNeighborhoodVoxelValues(
+		    const WorldCoordinate3D& aWorldCoordinate,
+		    unsigned int neighborhood, std::array<double, 3>& target,
+		    std::array<DoseTypeGy, 8>& values) const
 		{
-			VoxelGridIndex3D voxelChangedXYZ[] = {currentVoxelIndex, currentVoxelIndex, currentVoxelIndex, currentVoxelIndex, currentVoxelIndex, currentVoxelIndex, currentVoxelIndex};
-			unsigned int runningIndex;
+			if (_spOriginalData == nullptr)
+			{
+				throw core::NullPointerException("originalDose is nullptr!");
+			}
 
-			//x,y,z
-			for (runningIndex = 0; runningIndex < 3; ++runningIndex)
+			std::array<double, 3> continuousIndex;
+			worldCoordinateToContinuousIndex(aWorldCoordinate, continuousIndex);
+			getNeighborhoodVoxelValues(continuousIndex, neighborhood, target, values);
+		}
+
+		void InterpolationBase::getNeighborhoodVoxelValues(const std::array<double, 3>& continuousIndex,
+		        unsigned int neighborhood, std::array<double, 3>& target,
+		        std::array<DoseTypeGy, 8>& values) const
+		{
+			if (_spOriginalData == nullptr)
 			{
-				voxelChangedXYZ[runningIndex][runningIndex] -= 1;
+				throw core::NullPointerException("originalDose is nullptr!");
 			}
 
-			//xy
-			voxelChangedXYZ[runningIndex][0] -= 1;
-			voxelChangedXYZ[runningIndex][1] -= 1;
-			++runningIndex;
-			//xz
-			voxelChangedXYZ[runningIndex][0] -= 1;
-			voxelChangedXYZ[runningIndex][2] -= 1;
-			++runningIndex;
-			//yz
-			voxelChangedXYZ[runningIndex][1] -= 1;
-			voxelChangedXYZ[runningIndex][2] -= 1;
-			++runningIndex;
-			//xyz
-			voxelChangedXYZ[runningIndex][0] -= 1;
-			voxelChangedXYZ[runningIndex][1] -= 1;
-			voxelChangedXYZ[runningIndex][2] -= 1;
-			++runningIndex;
-
-			unsigned int replacementVoxelIndex = 0;
-
-			while (replacementVoxelIndex < runningIndex)
+			if (!isInsideImage(continuousIndex))
 			{
-				if (_spOriginalData->getGeometricInfo().validIndex(voxelChangedXYZ[replacementVoxelIndex]))
+				throw core::MappingOutsideOfImageException("Error in conversion from world coordinates to index");
+			}
+
+			const size_t numberOfColumns = _imageSize[0];
+			const size_t sliceSize = numberOfColumns * _imageSize[1];
+
+			//determine just the nearest voxel to the world coordinate
+			if (neighborhood == 0)
+			{
+				values[0] = getOriginalValue(static_cast<GridIndexType>(continuousIndex[2] + 0.5) * sliceSize +
+				                             static_cast<GridIndexType>(continuousIndex[1] + 0.5) * numberOfColumns +
+				                             static_cast<GridIndexType>(continuousIndex[0] + 0.5));
+			}
+			//determine the 8 voxels around the world coordinate
+			else if (neighborhood == 8)
+			{
+				//find the voxel with the smallest index in each dimension. This defines the standard cube.
+				//Corners behind the last voxel are clamped to the last voxel (virtual expansion of the image by one voxel).
+				GridIndexType lower[3];
+				GridIndexType upper[3];
+
+				for (unsigned int i = 0; i < 3; i++)
 				{
-					return _spOriginalData->getValueAt(voxelChangedXYZ[replacementVoxelIndex]);
+					const GridIndexType nearest = static_cast<GridIndexType>(continuousIndex[i] + 0.5);
+					const bool beforeNearest = continuousIndex[i] < nearest;
+					//@todo: see T22315 (coordinates before the first voxel are interpolated between the first two voxels)
+					lower[i] = (beforeNearest && nearest > 0) ? nearest - 1 : nearest;
+					upper[i] = std::min(lower[i] + 1, _imageSize[i] - 1);
+					target[i] = continuousIndex[i] - nearest + (beforeNearest ? 1.0 : 0.0);
+
+					//target range has to be always [0,1]
+					assert(target[i] >= 0.0 && target[i] <= 1.0);
 				}
 
-				++replacementVoxelIndex;
-			}
+				const size_t rowOffsets[2] = {lower[1] * numberOfColumns, upper[1] * numberOfColumns};
+				const size_t sliceOffsets[2] = {lower[2] * sliceSize, upper[2] * sliceSize};
 
-			return -1;
+				//now just get the values of all (dose) voxels in the order x, y, z and store them in values
+				for (unsigned int zIncr = 0; zIncr < 2; zIncr++)
+				{
+					for (unsigned int yIncr = 0; yIncr < 2; yIncr++)
+					{
+						const size_t rowStart = sliceOffsets[zIncr] + rowOffsets[yIncr];
+						values[4 * zIncr + 2 * yIncr] = getOriginalValue(rowStart + lower[0]);
+						values[4 * zIncr + 2 * yIncr + 1] = getOriginalValue(rowStart + upper[0]);
+					}
+				}
+			}
+			else
+			{
+				throw core::InvalidParameterException("neighborhoods other than 0 and 8 not yet supported in Interpolation");
+			}
 		}
 
-
 	}//end namespace core
 }//end namespace rttb
@@ -18,6 +18,7 @@
 
 #include <boost/shared_ptr.hpp>
 #include <array>
+#include <cstdint>
 #include <rttbCommon.h>
 
 #include "rttbAccessorInterface.h"
@@ -36,6 +37,10 @@ namespace rttb
 
 		/*! @class InterpolationBase
 			@brief Base class for interpolation.
+			@details The geometry of the original data (inverted orientation, spacing, image size) is cached by setAccessorPointer(),
+			so the neighborhood of a world coordinate is determined without temporary objects. If the original data provides its
+			values as contiguous raw buffer (see core::AccessorInterface::getRawUInt16Values()), the voxel values are read directly
+			from this buffer.
 			@ingroup interpolation
 		*/
 		class RTTBInterpolation_EXPORT InterpolationBase
@@ -61,27 +66,124 @@ namespace rttb
 			*/
 			virtual DoseTypeGy getValue(const WorldCoordinate3D& aWorldCoordinate) const = 0;
 
+			/*! @brief Writes the interpolated values of aNumberOfCoordinates world coordinates to aValues (aValues[i] = getValue(aWorldCoordinates[i])).
+				The default implementation calls getValue() for every coordinate, derived classes override it with a loop over their
+				interpolation kernel.
+				@pre aValues has room for aNumberOfCoordinates values
+				@exception core::MappingOutsideOfImageException if one of the coordinates is outside the image
+				@exception core::NullPointerException if dose is nullptr
+			*/
+			virtual void getValues(const WorldCoordinate3D* aWorldCoordinates, size_t aNumberOfCoordinates,
+			                       DoseTypeGy* aValues) const;
+
+			/*! @brief Returns true if the world coordinate can be interpolated, i.e. getValue() does not throw a
+				core::MappingOutsideOfImageException (same as _spOriginalData->getGeometricInfo().isInside(aWorldCoordinate)).
+				@exception core::NullPointerException if dose is nullptr
+			*/
+			bool isInside(const WorldCoordinate3D& aWorldCoordinate) const;
+
+			/*! @brief Determines the points of a line in index space of the original data (continuous indices aStart + i * aStep,
+				i in [0, aNumberOfPoints), see getPointOnLine()) that can be interpolated (same criterion as isInside()).
+				As the image is a box in index space, these points form the range [aFirst, aEnd).
+				@post aFirst <= aEnd <= aNumberOfPoints
+				@exception core::NullPointerException if dose is nullptr
+			*/
+			void getInsideRangeOnLine(const std::array<double, 3>& aStart, const std::array<double, 3>& aStep,
+			                          size_t aNumberOfPoints, size_t& aFirst, size_t& aEnd) const;
+
+			/*! @brief Writes the interpolated values at the points aFirst to aEnd-1 of a line in index space of the original data
+				(continuous indices aStart + i * aStep) to aValues[i - aFirst]. Used if the positions are computed directly in index
+				space (e.g. by an affine mapping, see MappableDoseAccessorInterface), so no world coordinates are needed.
+				The default implementation converts the points to world coordinates and calls getValue().
+				@pre aValues has room for aEnd - aFirst values
+				@exception core::MappingOutsideOfImageException if one of the points is outside the image
+				@exception core::NullPointerException if dose is nullptr
+			*/
+			virtual void getValuesOnLine(const std::array<double, 3>& aStart, const std::array<double, 3>& aStep,
+			                             size_t aFirst, size_t aEnd, DoseTypeGy* aValues) const;
+
 		protected:
       rttb::core::AccessorInterface::ConstPointer _spOriginalData;
+
 			/*! @brief determines voxels in a certain neighborhood of a physical based coordinate and converts in a standard cube with corner points [0 0 0], [1 0 0], [0 1 0], [1 1 0], [0 0 1], [1 0 1], [0 1 1], [1 1 1].
 				@param aWorldCoordinate the coordinate where to start
 				@param neighborhood voxel around coordinate (currently only 0 and 8 implemented)
 				@param target coordinates inside the standard cube with values [0 1] in each dimension.
-				@param values dose values at all corner points of the standard cube. Is of type boost:shared_ptr[neighborhood]
-				@pre target and values have to be correctly initialized (e.g. std::array<double, 3> target = {0.0, 0.0, 0.0}; boost::shared_ptr<DoseTypeGy> values(new DoseTypeGy[8]()); where 8 is neighborhood)
+				@param values dose values at all corner points of the standard cube (only values[0] for neighborhood 0).
+				Corner points outside the image get the value of the nearest inside voxel (edge handling).
 				@exception core::InvalidParameterException if neighborhood =! 0 && !=8
 				@exception core::MappingOutsideOfImageException if initial mapping of aWorldCoordinate is outside image
 				@exception core::NullPointerException if dose is nullptr
 			*/
 			void getNeighborhoodVoxelValues(const WorldCoordinate3D& aWorldCoordinate,
 			                                unsigned int neighborhood, std::array<double, 3>& target,
-			                                boost::shared_ptr<DoseTypeGy[]> values) const;
+			                                std::array<DoseTypeGy, 8>& values) const;
 
-			/*! @brief returns the nearest inside voxel value
-				@pre the voxelGridIndex is outside the image and voxelGridIndex>image.size() for all dimensions. Also voxelGridIndex[]>=0 for all dimensions
-				@note used for virtually expanding the image by one voxel as edge handling
+			/*! @brief same as above for a continuous voxel index of the original data
+				@exception core::MappingOutsideOfImageException if aContinuousIndex is outside image
+			*/
+			void getNeighborhoodVoxelValues(const std::array<double, 3>& aContinuousIndex,
+			                                unsigned int neighborhood, std::array<double, 3>& target,
+			                                std::array<DoseTypeGy, 8>& values) const;
+
+			/*! @brief Computes the point aPoint of a line in index space (aStart + aPoint * aStep). getInsideRangeOnLine() and
+				the implementations of getValuesOnLine() use it, so both get exactly the same continuous indices.
+			*/
+			static void getPointOnLine(const std::array<double, 3>& aStart, const std::array<double, 3>& aStep, size_t aPoint,
+			                           std::array<double, 3>& aContinuousIndex)
+			{
+				const double position = static_cast<double>(aPoint);
+				aContinuousIndex[0] = aStart[0] + aStep[0] * position;
+				aContinuousIndex[1] = aStart[1] + aStep[1] * position;
+				aContinuousIndex[2] = aStart[2] + aStep[2] * position;
+			};
+
+		private:
+			/*! @brief Converts the world coordinate to a continuous index of the original data (same computation as
+				core::GeometricInfo::worldCoordinateToContinuousIndex(), so both agree on the coordinates inside the image).
 			*/
-			DoseTypeGy getNearestInsideVoxelValue(const VoxelGridIndex3D& currentVoxelIndex) const;
+			void worldCoordinateToContinuousIndex(const WorldCoordinate3D& aWorldCoordinate,
+			                                      std::array<double, 3>& aIndex) const
+			{
+				const double distance[3] = {aWorldCoordinate.x() - _imagePosition[0], aWorldCoordinate.y() - _imagePosition[1],
+				                            aWorldCoordinate.z() - _imagePosition[2]
+				                           };
+
+				for (unsigned int i = 0; i < 3; ++i)
+				{
+					aIndex[i] = (_invertedOrientation[i][0] * distance[0] + _invertedOrientation[i][1] * distance[1] +
+					             _invertedOrientation[i][2] * distance[2]) / _spacing[i];
+				}
+			};
+
+			/*! @return true if the nearest voxel of the continuous index is inside the image*/
+			bool isInsideImage(const std::array<double, 3>& aIndex) const
+			{
+				return aIndex[0] >= -0.5 && aIndex[1] >= -0.5 && aIndex[2] >= -0.5 &&
+				       static_cast<GridIndexType>(aIndex[0] + 0.5) < _imageSize[0] &&
+				       static_cast<GridIndexType>(aIndex[1] + 0.5) < _imageSize[1] &&
+				       static_cast<GridIndexType>(aIndex[2] + 0.5) < _imageSize[2];
+			};
+
+			DoseTypeGy getOriginalValue(const size_t aID) const
+			{
+				if (_rawValues != nullptr)
+				{
+					return _rawValues[aID] * _rawScaling;
+				}
+
+				return _spOriginalData->getValueAt(static_cast<VoxelGridID>(aID));
+			};
+
+			/*! inverted orientation matrix and spacing of the original data. They are not combined into one matrix, because the
+				result would be rounded differently than in core::GeometricInfo at the image borders.*/
+			std::array<std::array<double, 3>, 3> _invertedOrientation;
+			std::array<double, 3> _spacing;
+			std::array<double, 3> _imagePosition;
+			std::array<GridIndexType, 3> _imageSize;
+			/*! raw values of the original data, nullptr if the values are not available as raw buffer*/
+			const std::uint16_t* _rawValues{nullptr};
+			GenericValueType _rawScaling{0};
 		};
 
 	}
@@ -15,15 +15,13 @@
 
 #include "rttbLinearInterpolation.h"
 
-#include <boost/make_shared.hpp>
-
 namespace rttb
 {
 	namespace interpolation
 	{
 
-		DoseTypeGy LinearInterpolation::trilinear(std::array<double, 3> target,
-		        boost::shared_ptr<DoseTypeGy[]> values) const
+		DoseTypeGy LinearInterpolation::trilinear(const std::array<double, 3>& target,
+		        const std::array<DoseTypeGy, 8>& values) const
 		{
 			//4 linear interpolation in x direction
 			DoseTypeGy c_00 = values[0] * (1.0 - target[0]) + values[1] * target[0];
@@ -42,12 +40,40 @@ namespace rttb
 		DoseTypeGy LinearInterpolation::getValue(const WorldCoordinate3D& aWorldCoordinate) const
 		{
 			//proper initialization of target and values
-			std::array<double, 3> target = {0.0, 0.0, 0.0};
-      auto values = boost::make_shared<DoseTypeGy[]>(8);
+			std::array<double, 3> target = {{0.0, 0.0, 0.0}};
+			std::array<DoseTypeGy, 8> values;
 			getNeighborhoodVoxelValues(aWorldCoordinate, 8, target, values);
 
 			return trilinear(target, values);
 		}
 
+		void LinearInterpolation::getValues(const WorldCoordinate3D* aWorldCoordinates, size_t aNumberOfCoordinates,
+		                                    DoseTypeGy* aValues) const
+		{
+			std::array<double, 3> target = {{0.0, 0.0, 0.0}};
+			std::array<DoseTypeGy, 8> values;
+
+			for (size_t i = 0; i < aNumberOfCoordinates; ++i)
+			{
+				getNeighborhoodVoxelValues(aWorldCoordinates[i], 8, target, values);
+				aValues[i] = trilinear(target, values);
+			}
+		}
+
+		void LinearInterpolation::getValuesOnLine(const std::array<double, 3>& aStart, const std::array<double, 3>& aStep,
+		        size_t aFirst, size_t aEnd, DoseTypeGy* aValues) const
+		{
+			std::array<double, 3> continuousIndex;
+			std::array<double, 3> target = {{0.0, 0.0, 0.0}};
+			std::array<DoseTypeGy, 8> values;
+
+			for (size_t i = aFirst; i < aEnd; ++i)
+			{
+				getPointOnLine(aStart, aStep, i, continuousIndex);
+				getNeighborhoodVoxelValues(continuousIndex, 8, target, values);
+				aValues[i - aFirst] = trilinear(target, values);
+			}
+		}
+
 	}
 }
@@ -42,12 +42,24 @@ namespace rttb
 			*/
 			DoseTypeGy getValue(const WorldCoordinate3D& aWorldCoordinate) const override;
 
+			/*! @brief Returns the interpolated values of all given world coordinates
+				@sa InterpolationBase::getValues
+			*/
+			void getValues(const WorldCoordinate3D* aWorldCoordinates, size_t aNumberOfCoordinates,
+			               DoseTypeGy* aValues) const override;
+
+			/*! @brief Returns the interpolated values of the points of a line in index space
+				@sa InterpolationBase::getValuesOnLine
+			*/
+			void getValuesOnLine(const std::array<double, 3>& aStart, const std::array<double, 3>& aStep,
+			                     size_t aFirst, size_t aEnd, DoseTypeGy* aValues) const override;
+
 		private:
 			/*! @brief Trilinar interpolation
 				@sa InterpolationBase for details about target and values
 				@note Source: http://en.wikipedia.org/wiki/Trilinear_interpolation
 			*/
-			DoseTypeGy trilinear(std::array<double, 3> target, boost::shared_ptr<DoseTypeGy[]> values) const;
+			DoseTypeGy trilinear(const std::array<double, 3>& target, const std::array<DoseTypeGy, 8>& values) const;
 		};
 
 	}
@@ -0,0 +1,170 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include "rttbMappableDoseAccessorInterface.h"
+
+#include <boost/make_shared.hpp>
+
+#include "rttbThreadPool.h"
+
+namespace rttb
+{
+	namespace interpolation
+	{
+		core::GenericMutableDoseAccessor::Pointer MappableDoseAccessorInterface::resample() const
+		{
+			auto resampledDose = boost::make_shared<core::GenericMutableDoseAccessor>(_geoInfoTargetImage, getUID());
+
+			const unsigned int numberOfColumns = _geoInfoTargetImage.getNumColumns();
+			const unsigned int numberOfRows = _geoInfoTargetImage.getNumRows();
+			const size_t sliceSize = static_cast<size_t>(numberOfColumns) * numberOfRows;
+			DoseTypeGy* values = resampledDose->getDoseVector().data();
+
+			//the transformation is the same for all rows, so its affine index mapping is only computed once
+			RowBuffers initialBuffers;
+			initialBuffers.hasAffineIndexMapping = getAffineIndexMapping(initialBuffers.indexMatrix, initialBuffers.indexOffset);
+
+			core::TaskGroup tasks;
+
+			for (unsigned int slice = 0; slice < _geoInfoTargetImage.getNumSlices(); ++slice)
+			{
+				tasks.run([this, slice, numberOfColumns, numberOfRows, sliceSize, values, &initialBuffers]()
+				{
+					RowBuffers buffers(initialBuffers);
+
+					for (unsigned int row = 0; row < numberOfRows; ++row)
+					{
+						computeRowValues(row, slice, values + slice * sliceSize + static_cast<size_t>(row) * numberOfColumns, buffers);
+					}
+				});
+			}
+
+			tasks.wait();
+
+			return resampledDose;
+		}
+
+		void MappableDoseAccessorInterface::computeRowValues(unsigned int aRow, unsigned int aSlice,
+		        DoseTypeGy* aValues, RowBuffers& /*aBuffers*/) const
+		{
+			for (unsigned int column = 0; column < _geoInfoTargetImage.getNumColumns(); ++column)
+			{
+				aValues[column] = getValueAt(VoxelGridIndex3D(column, aRow, aSlice));
+			}
+		}
+
+		void MappableDoseAccessorInterface::computeRowWorldCoordinates(unsigned int aRow, unsigned int aSlice,
+		        std::vector<WorldCoordinate3D>& aWorldCoordinates) const
+		{
+			const OrientationMatrix& orientation = _geoInfoTargetImage.getOrientationMatrix();
+			const SpacingVectorType3D& spacing = _geoInfoTargetImage.getSpacing();
+			const WorldCoordinate3D& imagePosition = _geoInfoTargetImage.getImagePositionPatient();
+
+			//world coordinate = orientation * (index .* spacing) + image position, the row and slice terms are constant along the row
+			const double rowPosition = aRow * spacing(1);
+			const double slicePosition = aSlice * spacing(2);
+			double rowTerms[3];
+			double sliceTerms[3];
+
+			for (unsigned int i = 0; i < 3; ++i)
+			{
+				rowTerms[i] = orientation(i, 1) * rowPosition;
+				sliceTerms[i] = orientation(i, 2) * slicePosition;
+			}
+
+			const unsigned int numberOfColumns = _geoInfoTargetImage.getNumColumns();
+
+			if (aWorldCoordinates.size() < numberOfColumns)
+			{
+				aWorldCoordinates.resize(numberOfColumns);
+			}
+
+			for (unsigned int column = 0; column < numberOfColumns; ++column)
+			{
+				const double columnPosition = column * spacing(0);
+
+				for (unsigned int i = 0; i < 3; ++i)
+				{
+					aWorldCoordinates[column](i) = orientation(i, 0) * columnPosition + rowTerms[i] + sliceTerms[i] + imagePosition(i);
+				}
+			}
+		}
+
+		bool MappableDoseAccessorInterface::getAffineIndexMapping(std::array<std::array<double, 3>, 3>& aMatrix,
+		        std::array<double, 3>& aOffset) const
+		{
+			std::array<std::array<double, 3>, 3> transformationMatrix;
+			std::array<double, 3> transformationOffset;
+
+			if (!_spTransformation->getInverseAffineParameters(transformationMatrix, transformationOffset))
+			{
+				return false;
+			}
+
+			const OrientationMatrix& targetOrientation = _geoInfoTargetImage.getOrientationMatrix();
+			const SpacingVectorType3D& targetSpacing = _geoInfoTargetImage.getSpacing();
+			const WorldCoordinate3D& targetPosition = _geoInfoTargetImage.getImagePositionPatient();
+
+			const core::GeometricInfo& movingGeoInfo = _spOriginalDoseDataMovingImage->getGeometricInfo();
+			const OrientationMatrix& movingInvertedOrientation = movingGeoInfo.getInvertedOrientationMatrix();
+			const SpacingVectorType3D& movingSpacing = movingGeoInfo.getSpacing();
+			const WorldCoordinate3D& movingPosition = movingGeoInfo.getImagePositionPatient();
+
+			//target index -> moving world coordinate: transformation * (targetOrientation * (index .* targetSpacing) + targetPosition) + offset
+			double worldMatrix[3][3];
+			double worldOffset[3];
+
+			for (unsigned int i = 0; i < 3; ++i)
+			{
+				worldOffset[i] = transformationOffset[i] - movingPosition(i);
+
+				for (unsigned int j = 0; j < 3; ++j)
+				{
+					worldMatrix[i][j] = 0.0;
+
+					for (unsigned int k = 0; k < 3; ++k)
+					{
+						worldMatrix[i][j] += transformationMatrix[i][k] * targetOrientation(k, j) * targetSpacing(j);
+					}
+
+					worldOffset[i] += transformationMatrix[i][j] * targetPosition(j);
+				}
+			}
+
+			//moving world coordinate -> moving index: (movingInvertedOrientation * (world - movingPosition)) ./ movingSpacing
+			for (unsigned int i = 0; i < 3; ++i)
+			{
+				aOffset[i] = 0.0;
+
+				for (unsigned int j = 0; j < 3; ++j)
+				{
+					aMatrix[i][j] = 0.0;
+
+					for (unsigned int k = 0; k < 3; ++k)
+					{
+						aMatrix[i][j] += movingInvertedOrientation(i, k) * worldMatrix[k][j];
+					}
+
+					aMatrix[i][j] /= movingSpacing(i);
+					aOffset[i] += movingInvertedOrientation(i, j) * worldOffset[j];
+				}
+
+				aOffset[i] /= movingSpacing(i);
+			}
+
+			return true;
+		}
+	}//end namespace interpolation
+}//end namespace rttb
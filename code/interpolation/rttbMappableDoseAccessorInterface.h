@@ -16,14 +16,25 @@
 #ifndef __MAPPABLE_DOSE_ACCESSOR_BASE_H
 #define __MAPPABLE_DOSE_ACCESSOR_BASE_H
 
+#include <array>
+#include <vector>
+
 #include <rttbCommon.h>
 
 #include "rttbDoseAccessorInterface.h"
+#include "rttbGenericMutableDoseAccessor.h"
 #include "rttbGeometricInfo.h"
 #include "rttbBaseType.h"
 #include "rttbTransformationInterface.h"
 #include "rttbNullPointerException.h"
 
+#include "RTTBInterpolationExports.h"
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
 namespace rttb
 {
 	namespace interpolation
@@ -32,9 +43,10 @@ namespace rttb
 		/*! @class MappableDoseAccessorInterface
 		@brief Interface for dealing with dose information that has to be transformed into another geometry than the original dose image
 		@details implementation of strategy is done by derived class (e.g. SimpleMappableDoseAccessor or RosuMappableDoseAccessor. Transformation is defined in TransformationInterface
+		The values are either computed on demand per voxel (getValueAt()) or for the whole target geometry at once (resample()).
 		@ingroup interpolation
 		*/
-		class MappableDoseAccessorInterface: public core::DoseAccessorInterface
+		class RTTBInterpolation_EXPORT MappableDoseAccessorInterface: public core::DoseAccessorInterface
 		{
 		public:
       rttbClassMacro(MappableDoseAccessorInterface,core::DoseAccessorInterface)
@@ -88,8 +100,65 @@ namespace rttb
 			{
 				return _spOriginalDoseDataMovingImage->getUID();
 			};
+
+			/*! @brief Maps the dose of all voxels of the target geometry (same values as getValueAt()) and stores them in a dense accessor.
+				@details The slices are computed in parallel on the thread pool of the library (see core::ThreadPool), so
+				transformInverse() of the transformation is called concurrently. Each row is computed with computeRowValues(), the
+				rows of a slice share one RowBuffers object. The affine index mapping (see getAffineIndexMapping()) is computed once
+				and handed to all rows with the RowBuffers.
+				@return accessor with the target geometry and the UID of this accessor
+				@exception core::MappingOutsideOfImageException if a voxel is mapped outside and _acceptPadding==false
+			*/
+			core::GenericMutableDoseAccessor::Pointer resample() const;
+
+		protected:
+			/*! @brief Temporary buffers of computeRowValues(). They are reused for all rows of a slice and only grow, so the
+				coordinates (which allocate their elements) are not created again for every row.
+			*/
+			struct RowBuffers
+			{
+				std::vector<WorldCoordinate3D> targetCoordinates;
+				//! target coordinates of the samples of the row if there are several samples per voxel
+				std::vector<WorldCoordinate3D> sampleCoordinates;
+				std::vector<WorldCoordinate3D> movingCoordinates;
+				std::vector<DoseTypeGy> values;
+				std::vector<size_t> indices;
+				std::vector<size_t> offsets;
+				//! true if indexMatrix and indexOffset hold the affine index mapping (see getAffineIndexMapping())
+				bool hasAffineIndexMapping = false;
+				std::array<std::array<double, 3>, 3> indexMatrix;
+				std::array<double, 3> indexOffset;
+			};
+
+			/*! @brief Computes the values of all voxels of the row aRow in the slice aSlice of the target geometry
+				(getNumColumns() values, aValues[column] = getValueAt(VoxelGridIndex3D(column, aRow, aSlice))).
+				The default implementation calls getValueAt() for every voxel, derived classes override it with batched computations.
+				@pre aRow and aSlice are inside the target geometry
+			*/
+			virtual void computeRowValues(unsigned int aRow, unsigned int aSlice, DoseTypeGy* aValues,
+			                              RowBuffers& aBuffers) const;
+
+			/*! @brief Computes the world coordinates of all voxels of the row aRow in the slice aSlice of the target geometry
+				(same results as _geoInfoTargetImage.indexToWorldCoordinate()). The parts of the computation that are constant
+				along the row are done once per row.
+				@post aWorldCoordinates has at least getNumColumns() elements (it is not shrunk)
+			*/
+			void computeRowWorldCoordinates(unsigned int aRow, unsigned int aSlice,
+			                                std::vector<WorldCoordinate3D>& aWorldCoordinates) const;
+
+			/*! @brief Computes the mapping of an affine transformation in index space: the continuous voxel index of the moving
+				image is aMatrix * (voxel index of the target image) + aOffset. So the moving positions of a row are computed
+				without world coordinates, they change by the first column of aMatrix from voxel to voxel.
+				@return false if the transformation is not affine (see TransformationInterface::getInverseAffineParameters()),
+				aMatrix and aOffset are only set if true is returned
+			*/
+			bool getAffineIndexMapping(std::array<std::array<double, 3>, 3>& aMatrix, std::array<double, 3>& aOffset) const;
 		};
 	}
 }
 
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
 #endif
@@ -16,7 +16,6 @@
 #include "rttbNearestNeighborInterpolation.h"
 
 #include <array>
-#include <boost/make_shared.hpp>
 
 namespace rttb
 {
@@ -26,10 +25,38 @@ namespace rttb
 		{
 			//proper initialization of target and values (although target is irrelevant in nearest neighbor case)
 			std::array<double, 3> target = {{0.0, 0.0, 0.0}};
-      auto values = boost::make_shared<DoseTypeGy[]>(8);
+			std::array<DoseTypeGy, 8> values;
 			getNeighborhoodVoxelValues(aWorldCoordinate, 0, target, values);
 			return values[0];
 		}
 
+		void NearestNeighborInterpolation::getValues(const WorldCoordinate3D* aWorldCoordinates,
+		        size_t aNumberOfCoordinates, DoseTypeGy* aValues) const
+		{
+			std::array<double, 3> target = {{0.0, 0.0, 0.0}};
+			std::array<DoseTypeGy, 8> values;
+
+			for (size_t i = 0; i < aNumberOfCoordinates; ++i)
+			{
+				getNeighborhoodVoxelValues(aWorldCoordinates[i], 0, target, values);
+				aValues[i] = values[0];
+			}
+		}
+
+		void NearestNeighborInterpolation::getValuesOnLine(const std::array<double, 3>& aStart, const std::array<double, 3>& aStep,
+		        size_t aFirst, size_t aEnd, DoseTypeGy* aValues) const
+		{
+			std::array<double, 3> continuousIndex;
+			std::array<double, 3> target = {{0.0, 0.0, 0.0}};
+			std::array<DoseTypeGy, 8> values;
+
+			for (size_t i = aFirst; i < aEnd; ++i)
+			{
+				getPointOnLine(aStart, aStep, i, continuousIndex);
+				getNeighborhoodVoxelValues(continuousIndex, 0, target, values);
+				aValues[i - aFirst] = values[0];
+			}
+		}
+
 	}
 }
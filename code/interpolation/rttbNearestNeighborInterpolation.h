@@ -39,6 +39,18 @@ namespace rttb
 			/*! @brief Returns the interpolated value (the nearest voxel value given by _spOriginalData->getGeometricInfo().worldCoordinateToIndex())
 			*/
 			DoseTypeGy getValue(const WorldCoordinate3D& aWorldCoordinate) const override;
+
+			/*! @brief Returns the nearest voxel values of all given world coordinates
+				@sa InterpolationBase::getValues
+			*/
+			void getValues(const WorldCoordinate3D* aWorldCoordinates, size_t aNumberOfCoordinates,
+			               DoseTypeGy* aValues) const override;
+
+			/*! @brief Returns the nearest voxel values of the points of a line in index space
+				@sa InterpolationBase::getValuesOnLine
+			*/
+			void getValuesOnLine(const std::array<double, 3>& aStart, const std::array<double, 3>& aStep,
+			                     size_t aFirst, size_t aEnd, DoseTypeGy* aValues) const override;
 		};
 
 	}
@@ -138,7 +138,7 @@ namespace rttb
 			std::vector<WorldCoordinate3D> octants;
 			SpacingVectorType3D spacingTargetImage = _geoInfoTargetImage.getSpacing();
 
-			core::GeometricInfo geometricInfoDoseData = _spOriginalDoseDataMovingImage->getGeometricInfo();
+			const core::GeometricInfo& geometricInfoDoseData = _spOriginalDoseDataMovingImage->getGeometricInfo();
 
 			//as the corner point is the coordinate of the voxel (grid), 0.25 and 0.75 are the center of the subvoxels
 			for (double xOct = -0.25; xOct <= 0.25; xOct += 0.5)
@@ -162,6 +162,136 @@ namespace rttb
 			return octants;
 		}
 
+		void RosuMappableDoseAccessor::computeRowValues(unsigned int aRow, unsigned int aSlice,
+		        DoseTypeGy* aValues, RowBuffers& aBuffers) const
+		{
+			computeRowWorldCoordinates(aRow, aSlice, aBuffers.targetCoordinates);
+
+			const unsigned int numberOfColumns = _geoInfoTargetImage.getNumColumns();
+			const size_t maxNumberOfOctants = 8 * static_cast<size_t>(numberOfColumns);
+
+			if (aBuffers.movingCoordinates.size() < maxNumberOfOctants)
+			{
+				aBuffers.sampleCoordinates.resize(maxNumberOfOctants);
+				aBuffers.movingCoordinates.resize(maxNumberOfOctants);
+				aBuffers.values.resize(maxNumberOfOctants);
+				aBuffers.indices.resize(maxNumberOfOctants);
+				aBuffers.offsets.resize(numberOfColumns + 1);
+			}
+
+			//collect the octants of the voxels (see getOctants()) in sampleCoordinates, offsets[column] is the first octant of
+			//the column. Without padding only the columns before the first column with too few octants are processed, so the
+			//exceptions are thrown in the same order as by getValueAt().
+			const SpacingVectorType3D& spacingTargetImage = _geoInfoTargetImage.getSpacing();
+			size_t numberOfOctants = 0;
+			unsigned int endColumn = numberOfColumns;
+
+			for (unsigned int column = 0; column < numberOfColumns; ++column)
+			{
+				const WorldCoordinate3D& aCoordinate = aBuffers.targetCoordinates[column];
+				const size_t firstOctant = numberOfOctants;
+				aBuffers.offsets[column] = firstOctant;
+
+				for (double xOct = -0.25; xOct <= 0.25; xOct += 0.5)
+				{
+					for (double yOct = -0.25; yOct <= 0.25; yOct += 0.5)
+					{
+						for (double zOct = -0.25; zOct <= 0.25; zOct += 0.5)
+						{
+							WorldCoordinate3D& octant = aBuffers.sampleCoordinates[numberOfOctants];
+							octant(0) = aCoordinate.x() + (xOct * spacingTargetImage.x());
+							octant(1) = aCoordinate.y() + (yOct * spacingTargetImage.y());
+							octant(2) = aCoordinate.z() + (zOct * spacingTargetImage.z());
+
+							//the interpolation checks the geometry of the moving image like getOctants()
+							if (_spInterpolation->isInside(octant))
+							{
+								++numberOfOctants;
+							}
+						}
+					}
+				}
+
+				//too many samples are mapped outside the image
+				if (numberOfOctants - firstOctant <= 2)
+				{
+					numberOfOctants = firstOctant;
+
+					if (!_acceptPadding)
+					{
+						endColumn = column;
+						break;
+					}
+				}
+			}
+
+			aBuffers.offsets[endColumn] = numberOfOctants;
+
+			//transform coordinates
+			_spTransformation->transformInverseBatch(aBuffers.sampleCoordinates.data(), numberOfOctants,
+			        aBuffers.movingCoordinates.data());
+
+			//the octants mapped inside the moving image are collected at the front of movingCoordinates. indices[octant] is the
+			//position of the transformed octant there or outsideOctant if it is mapped outside.
+			const size_t outsideOctant = maxNumberOfOctants;
+			size_t numberOfInsideOctants = 0;
+
+			for (size_t octant = 0; octant < numberOfOctants; ++octant)
+			{
+				const WorldCoordinate3D& worldCoordinateMoving = aBuffers.movingCoordinates[octant];
+
+				if (_spInterpolation->isInside(worldCoordinateMoving))
+				{
+					if (numberOfInsideOctants != octant)
+					{
+						aBuffers.movingCoordinates[numberOfInsideOctants] = worldCoordinateMoving;
+					}
+
+					aBuffers.indices[octant] = numberOfInsideOctants;
+					++numberOfInsideOctants;
+				}
+				//Mapped outside of image? Check if padding is allowed
+				else if (_acceptPadding)
+				{
+					aBuffers.indices[octant] = outsideOctant;
+				}
+				else
+				{
+					throw core::MappingOutsideOfImageException("Mapping outside of image");
+				}
+			}
+
+			if (endColumn < numberOfColumns)
+			{
+				throw core::MappingOutsideOfImageException("Too many samples are mapped outside the image!");
+			}
+
+			//get trilinear interpolation value of every octant point
+			_spInterpolation->getValues(aBuffers.movingCoordinates.data(), numberOfInsideOctants, aBuffers.values.data());
+
+			for (unsigned int column = 0; column < numberOfColumns; ++column)
+			{
+				const size_t firstOctant = aBuffers.offsets[column];
+				const size_t endOctant = aBuffers.offsets[column + 1];
+
+				if (endOctant == firstOctant)
+				{
+					aValues[column] = _defaultOutsideValue;
+					continue;
+				}
+
+				//same summation order as getValueAt()
+				DoseTypeGy interpolatedDoseValue = 0.0;
+
+				for (size_t octant = firstOctant; octant < endOctant; ++octant)
+				{
+					const size_t index = aBuffers.indices[octant];
+					interpolatedDoseValue += (index == outsideOctant) ? _defaultOutsideValue : aBuffers.values[index];
+				}
+
+				aValues[column] = interpolatedDoseValue / (DoseTypeGy)(endOctant - firstOctant);
+			}
+		}
 
 	}//end namespace interpolation
 }//end namespace rttb
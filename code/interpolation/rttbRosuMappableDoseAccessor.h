@@ -62,6 +62,13 @@ namespace rttb
 			*/
 			GenericValueType getValueAt(const VoxelGridIndex3D& aIndex) const override;
 
+		protected:
+			/*! @brief Computes the octants of all voxels of the row, transforms them and interpolates all octants mapped inside the
+				moving image with one call of InterpolationBase::getValues(). Same boundary treatment as getValueAt().
+			*/
+			void computeRowValues(unsigned int aRow, unsigned int aSlice, DoseTypeGy* aValues,
+			                      RowBuffers& aBuffers) const override;
+
 		private:
 			/*! @brief returns the octant coordinates around a coordinate.
 				@details i.e. coordinate is the center of a virtual voxel. Then, each side is divided into equal parts. The centers of the new subvoxels are then returned.
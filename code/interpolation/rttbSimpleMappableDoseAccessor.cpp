@@ -14,6 +14,9 @@
 //------------------------------------------------------------------------
 
 #include "rttbSimpleMappableDoseAccessor.h"
+
+#include <algorithm>
+
 #include "rttbNullPointerException.h"
 #include "rttbMappingOutsideOfImageException.h"
 
@@ -109,5 +112,104 @@ namespace rttb
 			}
 		}
 
+		void SimpleMappableDoseAccessor::computeRowValues(unsigned int aRow, unsigned int aSlice,
+		        DoseTypeGy* aValues, RowBuffers& aBuffers) const
+		{
+			if (aBuffers.hasAffineIndexMapping)
+			{
+				computeAffineRowValues(aRow, aSlice, aBuffers.indexMatrix, aBuffers.indexOffset, aValues);
+				return;
+			}
+
+			computeRowWorldCoordinates(aRow, aSlice, aBuffers.targetCoordinates);
+
+			const unsigned int numberOfColumns = _geoInfoTargetImage.getNumColumns();
+
+			if (aBuffers.movingCoordinates.size() < numberOfColumns)
+			{
+				aBuffers.movingCoordinates.resize(numberOfColumns);
+				aBuffers.values.resize(numberOfColumns);
+				aBuffers.indices.resize(numberOfColumns);
+			}
+
+			//transform coordinates
+			_spTransformation->transformInverseBatch(aBuffers.targetCoordinates.data(), numberOfColumns,
+			        aBuffers.movingCoordinates.data());
+
+			//the coordinates mapped inside the moving image are collected at the front of movingCoordinates
+			size_t numberOfInsideCoordinates = 0;
+
+			for (unsigned int column = 0; column < numberOfColumns; ++column)
+			{
+				const WorldCoordinate3D& worldCoordinateMoving = aBuffers.movingCoordinates[column];
+
+				if (_spInterpolation->isInside(worldCoordinateMoving))
+				{
+					if (numberOfInsideCoordinates != column)
+					{
+						aBuffers.movingCoordinates[numberOfInsideCoordinates] = worldCoordinateMoving;
+					}
+
+					aBuffers.indices[numberOfInsideCoordinates] = column;
+					++numberOfInsideCoordinates;
+				}
+				//Mapped outside of image? Check if padding is allowed
+				else if (_acceptPadding)
+				{
+					aValues[column] = _defaultOutsideValue;
+				}
+				else
+				{
+					throw core::MappingOutsideOfImageException("Error in conversion from index to world coordinates");
+				}
+			}
+
+			//Use Interpolation to compute dose at mappedImage
+			_spInterpolation->getValues(aBuffers.movingCoordinates.data(), numberOfInsideCoordinates, aBuffers.values.data());
+
+			for (size_t i = 0; i < numberOfInsideCoordinates; ++i)
+			{
+				aValues[aBuffers.indices[i]] = aBuffers.values[i];
+			}
+		}
+
+		void SimpleMappableDoseAccessor::computeAffineRowValues(unsigned int aRow, unsigned int aSlice,
+		        const std::array<std::array<double, 3>, 3>& aIndexMatrix, const std::array<double, 3>& aIndexOffset,
+		        DoseTypeGy* aValues) const
+		{
+			const unsigned int numberOfColumns = _geoInfoTargetImage.getNumColumns();
+
+			//continuous index in the moving image of the first voxel of the row, from voxel to voxel it changes by the first
+			//column of the index matrix
+			std::array<double, 3> rowStart;
+			std::array<double, 3> columnStep;
+
+			for (unsigned int i = 0; i < 3; ++i)
+			{
+				rowStart[i] = aIndexMatrix[i][1] * aRow + aIndexMatrix[i][2] * aSlice + aIndexOffset[i];
+				columnStep[i] = aIndexMatrix[i][0];
+			}
+
+			size_t firstInsideColumn = 0;
+			size_t endInsideColumn = 0;
+			_spInterpolation->getInsideRangeOnLine(rowStart, columnStep, numberOfColumns, firstInsideColumn, endInsideColumn);
+
+			//Mapped outside of image? Check if padding is allowed
+			if (firstInsideColumn > 0 || endInsideColumn < numberOfColumns)
+			{
+				if (!_acceptPadding)
+				{
+					throw core::MappingOutsideOfImageException("Error in conversion from index to world coordinates");
+				}
+
+				std::fill(aValues, aValues + firstInsideColumn, _defaultOutsideValue);
+				std::fill(aValues + endInsideColumn, aValues + numberOfColumns, _defaultOutsideValue);
+			}
+
+			//Use Interpolation to compute dose at mappedImage
+			_spInterpolation->getValuesOnLine(rowStart, columnStep, firstInsideColumn, endInsideColumn,
+			                                  aValues + firstInsideColumn);
+		}
+
 	}//end namespace interpolation
 }//end namespace rttb
@@ -16,6 +16,8 @@
 #ifndef __SIMPLE_MAPPABLE_DOSE_ACCESSOR_H
 #define __SIMPLE_MAPPABLE_DOSE_ACCESSOR_H
 
+#include <array>
+
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
 
@@ -64,6 +66,23 @@ namespace rttb
 				@exception core::MappingOutsideOfImageException if the point is mapped outside and if _acceptPadding==false, possibly returning _defaultValue)
 			*/
 			GenericValueType getValueAt(const VoxelGridIndex3D& aIndex) const override;
+
+		protected:
+			/*! @brief Transforms the world coordinates of the row and interpolates all coordinates mapped inside the moving image
+				with one call of InterpolationBase::getValues(). If aBuffers holds the affine index mapping of the transformation, the
+				row is mapped in index space (see computeAffineRowValues()).
+			*/
+			void computeRowValues(unsigned int aRow, unsigned int aSlice, DoseTypeGy* aValues,
+			                      RowBuffers& aBuffers) const override;
+
+		private:
+			/*! @brief Maps the row with the affine index mapping (see getAffineIndexMapping()): the row is a line in index space
+				of the moving image that is interpolated with InterpolationBase::getValuesOnLine(). No world coordinates are computed
+				and the transformation is not called.
+			*/
+			void computeAffineRowValues(unsigned int aRow, unsigned int aSlice,
+			                            const std::array<std::array<double, 3>, 3>& aIndexMatrix, const std::array<double, 3>& aIndexOffset,
+			                            DoseTypeGy* aValues) const;
 		};
 	}
 }
@@ -0,0 +1,43 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+
+#include "rttbTransformationInterface.h"
+
+namespace rttb
+{
+	namespace interpolation
+	{
+		bool TransformationInterface::transformInverseBatch(const WorldCoordinate3D* worldCoordinatesTarget,
+		        size_t aNumberOfPoints, WorldCoordinate3D* worldCoordinatesMoving) const
+		{
+			bool ok = true;
+
+			for (size_t i = 0; i < aNumberOfPoints; ++i)
+			{
+				ok = transformInverse(worldCoordinatesTarget[i], worldCoordinatesMoving[i]) && ok;
+			}
+
+			return ok;
+		}
+
+		bool TransformationInterface::getInverseAffineParameters(std::array<std::array<double, 3>, 3>& /*aMatrix*/,
+		        std::array<double, 3>& /*aOffset*/) const
+		{
+			return false;
+		}
+
+	}
+}
@@ -16,6 +16,9 @@
 #ifndef __TRANSFORMATION_INTERFACE_H
 #define __TRANSFORMATION_INTERFACE_H
 
+#include <array>
+#include <cstddef>
+
 #include <rttbCommon.h>
 
 #include "rttbBaseType.h"
@@ -54,6 +57,25 @@ namespace rttb
 			virtual bool transformInverse(const WorldCoordinate3D& worldCoordinateTarget,
 			                              WorldCoordinate3D& worldCoordinateMoving) const = 0;
 
+			/*! @brief performs a transformation targetImage --> movingImage for aNumberOfPoints points
+				(worldCoordinatesMoving[i] = transformation of worldCoordinatesTarget[i]).
+				@details The default implementation calls transformInverse() for every point. Derived classes override it to
+				convert the points into their native representation once and transform them in one tight loop.
+				@pre both arrays have at least aNumberOfPoints elements and do not overlap
+				@return true if all points were transformed successfully
+			*/
+			virtual bool transformInverseBatch(const WorldCoordinate3D* worldCoordinatesTarget, size_t aNumberOfPoints,
+			                                   WorldCoordinate3D* worldCoordinatesMoving) const;
+
+			/*! @brief Returns the parameters of the transformation targetImage --> movingImage if it is affine
+				(worldCoordinateMoving = aMatrix * worldCoordinateTarget + aOffset, aMatrix[row][column]).
+				@details The default implementation returns false. Derived classes override it if they can detect affine (e.g. rigid)
+				transformations, which allows the mapping to work in index space (see MappableDoseAccessorInterface).
+				@return true if the transformation is affine, aMatrix and aOffset are only set in this case
+			*/
+			virtual bool getInverseAffineParameters(std::array<std::array<double, 3>, 3>& aMatrix,
+			                                        std::array<double, 3>& aOffset) const;
+
 			/*! @brief performs a transformation movingImage --> targetImage
 			*/
 			virtual bool transform(const WorldCoordinate3D& worldCoordinateMoving,
@@ -280,6 +280,39 @@ namespace rttb
 				}
 			}
 
+			const std::uint16_t* DicomDoseAccessor::getRawUInt16Values(GenericValueType& aScaling) const
+			{
+				if (doseData.size() < static_cast<size_t>(getGridSize()))
+				{
+					return nullptr;
+				}
+
+				aScaling = _doseGridScaling;
+				return doseData.data();
+			}
+
+			void DicomDoseAccessor::getValuesUnchecked(const VoxelGridID aFirstID, const size_t aNumberOfValues,
+			        GenericValueType* aValues) const
+			{
+				const Uint16* data = doseData.data() + aFirstID;
+
+				for (size_t i = 0; i < aNumberOfValues; ++i)
+				{
+					aValues[i] = data[i] * _doseGridScaling;
+				}
+			}
+
+			void DicomDoseAccessor::gatherValuesUnchecked(const VoxelGridID* aSortedIDs, const size_t aNumberOfIDs,
+			        GenericValueType* aValues) const
+			{
+				const Uint16* data = doseData.data();
+
+				for (size_t i = 0; i < aNumberOfIDs; ++i)
+				{
+					aValues[i] = data[aSortedIDs[i]] * _doseGridScaling;
+				}
+			}
+
 		}
 	}
 }
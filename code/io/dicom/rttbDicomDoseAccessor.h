@@ -85,6 +85,16 @@ namespace rttb
 				{
 					return _doseUID;
 				};
+
+				/*! @brief returns the pixel data, aScaling is set to the dose grid scaling*/
+				const std::uint16_t* getRawUInt16Values(GenericValueType& aScaling) const override;
+
+			protected:
+				void getValuesUnchecked(const VoxelGridID aFirstID, const size_t aNumberOfValues,
+				                        GenericValueType* aValues) const override;
+
+				void gatherValuesUnchecked(const VoxelGridID* aSortedIDs, const size_t aNumberOfIDs,
+				                           GenericValueType* aValues) const override;
 			};
 		}
 	}
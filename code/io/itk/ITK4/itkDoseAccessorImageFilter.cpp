@@ -14,8 +14,10 @@
 //------------------------------------------------------------------------
 
 #include "itkDoseAccessorImageFilter.h"
-#include "itkImageRegionIterator.h"
-#include "itkImageRegionConstIteratorWithIndex.h"
+
+#include <vector>
+
+#include "itkImageScanlineIterator.h"
 #include "itkProgressReporter.h"
 
 namespace itk
@@ -37,38 +39,50 @@ namespace itk
 		ProgressReporter progress(this, threadId,
 		                          outputRegionForThread.GetNumberOfPixels());
 
-		using ImageRegionConstIteratorType = ImageRegionConstIteratorWithIndex<InputImageType>;
-		using OutputImageRegionIteratorType = ImageRegionIterator<OutputImageType>;
+		using OutputImageScanlineIteratorType = ImageScanlineIterator<OutputImageType>;
 
 		InputImagePointer inputPtr = dynamic_cast< InputImageType* >(ProcessObject::GetInput(0));
-		ImageRegionConstIteratorType inputItr;
-
-		if (inputPtr)
-		{
-			inputItr = ImageRegionConstIteratorType(inputPtr, outputRegionForThread);
-		}
-
 		OutputImagePointer outputPtr = dynamic_cast< OutputImageType* >(ProcessObject::GetOutput(0));
-		OutputImageRegionIteratorType outputItr;
-
-		if (outputPtr)
-		{
-			outputItr = OutputImageRegionIteratorType(outputPtr, outputRegionForThread);
-		}
 
 		if (inputPtr && outputPtr)
 		{
-			while (!(outputItr.IsAtEnd()))
+			OutputImageScanlineIteratorType outputItr(outputPtr, outputRegionForThread);
+			const rttb::core::GeometricInfo& geoInfo = m_Accessor->getGeometricInfo();
+			const SizeValueType lineLength = outputRegionForThread.GetSize(0);
+			std::vector<OutputImagePixelType> lineValues(lineLength);
+
+			while (!outputItr.IsAtEnd())
 			{
-				ImageRegionConstIteratorType::IndexType index = inputItr.GetIndex();
-				rttb::VoxelGridIndex3D doseIndex(index[0], index[1], index[2]);
+				//lines inside of the dose grid are read in one bulk access
+				const OutputImageType::IndexType lineStart = outputItr.GetIndex();
+				const rttb::VoxelGridIndex3D firstIndex(lineStart[0], lineStart[1], lineStart[2]);
+				const rttb::VoxelGridIndex3D lastIndex(lineStart[0] + lineLength - 1, lineStart[1], lineStart[2]);
+				rttb::VoxelGridID firstID = 0;
 
-				outputItr.Set(m_Accessor->getValueAt(doseIndex));
+				if (geoInfo.validIndex(lastIndex) && geoInfo.convert(firstIndex, firstID))
+				{
+					m_Accessor->getValues(firstID, lineLength, lineValues.data());
 
-				++outputItr;
-				++inputItr;
+					for (const auto value : lineValues)
+					{
+						outputItr.Set(value);
+						++outputItr;
+						progress.CompletedPixel();
+					}
+				}
+				else
+				{
+					while (!outputItr.IsAtEndOfLine())
+					{
+						const OutputImageType::IndexType index = outputItr.GetIndex();
+						rttb::VoxelGridIndex3D doseIndex(index[0], index[1], index[2]);
+						outputItr.Set(m_Accessor->getValueAt(doseIndex));
+						++outputItr;
+						progress.CompletedPixel();
+					}
+				}
 
-				progress.CompletedPixel();
+				outputItr.NextLine();
 			}
 		}
 	}
@@ -13,6 +13,7 @@
 //
 //------------------------------------------------------------------------
 
+#include <algorithm>
 #include <cassert>
 
 #include "rttbITKImageAccessor.h"
@@ -68,6 +69,51 @@ namespace rttb
 
 			}
 
+			const GenericValueType* ITKImageAccessor::getContiguousBuffer() const
+			{
+				const ITKImageType::RegionType& bufferedRegion = _data->GetBufferedRegion();
+				const ITKImageType::IndexType firstIndex = {{0, 0, 0}};
+
+				if (bufferedRegion.GetSize() != _data->GetLargestPossibleRegion().GetSize() ||
+				    bufferedRegion.GetIndex() != firstIndex)
+				{
+					return nullptr;
+				}
+
+				return _data->GetBufferPointer();
+			}
+
+			void ITKImageAccessor::getValuesUnchecked(const VoxelGridID aFirstID, const size_t aNumberOfValues,
+			        GenericValueType* aValues) const
+			{
+				const GenericValueType* buffer = getContiguousBuffer();
+
+				if (buffer == nullptr)
+				{
+					core::AccessorWithGeoInfoBase::getValuesUnchecked(aFirstID, aNumberOfValues, aValues);
+					return;
+				}
+
+				std::copy(buffer + aFirstID, buffer + aFirstID + aNumberOfValues, aValues);
+			}
+
+			void ITKImageAccessor::gatherValuesUnchecked(const VoxelGridID* aSortedIDs, const size_t aNumberOfIDs,
+			        GenericValueType* aValues) const
+			{
+				const GenericValueType* buffer = getContiguousBuffer();
+
+				if (buffer == nullptr)
+				{
+					core::AccessorWithGeoInfoBase::gatherValuesUnchecked(aSortedIDs, aNumberOfIDs, aValues);
+					return;
+				}
+
+				for (size_t i = 0; i < aNumberOfIDs; ++i)
+				{
+					aValues[i] = buffer[aSortedIDs[i]];
+				}
+			}
+
 			void ITKImageAccessor::assembleGeometricInfo()
 			{
 				_geoInfo.setSpacing(SpacingVectorType3D(_data->GetSpacing()[0], _data->GetSpacing()[1],
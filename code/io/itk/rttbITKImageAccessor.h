@@ -76,6 +76,20 @@ namespace rttb
 					return _UID;
 				};
 
+			protected:
+				/*! @brief copies from the pixel buffer if the whole image is buffered*/
+				void getValuesUnchecked(const VoxelGridID aFirstID, const size_t aNumberOfValues,
+				                        GenericValueType* aValues) const override;
+
+				/*! @brief copies from the pixel buffer if the whole image is buffered*/
+				void gatherValuesUnchecked(const VoxelGridID* aSortedIDs, const size_t aNumberOfIDs,
+				                           GenericValueType* aValues) const override;
+
+			private:
+				/*! @brief Returns the buffer position of the voxel with the ID 0, if the IDs are the offsets in the pixel buffer
+				(i.e. the whole image is buffered). Otherwise nullptr.*/
+				const GenericValueType* getContiguousBuffer() const;
+
 			};
 		}
 	}
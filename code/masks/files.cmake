@@ -1,15 +1,30 @@
 SET(CPP_FILES
 	rttbGenericMutableMaskAccessor.cpp
+	rttbMaskVoxelIndex.cpp
 	rttbBoostMask.cpp
 	rttbBoostMaskAccessor.cpp
 	rttbBoostMaskGenerateMaskVoxelListThread.cpp	
 	rttbBoostMaskVoxelizationThread.cpp
+	rttbBoostMaskScanlineVoxelizationThread.cpp
+	rttbBoostMaskVoxelizationPlane.cpp
+	rttbMonotonicArena.cpp
+	rttbBoostMaskWorkQueue.cpp
+	rttbBoostMaskGeometry.cpp
+	rttbBoostMaskSetGenerator.cpp
 )
 
 SET(H_FILES
 	rttbGenericMutableMaskAccessor.h
+	rttbMaskVoxelIndex.h
 	rttbBoostMask.h
 	rttbBoostMaskAccessor.h
 	rttbBoostMaskGenerateMaskVoxelListThread.h
 	rttbBoostMaskVoxelizationThread.h
+	rttbBoostMaskScanlineVoxelizationThread.h
+	rttbBoostMaskVoxelizationMethod.h
+	rttbBoostMaskVoxelizationPlane.h
+	rttbMonotonicArena.h
+	rttbBoostMaskWorkQueue.h
+	rttbBoostMaskGeometry.h
+	rttbBoostMaskSetGenerator.h
 )
@@ -13,8 +13,10 @@
 //
 //------------------------------------------------------------------------
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
-#include <thread>
+#include <utility>
 
 #include <boost/geometry/geometries/register/point.hpp>
 #include <boost/geometry/geometries/register/ring.hpp>
@@ -23,8 +25,11 @@
 #include "rttbBoostMask.h"
 #include "rttbNullPointerException.h"
 #include "rttbInvalidParameterException.h"
+#include "rttbThreadPool.h"
 #include "rttbBoostMaskGenerateMaskVoxelListThread.h"
 #include "rttbBoostMaskVoxelizationThread.h"
+#include "rttbBoostMaskScanlineVoxelizationThread.h"
+#include "rttbBoostMaskWorkQueue.h"
 
 namespace rttb
 {
@@ -35,12 +40,35 @@ namespace rttb
 
 
 			BoostMask::BoostMask(core::GeometricInfo::Pointer aDoseGeoInfo,
-        core::Structure::Pointer aStructure, bool strict, unsigned int numberOfThreads)
+        core::Structure::Pointer aStructure, bool strict, unsigned int numberOfThreads,
+        VoxelizationMethod::Type voxelizationMethod)
 				: _geometricInfo(aDoseGeoInfo), _structure(aStructure),
-                _strict(strict), _numberOfThreads(numberOfThreads), _voxelizationThickness(0.0),
+                _strict(strict), _numberOfThreads(numberOfThreads), _voxelizationMethod(voxelizationMethod),
+                _voxelizationThickness(0.0),
 				  _voxelInStructure(::boost::make_shared<MaskVoxelList>())
 			{
+				checkParameters();
+				_geometry = ::boost::make_shared<BoostMaskGeometry>(*_geometricInfo);
+			}
+
+			BoostMask::BoostMask(BoostMaskGeometry::Pointer aGeometry,
+        core::Structure::Pointer aStructure, bool strict, unsigned int numberOfThreads,
+        VoxelizationMethod::Type voxelizationMethod)
+				: _geometry(aGeometry), _structure(aStructure),
+                _strict(strict), _numberOfThreads(numberOfThreads), _voxelizationMethod(voxelizationMethod),
+                _voxelizationThickness(0.0),
+				  _voxelInStructure(::boost::make_shared<MaskVoxelList>())
+			{
+				if (_geometry != nullptr)
+				{
+					_geometricInfo = _geometry->getGeometricInfo();
+				}
+
+				checkParameters();
+			}
 
+			void BoostMask::checkParameters()
+			{
 				_isUpToDate = false;
 
 				if (_geometricInfo == nullptr)
@@ -54,13 +82,8 @@ namespace rttb
 
 				if (_numberOfThreads == 0)
 				{
-					_numberOfThreads = std::thread::hardware_concurrency();
-                    if (_numberOfThreads == 0)
-                    {
-                        throw rttb::core::InvalidParameterException("Error: detection of the number of hardware threads is not possible. Please specify number of threads for voxelization explicitly as parameter in BoostMask.");
-                    }
+					_numberOfThreads = core::ThreadPool::getInstance().getConcurrency();
 				}
-
 			}
 
 			BoostMask::MaskVoxelListPointer BoostMask::getRelevantVoxelVector()
@@ -83,11 +106,11 @@ namespace rttb
 
 			void BoostMask::preprocessing()
 			{
-				rttb::PolygonSequenceType polygonSequence = _structure->getStructureVector();
+				const rttb::PolygonSequenceType& polygonSequence = _structure->getStructureVector();
 
 				//Convert world coordinate polygons to the polygons with geometry coordinate
 				rttb::PolygonSequenceType geometryCoordinatePolygonVector;
-				rttb::PolygonSequenceType::iterator it;
+				rttb::PolygonSequenceType::const_iterator it;
 				rttb::ContinuousVoxelGridIndex3D globalMaxGridIndex(std::numeric_limits<double>::min(),
 				        std::numeric_limits<double>::min(), std::numeric_limits<double>::min());
 				rttb::ContinuousVoxelGridIndex3D globalMinGridIndex(_geometricInfo->getNumColumns(),
@@ -95,8 +118,9 @@ namespace rttb
 
 				for (it = polygonSequence.begin(); it != polygonSequence.end(); ++it)
 				{
-					PolygonType rttbPolygon = *it;
+					const PolygonType& rttbPolygon = *it;
 					PolygonType geometryCoordinatePolygon;
+					geometryCoordinatePolygon.reserve(rttbPolygon.size());
 
 					//1. convert polygon to geometry coordinate polygons
 					//2. calculate global min/max
@@ -131,57 +155,69 @@ namespace rttb
 					throw rttb::core::InvalidParameterException("Bounding box calculation failed! ");
 				}
 
-				BoostRingMap::iterator itMap;
-
-				size_t mapSizeInAThread = _ringMap.size() / _numberOfThreads;
-				unsigned int count = 0;
-				unsigned int countThread = 0;
-				BoostPolygonMap polygonMap;
-				std::vector<BoostPolygonMap> polygonMapVector;
+				//check donut and convert to a vector of z index and a vector of boost polygon 2d (with or without holes)
+				auto planeVector = ::boost::make_shared<std::vector<BoostPolygonPlane> >();
 
-				//check donut and convert to a map of z index and a vector of boost polygon 2d (with or without holes)
-				for (itMap = _ringMap.begin(); itMap != _ringMap.end(); ++itMap)
+				for (const auto& ringPlane : _ringMap)
 				{
 					//the vector of all boost 2d polygons with the same z grid index(donut polygon is accepted).
-					BoostPolygonVector polygonVector = checkDonutAndConvert((*itMap).second);
+					planeVector->push_back(BoostPolygonPlane(ringPlane.first, checkDonutAndConvert(ringPlane.second)));
+				}
 
-					if (count == mapSizeInAThread && countThread < (_numberOfThreads - 1))
+				//the planes with the longest contours are the most expensive ones, they are processed first so that
+				//the cheap planes at the end of the queue balance the load of the threads
+				std::vector<std::pair<double, size_t> > planeCosts;
+
+				for (size_t i = 0; i < planeVector->size(); ++i)
+				{
+					double perimeter = 0;
+
+					for (const auto& polygon : (*planeVector)[i].second)
 					{
-						polygonMapVector.push_back(polygonMap);
-						polygonMap.clear();
-						count = 0;
-						countThread++;
+						perimeter += ::boost::geometry::perimeter(polygon);
 					}
 
-					polygonMap.insert(std::pair<double, BoostPolygonVector>((*itMap).first,
-					                  polygonVector));
-					count++;
-
+					planeCosts.push_back(std::make_pair(perimeter, i));
 				}
 
-                _voxelizationMap = ::boost::make_shared<std::map<double, BoostArray2DPointer> >();
+				std::sort(planeCosts.begin(), planeCosts.end(), [](const std::pair<double, size_t>& a,
+				          const std::pair<double, size_t>& b)
+				{
+					return a.first > b.first;
+				});
+
+				auto sortedPlaneVector = ::boost::make_shared<std::vector<BoostPolygonPlane> >();
 
-				polygonMapVector.push_back(polygonMap); //insert the last one
+				for (const auto& planeCost : planeCosts)
+				{
+					sortedPlaneVector->push_back(std::move((*planeVector)[planeCost.second]));
+				}
+
+                _voxelizationMap = ::boost::make_shared<std::map<double, VoxelizationPlanePointer> >();
 
-				//generate voxelization map, multi-threading
-				std::vector<std::thread> threads;
+				//generate voxelization map, multi-threading on the thread pool of the library
+				core::TaskGroup tasks;
 
         auto aMutex = ::boost::make_shared<std::mutex>();
+        auto planeQueue = ::boost::make_shared<WorkQueue>(0, sortedPlaneVector->size());
 
-				for (const auto & i : polygonMapVector)
+				for (unsigned int i = 0; i < getNumberOfThreadsForItems(sortedPlaneVector->size()); ++i)
 				{
-          BoostMaskVoxelizationThread t(i, _globalBoundingBox,
+					if (_voxelizationMethod == VoxelizationMethod::Scanline)
+					{
+						BoostMaskScanlineVoxelizationThread t(sortedPlaneVector, planeQueue, _globalBoundingBox,
+						                                      _voxelizationMap, aMutex, _strict);
+						tasks.run(t);
+					}
+					else
+					{
+          BoostMaskVoxelizationThread t(sortedPlaneVector, planeQueue, _globalBoundingBox,
             _voxelizationMap, aMutex, _strict);
-					threads.emplace_back(t);
+					tasks.run(t);
+					}
 				}
 
-        for (auto& thread : threads)
-        {
-          if (thread.joinable())
-          {
-            thread.join();
-          }
-        }
+        tasks.wait();
 			}
 
 			void BoostMask::generateMaskVoxelList()
@@ -199,45 +235,46 @@ namespace rttb
 
 
 
-        std::vector<std::thread> threads;
+        core::TaskGroup tasks;
         auto aMutex = ::boost::make_shared<std::mutex>();
 
-				unsigned int sliceNumberInAThread = _geometricInfo->getNumSlices() / _numberOfThreads;
+				//only the slices in the z range of the voxelization planes can contain mask voxels
+				size_t beginSlice = 0;
+				size_t endSlice = 0;
 
-				//generate mask voxel list, multi-threading
-				for (unsigned int i = 0; i < _numberOfThreads; ++i)
+				if (!_voxelizationMap->empty())
 				{
-					unsigned int beginSlice = i * sliceNumberInAThread;
-					unsigned int endSlice;
+					const double minZ = _voxelizationMap->cbegin()->first - 0.5 * _voxelizationThickness - 0.5;
+					const double maxZ = _voxelizationMap->crbegin()->first + 0.5 * _voxelizationThickness + 0.5;
+					const double numberOfSlices = _geometricInfo->getNumSlices();
 
-					if (i < _numberOfThreads - 1)
-					{
-						endSlice = (i + 1) * sliceNumberInAThread;
-					}
-					else
-					{
-						endSlice = _geometricInfo->getNumSlices();
-					}
+					beginSlice = static_cast<size_t>(std::min(numberOfSlices, std::max(0.0, std::floor(minZ))));
+					endSlice = static_cast<size_t>(std::min(numberOfSlices, std::max(0.0, std::ceil(maxZ) + 1)));
+					endSlice = std::max(beginSlice, endSlice);
+				}
 
+				auto sliceQueue = ::boost::make_shared<WorkQueue>(beginSlice, endSlice);
 
+				//generate mask voxel list, multi-threading on the thread pool of the library
+				for (unsigned int i = 0; i < getNumberOfThreadsForItems(endSlice - beginSlice); ++i)
+				{
 					BoostMaskGenerateMaskVoxelListThread t(_globalBoundingBox, _geometricInfo, _voxelizationMap,
-					                                       _voxelizationThickness, beginSlice, endSlice,
+					                                       _voxelizationThickness, sliceQueue,
 					                                       _voxelInStructure, _strict, aMutex);
 
-          threads.emplace_back(t);
+          tasks.run(t);
 
 				}
 
-        for (auto& thread : threads)
-        {
-          if (thread.joinable())
-          {
-            thread.join();
-          }
-        }
+        tasks.wait();
 
 			}
 
+			unsigned int BoostMask::getNumberOfThreadsForItems(size_t numberOfItems) const
+			{
+				return static_cast<unsigned int>(std::min(static_cast<size_t>(_numberOfThreads), numberOfItems));
+			}
+
 			bool BoostMask::preprocessingPolygon(const rttb::PolygonType& aRTTBPolygon,
 			                                     rttb::PolygonType& geometryCoordinatePolygon, rttb::ContinuousVoxelGridIndex3D& minimum,
 			                                     rttb::ContinuousVoxelGridIndex3D& maximum, double aErrorConstant) const
@@ -246,11 +283,12 @@ namespace rttb
 				double minZ = _geometricInfo->getNumSlices();
 				double maxZ =  0.0;
 
-				for (auto worldCoordinatePoint : aRTTBPolygon)
+				rttb::ContinuousVoxelGridIndex3D geometryCoordinatePoint;
+
+				for (const auto& worldCoordinatePoint : aRTTBPolygon)
 				{
 						//convert to geometry coordinate polygon
-					rttb::ContinuousVoxelGridIndex3D geometryCoordinatePoint;
-					_geometricInfo->worldCoordinateToContinuousIndex(worldCoordinatePoint, geometryCoordinatePoint);
+					_geometry->worldCoordinateToContinuousIndex(worldCoordinatePoint, geometryCoordinatePoint);
 
 					geometryCoordinatePolygon.push_back(geometryCoordinatePoint);
 
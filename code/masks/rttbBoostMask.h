@@ -20,11 +20,13 @@
 #include "rttbStructure.h"
 #include "rttbGeometricInfo.h"
 #include "rttbMaskAccessorInterface.h"
+#include "rttbBoostMaskVoxelizationMethod.h"
+#include "rttbBoostMaskVoxelizationPlane.h"
+#include "rttbBoostMaskGeometry.h"
 
 #include <boost/geometry.hpp>
 #include <boost/geometry/geometries/point_xy.hpp>
 #include <boost/shared_ptr.hpp>
-#include <boost/multi_array.hpp>
 
 namespace rttb
 {
@@ -52,11 +54,21 @@ namespace rttb
                 * @param aDoseGeoInfo the GeometricInfo
                 * @param aStructure the structure set
 				* @param strict indicates whether to allow self intersection in the structure. If it is set to true, an exception will be thrown when the given structure has self intersection.
-				* @param numberOfThreads number of threads used for voxelization. default value 0 means automatic detection, using the number of Hardware thread/cores
+				* @param numberOfThreads maximal number of threads used for voxelization (never more threads than contour planes or slices are started). default value 0 means the concurrency of the thread pool of the library (see core::ThreadPool)
+				* @param voxelizationMethod algorithm used to compute the voxelization planes of the contours (see VoxelizationMethod)
 				* @exception InvalidParameterException thrown if strict is true and the structure has self intersections
 				*/
 				BoostMask(core::GeometricInfo::Pointer aDoseGeoInfo, core::Structure::Pointer aStructure,
-				          bool strict = true, unsigned int numberOfThreads = 0);
+				          bool strict = true, unsigned int numberOfThreads = 0,
+				          VoxelizationMethod::Type voxelizationMethod = VoxelizationMethod::BoostGeometry);
+
+				/*! @brief Constructor with a prepared reference geometry, which can be shared by the masks of several structures
+				* @exception rttb::core::NullPointerException thrown if aGeometry or aStructure is nullptr
+				* @see BoostMask(core::GeometricInfo::Pointer, core::Structure::Pointer, bool, unsigned int, VoxelizationMethod::Type)
+				*/
+				BoostMask(BoostMaskGeometry::Pointer aGeometry, core::Structure::Pointer aStructure,
+				          bool strict = true, unsigned int numberOfThreads = 0,
+				          VoxelizationMethod::Type voxelizationMethod = VoxelizationMethod::BoostGeometry);
 
 				/*! @brief Generate mask and return the voxels in the mask
 				* @exception rttb::core::InvalidParameterException thrown if the structure has self intersections
@@ -70,13 +82,11 @@ namespace rttb
 				using BoostRingVector = std::vector<BoostRing2D>;//polygon without holes
 				using BoostPolygonVector = std::vector<BoostPolygon2D>;//polygon with or without holes
 				using VoxelIndexVector = std::vector<rttb::VoxelGridIndex3D>;
-				typedef std::map<double, BoostPolygonVector>
-				BoostPolygonMap;//map of the z index with the vector of boost 2d polygon
+				using BoostPolygonPlane = std::pair<double, BoostPolygonVector>;//z index with the vector of boost 2d polygon
 				typedef std::map<double, BoostRingVector>
 				BoostRingMap;//map of the z index with the vector of boost 2d ring
-				typedef ::boost::multi_array<double, 2> BoostArray2D;
-                using BoostArray2DPointer = ::boost::shared_ptr<BoostArray2D>;
-                typedef ::boost::shared_ptr<std::map<double, BoostArray2DPointer> > BoostArrayMapPointer;
+
+        BoostMaskGeometry::Pointer _geometry;
 
         core::GeometricInfo::Pointer _geometricInfo;
 
@@ -88,6 +98,10 @@ namespace rttb
         */
         unsigned int _numberOfThreads;
 
+        /*! @brief The algorithm used to compute the voxelization planes
+        */
+        VoxelizationMethod::Type _voxelizationMethod;
+
         //@brief The thickness of the voxelization plane (the contour plane), in double dose grid index
         //@details for example, the first contour has the double grid index 0.1, the second 0.3, the third 0.5, then the thickness is 0.2
         double _voxelizationThickness;
@@ -109,10 +123,10 @@ namespace rttb
 
 				/*! @brief The voxelization map
 				*	@details key: the converted double z grid index of a contour plane
-				*	value: the 2d mask, array[i][j] = the mask value of the position (i,j) in the global bounding box,
+				*	value: the sparse 2d mask, getValue(i,j) = the mask value of the position (i,j) in the global bounding box,
 				*			i: 0 - (_globalBoundingBoxSize0-1), j: 0 - (_globalBoundingBoxSize1-1)
 				*/
-                BoostArrayMapPointer _voxelizationMap;
+                VoxelizationPlaneMapPointer _voxelizationMap;
 
 				/*! @brief If the mask is up to date
 				*/
@@ -134,8 +148,9 @@ namespace rttb
 
 				/*! @brief The voxelization step, which computes the voxelization planes (in x/y) for all contours of an struct.
 
-				*	@details For each contour (that is in the z-Range of the reference geometry) of the struct:
-				*	1) Allocate result array (voxelization plane) based on the bounding box (see Preprocessing Step 3)
+				*	@details For each contour (that is in the z-Range of the reference geometry) of the struct (the contour planes are distributed dynamically
+				*	to the threads, the planes with the longest contours first):
+				*	1) Allocate result array (voxelization plane) based on the bounding box of the contour (within the bounding box of Preprocessing Step 3)
 				*	2) Generate voxelization plane for the contour (based on the x-y-raster of the reference geometry).
 				*	3) Add result Array (key is the z-Value of the contour)
 				*/
@@ -143,7 +158,7 @@ namespace rttb
 
 				/*! @brief mask voxel Generation step which transfers the voxelization planes into the (z-)geometry of the reference geometry.
 				*	@details It consists of following Sub steps :
-				*	For all "slices" in the reference geometry :
+				*	For all "slices" in the reference geometry (within the z range of the contours, distributed dynamically to the threads):
 				*	1) generate weight vector for all voxelization planes for a given z - value of a slice
 				*		Iterate over the bounding box of a struct.For each voxel :
 				*	2) Compute weighted sum of all voxelization planes(use weight vector, step 1)
@@ -152,6 +167,11 @@ namespace rttb
 				*/
 				void generateMaskVoxelList();
 
+				/*! @brief The number of threads to start for the given number of work items (contour planes or slices)
+				*	@details At most _numberOfThreads, but not more threads than items.
+				*/
+				unsigned int getNumberOfThreadsForItems(size_t numberOfItems) const;
+
 				/*! @brief Convert the rttb polygon with world coordinate to the rttb polygon with double geometry coordinate, calculate the current min/max
 				*			and check if the polygon is planar
 				*	@param minimum the current global minimum
@@ -169,6 +189,9 @@ namespace rttb
 				BoostRingMap convertRTTBPolygonSequenceToBoostRingMap(const rttb::PolygonSequenceType&
 				        aRTTBPolygonVector) const;
 
+				/*! @brief Checks the parameters of the constructors*/
+				void checkParameters();
+
 				/*! @brief Find the key with error constant to aIndex
 				*	@pre aBoostRingMap should not be empty
 				*	@return Return aBoostRingMap.end() if the key is not found
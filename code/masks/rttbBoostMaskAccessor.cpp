@@ -15,6 +15,7 @@
 
 #include "rttbBoostMaskAccessor.h"
 #include "rttbBoostMask.h"
+#include "rttbNullPointerException.h"
 
 #include <boost/make_shared.hpp>
 
@@ -30,10 +31,38 @@ namespace rttb
 		{
 
 			BoostMaskAccessor::BoostMaskAccessor(StructTypePointer aStructurePointer,
-			                                     const core::GeometricInfo& aGeometricInfo, bool strict)
-				: _spStructure(aStructurePointer), _geoInfo(aGeometricInfo), _strict(strict)
+			                                     const core::GeometricInfo& aGeometricInfo, bool strict,
+			                                     VoxelizationMethod::Type voxelizationMethod, unsigned int numberOfThreads)
+				: _spStructure(aStructurePointer), _geoInfo(aGeometricInfo), _strict(strict),
+				  _voxelizationMethod(voxelizationMethod), _numberOfThreads(numberOfThreads), _isMaskUpdated(false)
+			{
+				_geometry = ::boost::make_shared<BoostMaskGeometry>(_geoInfo);
+				_voxelIndex = MaskVoxelIndex(_geoInfo);
+				initializeUID();
+			}
+
+			BoostMaskAccessor::BoostMaskAccessor(StructTypePointer aStructurePointer,
+			                                     BoostMaskGeometry::Pointer aGeometry, bool strict,
+			                                     VoxelizationMethod::Type voxelizationMethod, unsigned int numberOfThreads)
+				: _spStructure(aStructurePointer), _geometry(aGeometry), _strict(strict),
+				  _voxelizationMethod(voxelizationMethod), _numberOfThreads(numberOfThreads), _isMaskUpdated(false)
+			{
+				if (_geometry == nullptr)
+				{
+					throw core::NullPointerException("Error: Geometry is nullptr!");
+				}
+
+				_geoInfo = *(_geometry->getGeometricInfo());
+				_voxelIndex = MaskVoxelIndex(_geoInfo);
+				initializeUID();
+			}
+
+			void BoostMaskAccessor::initializeUID()
 			{
 				_spRelevantVoxelVector = MaskVoxelListPointer();
+				_spCompactVoxelList = CompactMaskVoxelListPointer();
+				_isMaskUpdated = false;
+				_voxelIndex.reset();
 
 				//generate new structure set uid
 				::boost::uuids::uuid id;
@@ -50,17 +79,23 @@ namespace rttb
 
 			void BoostMaskAccessor::updateMask()
 			{
-				MaskVoxelList newRelevantVoxelVector;
+				if (_isMaskUpdated.load(std::memory_order_acquire))
+				{
+					return; // already calculated
+				}
+
+				std::lock_guard<std::mutex> lock(_updateMutex);
 
 				if (_spRelevantVoxelVector)
 				{
-					return; // already calculated
+					return; // calculated by another thread meanwhile
 				}
 
-				BoostMask mask(::boost::make_shared<core::GeometricInfo>(_geoInfo),
-				               _spStructure, _strict);
+				BoostMask mask(_geometry, _spStructure, _strict, _numberOfThreads, _voxelizationMethod);
 
 				_spRelevantVoxelVector = mask.getRelevantVoxelVector();
+				_voxelIndex.reset();
+				_isMaskUpdated.store(true, std::memory_order_release);
 			}
 
 			BoostMaskAccessor::MaskVoxelListPointer BoostMaskAccessor::getRelevantVoxelVector()
@@ -70,6 +105,20 @@ namespace rttb
 				return _spRelevantVoxelVector;
 			}
 
+			BoostMaskAccessor::CompactMaskVoxelListPointer BoostMaskAccessor::getCompactRelevantVoxelList()
+			{
+				updateMask();
+
+				std::lock_guard<std::mutex> lock(_updateMutex);
+
+				if (!_spCompactVoxelList)
+				{
+					_spCompactVoxelList = ::boost::make_shared<core::CompactMaskVoxelList>(*_spRelevantVoxelVector);
+				}
+
+				return _spCompactVoxelList;
+			}
+
 			BoostMaskAccessor::MaskVoxelListPointer BoostMaskAccessor::getRelevantVoxelVector(
 			    float lowerThreshold)
 			{
@@ -104,21 +153,15 @@ namespace rttb
 				}
 
 				//determine how a given voxel on the dose grid is masked
-				if (_spRelevantVoxelVector)
+				if (_isMaskUpdated.load(std::memory_order_acquire))
 				{
-					auto it = _spRelevantVoxelVector->begin();
+					const size_t position = _voxelIndex.find(*_spRelevantVoxelVector, aID);
 
-					while (it != _spRelevantVoxelVector->end())
+					if (position != MaskVoxelIndex::notFound)
 					{
-						if ((*it).getVoxelGridID() == aID)
-						{
-							voxel = (*it);
-							return true;
-						}
-
-						++it;
+						voxel = (*_spRelevantVoxelVector)[position];
+						return true;
 					}
-
 				}
 				// returns false if mask was not calculated without triggering calculation (otherwise not const!)
 				else
@@ -16,10 +16,16 @@
 #ifndef __BOOST_MASK_R_ACCESSOR__H
 #define __BOOST_MASK_R_ACCESSOR__H
 
+#include <atomic>
+#include <mutex>
+
 #include "rttbBaseType.h"
 #include "rttbGeometricInfo.h"
 #include "rttbMaskAccessorInterface.h"
 #include "rttbStructure.h"
+#include "rttbBoostMaskVoxelizationMethod.h"
+#include "rttbBoostMaskGeometry.h"
+#include "rttbMaskVoxelIndex.h"
 
 #include "RTTBMaskExports.h"
 
@@ -36,25 +42,45 @@ namespace rttb
 			*   the polygons on the same slice have no intersection between each other, unless the case of a donut. A donut is accepted.)
 			*   If "strict" is set to false, debug information will be displayed when the given structure has self intersection. Self intersections will be ignored
 			*   and the mask will be calculated, however, it may cause errors in the mask results.
+			*   The mask is calculated once, by the first call of updateMask() (or of a function calling it). This is thread-safe:
+			*   concurrent callers wait for the calculation.
 			*/
             class RTTBMask_EXPORT BoostMaskAccessor : public core::MaskAccessorInterface
 			{
 			public:
 				using MaskVoxelList = core::MaskAccessorInterface::MaskVoxelList;
 				using MaskVoxelListPointer = core::MaskAccessorInterface::MaskVoxelListPointer;
+				using CompactMaskVoxelListPointer = core::MaskAccessorInterface::CompactMaskVoxelListPointer;
 
 				using StructTypePointer = core::Structure::Pointer;
 
 			private:
         StructTypePointer _spStructure;
 				core::GeometricInfo _geoInfo;
+				BoostMaskGeometry::Pointer _geometry;
         bool _strict;
+        VoxelizationMethod::Type _voxelizationMethod;
+        unsigned int _numberOfThreads;
 
 				/*! vector containing list of mask voxels*/
 				MaskVoxelListPointer _spRelevantVoxelVector;
 
+				/*! random access to _spRelevantVoxelVector for getMaskAt()*/
+				MaskVoxelIndex _voxelIndex;
+
+				/*! _spRelevantVoxelVector as compact list, converted by the first getCompactRelevantVoxelList()*/
+				CompactMaskVoxelListPointer _spCompactVoxelList;
+
+				/*! guards the calculation of _spRelevantVoxelVector and _spCompactVoxelList*/
+				std::mutex _updateMutex;
+				/*! true as soon as _spRelevantVoxelVector is calculated, it is not changed afterwards*/
+				std::atomic<bool> _isMaskUpdated;
+
 				IDType _maskUID;
 
+				/*! @brief Resets the mask and generates a new mask UID*/
+				void initializeUID();
+
 			public:
 
 
@@ -62,15 +88,28 @@ namespace rttb
 				* @param aStructurePointer smart pointer of the structure
 				* @param aGeometricInfo smart pointer of the geometricInfo of the dose
 				* @param strict indicates whether to allow self intersection in the structure. If it is set to true, an exception will be thrown when the given structure has self intersection.
+				* @param voxelizationMethod algorithm used by BoostMask to compute the voxelization planes (see VoxelizationMethod)
+				* @param numberOfThreads maximal number of threads used by BoostMask. Default value 0 means the concurrency of the thread pool of the library (see core::ThreadPool).
+				* Pass a smaller budget if several masks are computed concurrently.
 				* @exception InvalidParameterException thrown if strict is true and the structure has self intersections
 				*/
 				BoostMaskAccessor(StructTypePointer aStructurePointer, const core::GeometricInfo& aGeometricInfo,
-				                  bool strict = true);
+				                  bool strict = true, VoxelizationMethod::Type voxelizationMethod = VoxelizationMethod::BoostGeometry,
+				                  unsigned int numberOfThreads = 0);
+
+				/*! @brief Constructor with a structure pointer and a prepared reference geometry, which can be shared by the
+				* accessors of several structures (see BoostMaskSetGenerator)
+				* @exception NullPointerException thrown if aGeometry is nullptr
+				* @see BoostMaskAccessor(StructTypePointer, const core::GeometricInfo&, bool, VoxelizationMethod::Type, unsigned int)
+				*/
+				BoostMaskAccessor(StructTypePointer aStructurePointer, BoostMaskGeometry::Pointer aGeometry,
+				                  bool strict = true, VoxelizationMethod::Type voxelizationMethod = VoxelizationMethod::BoostGeometry,
+				                  unsigned int numberOfThreads = 0);
 
 				/*! @brief destructor*/
 				~BoostMaskAccessor() override;
 
-				/*! @brief voxelization of the given structures using boost algorithms*/
+				/*! @brief voxelization of the given structures using boost algorithms (only once, thread-safe)*/
 				void updateMask() override;
 
 				/*! @brief get vector containing all relevant voxels that are inside the given structure*/
@@ -79,6 +118,9 @@ namespace rttb
 				/*! @brief get vector containing all relevant voxels that have a relevant volume above the given threshold and are inside the given structure*/
 				MaskVoxelListPointer getRelevantVoxelVector(float lowerThreshold) override;
 
+				/*! @brief get the relevant voxels as compact list sorted by ID. The list is converted only once.*/
+				CompactMaskVoxelListPointer getCompactRelevantVoxelList() override;
+
 				/*!@brief determine how a given voxel on the dose grid is masked
 				* @param aID ID of the voxel in grid.
 				* @param voxel Reference to the voxel.
@@ -18,6 +18,9 @@
 
 #include "rttbInvalidParameterException.h"
 
+#include <algorithm>
+#include <limits>
+
 namespace rttb
 {
 	namespace masks
@@ -27,60 +30,71 @@ namespace rttb
 			BoostMaskGenerateMaskVoxelListThread::BoostMaskGenerateMaskVoxelListThread(
 			    const VoxelIndexVector& aGlobalBoundingBox,
         core::GeometricInfo::Pointer aGeometricInfo,
-                BoostArrayMapPointer aVoxelizationMap,
+                VoxelizationPlaneMapPointer aVoxelizationMap,
 			    double aVoxelizationThickness,
-			    unsigned int aBeginSlice,
-			    unsigned int aEndSlice,
+			    WorkQueuePointer aSliceQueue,
                 MaskVoxelListPointer aMaskVoxelList,
         bool strictVoxelization,
                 ::boost::shared_ptr<std::mutex> aMutex) :
 				_globalBoundingBox(aGlobalBoundingBox), _geometricInfo(aGeometricInfo),
 				_voxelizationMap(aVoxelizationMap), _voxelizationThickness(aVoxelizationThickness),
-				_beginSlice(aBeginSlice), _endSlice(aEndSlice),
+				_sliceQueue(aSliceQueue),
                 _resultMaskVoxelList(aMaskVoxelList), _strictVoxelization(strictVoxelization), _mutex(aMutex)
 			{}
 
 			void BoostMaskGenerateMaskVoxelListThread::operator()()
 			{
 				rttb::VoxelGridIndex3D minIndex = _globalBoundingBox.at(0);
-				rttb::VoxelGridIndex3D maxIndex = _globalBoundingBox.at(1);
-				unsigned int globalBoundingBoxSize0 = maxIndex[0] - minIndex[0] + 1;
-				unsigned int globalBoundingBoxSize1 = maxIndex[1] - minIndex[1] + 1;
 
                 std::vector<core::MaskVoxel> maskVoxelsInThread;
+                std::vector<WeightedPlane> weightVectorForZ;
+
+				//take the slices from the queue shared with the other mask generation threads
+				size_t sliceIndex;
 
-				for (unsigned int indexZ = _beginSlice; indexZ < _endSlice; ++indexZ)
+				while (_sliceQueue->getNextItem(sliceIndex))
 				{
+					const auto indexZ = static_cast<unsigned int>(sliceIndex);
+
 					//calculate weight vector
-					std::map<double, double> weightVectorForZ;
 					calcWeightVector(indexZ, weightVectorForZ);
 
-					//For each x,y, calc sum of all voxelization plane, use weight vector
-					for (unsigned int x = 0; x < globalBoundingBoxSize0; ++x)
+					//slice outside of the structure
+					if (weightVectorForZ.empty())
+					{
+						continue;
+					}
+
+					//only the union of the regions of the contributing planes can have values > 0
+					unsigned int regionBegin0 = std::numeric_limits<unsigned int>::max();
+					unsigned int regionBegin1 = std::numeric_limits<unsigned int>::max();
+					unsigned int regionEnd0 = 0;
+					unsigned int regionEnd1 = 0;
+
+					for (const auto& weightedPlane : weightVectorForZ)
 					{
-						for (unsigned int y = 0; y < globalBoundingBoxSize1; ++y)
+						const VoxelizationPlane* plane = weightedPlane.first;
+
+						if (plane->getRegionSize0() > 0 && plane->getRegionSize1() > 0)
 						{
-							rttb::VoxelGridIndex3D currentIndex;
-							currentIndex[0] = x + minIndex[0];
-							currentIndex[1] = y + minIndex[1];
-							currentIndex[2] = indexZ;
-							rttb::VoxelGridID gridID;
-							_geometricInfo->convert(currentIndex, gridID);
-							double volumeFraction = 0;
+							regionBegin0 = std::min(regionBegin0, plane->getRegionBegin0());
+							regionBegin1 = std::min(regionBegin1, plane->getRegionBegin1());
+							regionEnd0 = std::max(regionEnd0, plane->getRegionBegin0() + plane->getRegionSize0());
+							regionEnd1 = std::max(regionEnd1, plane->getRegionBegin1() + plane->getRegionSize1());
+						}
+					}
 
-                            auto it = weightVectorForZ.cbegin();
-                            auto itMap = _voxelizationMap->cbegin();
+					//For each x,y, calc sum of the contributing voxelization planes, use weight vector
+					for (unsigned int x = regionBegin0; x < regionEnd0; ++x)
+					{
+						for (unsigned int y = regionBegin1; y < regionEnd1; ++y)
+						{
+							double volumeFraction = 0;
 
-							for (; it != weightVectorForZ.cend()
-							     && itMap != _voxelizationMap->cend(); ++it, ++itMap)
+							for (const auto& weightedPlane : weightVectorForZ)
 							{
-								double weight = it->second;
-                                if (weight > 0){
-                                    BoostArray2DPointer voxelizationArray = itMap->second;
-				
-                                    //calc sum of all voxelization plane, use weight
-                                    volumeFraction += (*voxelizationArray)[x][y] * weight;
-                                }
+								//calc sum of all voxelization plane, use weight
+								volumeFraction += weightedPlane.first->getValue(x, y) * weightedPlane.second;
 							}
 
 							if (volumeFraction > 1 && ((volumeFraction - 1) <= errorConstant || !_strictVoxelization))
@@ -95,6 +109,13 @@ namespace rttb
 							//insert mask voxel if volumeFraction > 0
 							if (volumeFraction > 0)
 							{
+								rttb::VoxelGridIndex3D currentIndex;
+								currentIndex[0] = x + minIndex[0];
+								currentIndex[1] = y + minIndex[1];
+								currentIndex[2] = indexZ;
+								rttb::VoxelGridID gridID;
+								_geometricInfo->convert(currentIndex, gridID);
+
 								core::MaskVoxel maskVoxelPtr = core::MaskVoxel(gridID, volumeFraction);
                                 maskVoxelsInThread.push_back(maskVoxelPtr);
 							}
@@ -108,17 +129,28 @@ namespace rttb
 			}
 
 			void BoostMaskGenerateMaskVoxelListThread::calcWeightVector(const rttb::VoxelGridID& aIndexZ,
-			        std::map<double, double>& weightVector) const
+			        std::vector<WeightedPlane>& weightVector) const
 			{
 				double indexZMin = aIndexZ - 0.5;
 				double indexZMax = aIndexZ + 0.5;
 
-                for (auto & it : *_voxelizationMap)
+				weightVector.clear();
+
+				//planes ending below the slice do not contribute (the tolerance keeps planes ending exactly at the slice border for the exact check below)
+				auto it = _voxelizationMap->lower_bound(indexZMin - 0.5 * _voxelizationThickness - errorConstant);
+
+				for (; it != _voxelizationMap->end(); ++it)
 				{
-					double voxelizationPlaneIndexMin = it.first - 0.5 * _voxelizationThickness;
-					double voxelizationPlaneIndexMax = it.first + 0.5 * _voxelizationThickness;
+					double voxelizationPlaneIndexMin = it->first - 0.5 * _voxelizationThickness;
+					double voxelizationPlaneIndexMax = it->first + 0.5 * _voxelizationThickness;
 					double weight = 0;
-					
+
+					//all following planes begin above the slice
+					if (voxelizationPlaneIndexMin >= indexZMax)
+					{
+						break;
+					}
+
 					if ((voxelizationPlaneIndexMin < indexZMin) && (voxelizationPlaneIndexMax > indexZMin))
 					{
 						if (voxelizationPlaneIndexMax < indexZMax)
@@ -142,7 +174,10 @@ namespace rttb
 						}
 					}
 
-					weightVector.insert(std::pair<double, double>(it.first, weight));
+					if (weight > 0)
+					{
+						weightVector.push_back(WeightedPlane(it->second.get(), weight));
+					}
 				}
 			}
 		}
@@ -19,11 +19,14 @@
 #include "rttbBaseType.h"
 #include "rttbGeometricInfo.h"
 #include "rttbMaskAccessorInterface.h"
+#include "rttbBoostMaskVoxelizationPlane.h"
+#include "rttbBoostMaskWorkQueue.h"
 
 #include <mutex>
 #include <map>
+#include <utility>
+#include <vector>
 
-#include <boost/multi_array.hpp>
 #include <boost/shared_ptr.hpp>
 
 namespace rttb
@@ -39,41 +42,41 @@ namespace rttb
 			{
 
 			public:
-				typedef ::boost::multi_array<double, 2> BoostArray2D;
-                using BoostArray2DPointer = ::boost::shared_ptr<BoostArray2D>;
-                typedef ::boost::shared_ptr<std::map<double, BoostArray2DPointer> > BoostArrayMapPointer;
 				using VoxelIndexVector = std::vector<rttb::VoxelGridIndex3D>;
                 using MaskVoxelListPointer = core::MaskAccessorInterface::MaskVoxelListPointer;
 
 				BoostMaskGenerateMaskVoxelListThread(const VoxelIndexVector& aGlobalBoundingBox,
           core::GeometricInfo::Pointer aGeometricInfo,
-                                                     BoostArrayMapPointer aVoxelizationMap,
+                                                     VoxelizationPlaneMapPointer aVoxelizationMap,
 				                                     double aVoxelizationThickness,
-				                                     unsigned int aBeginSlice,
-				                                     unsigned int aEndSlice,
+				                                     WorkQueuePointer aSliceQueue,
                                                      MaskVoxelListPointer aMaskVoxelList, bool strictVoxelization, ::boost::shared_ptr<std::mutex> aMutex);
 				void operator()();
 
 			private:
 				VoxelIndexVector _globalBoundingBox;
 				core::GeometricInfo::Pointer _geometricInfo;
-        BoostArrayMapPointer _voxelizationMap;
+        VoxelizationPlaneMapPointer _voxelizationMap;
         bool _strictVoxelization=true;
 				//(for example, the first contour has the double grid index 0.1, the second 0.3, the third 0.5, then the thickness is 0.2)
 				double _voxelizationThickness;
 
-				unsigned int _beginSlice;
-				/*! @brief _endSlice is the first index not to be processed (like a end iterator)
+				/*! @brief queue of the slice indices to be processed, shared by all mask generation threads
 				*/
-				unsigned int _endSlice;
+				WorkQueuePointer _sliceQueue;
 
                 MaskVoxelListPointer _resultMaskVoxelList;
                 ::boost::shared_ptr<std::mutex> _mutex;
 
-				/*! @brief For each dose grid index z, calculate the weight vector for each structure contour
+				/*! voxelization plane contributing to a slice and its weight*/
+				using WeightedPlane = std::pair<const VoxelizationPlane*, double>;
+
+				/*! @brief For each dose grid index z, calculate the weight vector of the structure contours
+				*	@details Only the voxelization planes with a weight > 0 are added (in ascending z order), so the vector is empty
+				*	for slices outside of the z range of the structure.
 				*/
 				void calcWeightVector(const rttb::VoxelGridID& aIndexZ,
-				                      std::map<double, double>& weightVector) const;
+				                      std::vector<WeightedPlane>& weightVector) const;
 
       };
 
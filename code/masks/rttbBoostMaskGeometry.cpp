@@ -0,0 +1,44 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include "rttbBoostMaskGeometry.h"
+
+#include <boost/make_shared.hpp>
+
+namespace rttb
+{
+	namespace masks
+	{
+		namespace boost
+		{
+			BoostMaskGeometry::BoostMaskGeometry(const core::GeometricInfo& aGeometricInfo) :
+				_geometricInfo(::boost::make_shared<core::GeometricInfo>(aGeometricInfo))
+			{
+				const OrientationMatrix& invertedOrientationMatrix = aGeometricInfo.getInvertedOrientationMatrix();
+
+				for (unsigned int i = 0; i < 3; ++i)
+				{
+					for (unsigned int j = 0; j < 3; ++j)
+					{
+						_invertedOrientationMatrix[i][j] = invertedOrientationMatrix(i, j);
+					}
+
+					_imagePositionPatient[i] = aGeometricInfo.getImagePositionPatient()(i);
+					_spacing[i] = aGeometricInfo.getSpacing()(i);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,85 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __BOOST_MASK_GEOMETRY_H
+#define __BOOST_MASK_GEOMETRY_H
+
+#include <boost/shared_ptr.hpp>
+
+#include "rttbBaseType.h"
+#include "rttbGeometricInfo.h"
+
+#include "RTTBMaskExports.h"
+
+namespace rttb
+{
+	namespace masks
+	{
+		namespace boost
+		{
+			/*! @class BoostMaskGeometry
+			*   @brief The data of the reference geometry that BoostMask needs, prepared once and shared by all masks of the geometry.
+			*   @details Holds the geometric info and the world to index transformation (inverted orientation matrix, image position
+			*   and spacing) as plain values, so that the contour points are converted without the temporaries of
+			*   core::GeometricInfo::worldCoordinateToContinuousIndex(). The results are identical.
+			*/
+			class RTTBMask_EXPORT BoostMaskGeometry
+			{
+			public:
+				typedef ::boost::shared_ptr<const BoostMaskGeometry> Pointer;
+
+				explicit BoostMaskGeometry(const core::GeometricInfo& aGeometricInfo);
+
+				core::GeometricInfo::Pointer getGeometricInfo() const
+				{
+					return _geometricInfo;
+				}
+
+				/*! @brief Converts a world coordinate into a continuous (double) voxel grid index.
+				* @details Unlike core::GeometricInfo::worldCoordinateToContinuousIndex() there is no check whether the index is inside.
+				*/
+				void worldCoordinateToContinuousIndex(const WorldCoordinate3D& aWorldCoordinate,
+				                                      ContinuousVoxelGridIndex3D& aIndex) const
+				{
+					const double distance[3] = { aWorldCoordinate(0) - _imagePositionPatient[0],
+					                             aWorldCoordinate(1) - _imagePositionPatient[1],
+					                             aWorldCoordinate(2) - _imagePositionPatient[2]
+					                           };
+
+					for (unsigned int i = 0; i < 3; ++i)
+					{
+						double value = 0;
+
+						for (unsigned int j = 0; j < 3; ++j)
+						{
+							value += _invertedOrientationMatrix[i][j] * distance[j];
+						}
+
+						aIndex(i) = value / _spacing[i];
+					}
+				}
+
+			private:
+				core::GeometricInfo::Pointer _geometricInfo;
+
+				double _invertedOrientationMatrix[3][3];
+				double _imagePositionPatient[3];
+				double _spacing[3];
+			};
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,270 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include "rttbBoostMaskScanlineVoxelizationThread.h"
+#include "rttbBoostMaskVoxelizationThread.h"
+
+#include "rttbInvalidParameterException.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <boost/make_shared.hpp>
+
+namespace rttb
+{
+	namespace masks
+	{
+		namespace boost
+		{
+			namespace
+			{
+				/*! Accumulated fractions closer than this to 0 or 1 are set to exactly 0 or 1 (double imprecision of the prefix sums)*/
+				const double snapTolerance = 1e-10;
+			}
+
+			BoostMaskScanlineVoxelizationThread::BoostMaskScanlineVoxelizationThread(BoostPolygonPlaneVectorPointer aPlaneVector,
+			        WorkQueuePointer aPlaneQueue, const VoxelIndexVector& aGlobalBoundingBox, VoxelizationPlaneMapPointer anArrayMap,
+			        ::boost::shared_ptr<std::mutex> aMutex, bool strict) : _planes(aPlaneVector), _planeQueue(aPlaneQueue),
+				_globalBoundingBox(aGlobalBoundingBox), _resultVoxelization(anArrayMap), _mutex(aMutex), _strict(strict)
+			{
+			}
+
+			void BoostMaskScanlineVoxelizationThread::operator()()
+			{
+				rttb::VoxelGridIndex3D minIndex = _globalBoundingBox.at(0);
+				rttb::VoxelGridIndex3D maxIndex = _globalBoundingBox.at(1);
+				const unsigned int globalBoundingBoxSize0 = maxIndex[0] - minIndex[0] + 1;
+				const unsigned int globalBoundingBoxSize1 = maxIndex[1] - minIndex[1] + 1;
+
+				std::map<double, VoxelizationPlanePointer> voxelizationMapInThread;
+				std::vector<double> accumulator;
+				std::vector<double> regionValues;
+
+				//take the contour planes from the queue shared with the other voxelization threads
+				size_t planeIndex;
+
+				while (_planeQueue->getNextItem(planeIndex))
+				{
+					const auto& it = (*_planes)[planeIndex];
+
+					//only the region of the contours of this plane is voxelized, all other values are 0
+					unsigned int regionBegin0, regionBegin1, regionSize0, regionSize1;
+					BoostMaskVoxelizationThread::calcPlaneRegion(it.second, minIndex, globalBoundingBoxSize0,
+					        globalBoundingBoxSize1, regionBegin0, regionBegin1, regionSize0, regionSize1);
+
+					//the voxel (regionBegin0, regionBegin1) covers [minIndex+regionBegin-0.5, minIndex+regionBegin+0.5]
+					const double originX = static_cast<double>(minIndex[0] + regionBegin0) - 0.5;
+					const double originY = static_cast<double>(minIndex[1] + regionBegin1) - 0.5;
+
+					accumulator.assign(static_cast<size_t>(regionSize0 + 1) * regionSize1, 0.0);
+
+					for (const auto& polygon : it.second)
+					{
+						accumulateRing(polygon.outer(), false, originX, originY, regionSize0, regionSize1, accumulator);
+
+						for (const auto& innerRing : polygon.inners())
+						{
+							accumulateRing(innerRing, true, originX, originY, regionSize0, regionSize1, accumulator);
+						}
+					}
+
+					regionValues.assign(static_cast<size_t>(regionSize0) * regionSize1, 0);
+
+					for (unsigned int y = 0; y < regionSize1; ++y)
+					{
+						const double* rowAccumulator = &accumulator[static_cast<size_t>(y) * (regionSize0 + 1)];
+						double volumeFraction = 0;
+
+						for (unsigned int x = 0; x < regionSize0; ++x)
+						{
+							volumeFraction += rowAccumulator[x];
+
+							double correctedFraction = volumeFraction;
+
+							if (std::abs(correctedFraction) <= snapTolerance)
+							{
+								correctedFraction = 0;
+							}
+							else if (std::abs(correctedFraction - 1) <= snapTolerance)
+							{
+								correctedFraction = 1;
+							}
+
+							correctedFraction = BoostMaskVoxelizationThread::correctForErrorAndStrictness(correctedFraction,
+							                    _strict);
+
+							if (correctedFraction < 0 || correctedFraction > 1)
+							{
+								throw rttb::core::InvalidParameterException("Mask calculation failed! The volume fraction should >= 0 and <= 1!");
+							}
+
+							regionValues[static_cast<size_t>(x) * regionSize1 + y] = correctedFraction;
+						}
+					}
+
+					auto voxelizationPlane = ::boost::make_shared<VoxelizationPlane>(regionBegin0, regionBegin1, regionSize0,
+					                         regionSize1);
+					voxelizationPlane->setRegionValues(regionValues);
+					voxelizationMapInThread.insert(std::pair<double, VoxelizationPlanePointer>(it.first, voxelizationPlane));
+				}
+
+				//insert gathered values into voxelization map
+				std::unique_lock<std::mutex> lock(*_mutex);
+				_resultVoxelization->insert(voxelizationMapInThread.begin(), voxelizationMapInThread.end());
+			}
+
+			void BoostMaskScanlineVoxelizationThread::accumulateRing(const BoostRing2D& aRing, bool isHole,
+			        double originX, double originY, unsigned int sizeX, unsigned int sizeY,
+			        std::vector<double>& accumulator)
+			{
+				const size_t numberOfPoints = aRing.size();
+
+				if (numberOfPoints < 3 || sizeX == 0 || sizeY == 0)
+				{
+					return;
+				}
+
+				//twice the signed area (shoelace formula), positive for counter clockwise rings
+				double doubleSignedArea = 0;
+
+				for (size_t i = 0; i < numberOfPoints; ++i)
+				{
+					const auto& p0 = aRing[i];
+					const auto& p1 = aRing[(i + 1) % numberOfPoints];
+					doubleSignedArea += p0.x() * p1.y() - p1.x() * p0.y();
+				}
+
+				//The edge integral over w(x) dy (w: covered part of a voxel right of x) is the negative covered area
+				//for counter clockwise rings. Outer rings always add their area, interior rings (holes) subtract it.
+				double orientationFactor = (doubleSignedArea > 0) ? -1.0 : 1.0;
+
+				if (isHole)
+				{
+					orientationFactor = -orientationFactor;
+				}
+
+				for (size_t i = 0; i < numberOfPoints; ++i)
+				{
+					const auto& p0 = aRing[i];
+					const auto& p1 = aRing[(i + 1) % numberOfPoints];
+
+					const double x0 = p0.x() - originX;
+					const double y0 = p0.y() - originY;
+					const double x1 = p1.x() - originX;
+					const double y1 = p1.y() - originY;
+
+					//horizontal edges (and the closing point of the ring) do not contribute
+					if (y0 == y1)
+					{
+						continue;
+					}
+
+					const double edgeMinY = std::min(y0, y1);
+					const double edgeMaxY = std::max(y0, y1);
+
+					if (edgeMaxY <= 0 || edgeMinY >= sizeY)
+					{
+						continue;
+					}
+
+					const double slope = (x1 - x0) / (y1 - y0);
+					const auto firstRow = static_cast<unsigned int>(std::max(0.0, std::floor(edgeMinY)));
+					const auto lastRow = static_cast<unsigned int>(std::min(static_cast<double>(sizeY - 1),
+					                     std::floor(edgeMaxY)));
+
+					for (unsigned int row = firstRow; row <= lastRow; ++row)
+					{
+						//clip the edge to the row [row, row+1]
+						const double ya = std::min(std::max(y0, static_cast<double>(row)), static_cast<double>(row + 1));
+						const double yb = std::min(std::max(y1, static_cast<double>(row)), static_cast<double>(row + 1));
+
+						if (ya == yb)
+						{
+							continue;
+						}
+
+						const double xa = (ya == y0) ? x0 : x0 + (ya - y0) * slope;
+						const double xb = (yb == y1) ? x1 : x0 + (yb - y0) * slope;
+
+						accumulateEdgeInRow(xa, xb, orientationFactor * (yb - ya), sizeX,
+						                    &accumulator[static_cast<size_t>(row) * (sizeX + 1)]);
+					}
+				}
+			}
+
+			void BoostMaskScanlineVoxelizationThread::accumulateEdgeInRow(double xa, double xb, double dy,
+			        unsigned int sizeX, double* rowAccumulator)
+			{
+				const double xMin = std::min(xa, xb);
+				const double xMax = std::max(xa, xb);
+
+				//edge part left of the bounding box: all voxels of the row are right of it
+				if (xMax <= 0)
+				{
+					rowAccumulator[0] += dy;
+					return;
+				}
+
+				//edge part right of the bounding box: no voxel of the row is right of it
+				if (xMin >= sizeX)
+				{
+					return;
+				}
+
+				//vertical edge part: only a single voxel is partially covered
+				if (xMax == xMin)
+				{
+					const auto column = static_cast<unsigned int>(xMin);
+					const double area = dy * ((column + 1) - xMin);
+					rowAccumulator[column] += area;
+					rowAccumulator[column + 1] += dy - area;
+					return;
+				}
+
+				const double dyPerX = dy / (xMax - xMin);
+				double clippedMin = xMin;
+
+				if (clippedMin < 0)
+				{
+					rowAccumulator[0] += -clippedMin * dyPerX;
+					clippedMin = 0;
+				}
+
+				const auto firstColumn = static_cast<unsigned int>(clippedMin);
+				const auto lastColumn = static_cast<unsigned int>(std::min(static_cast<double>(sizeX - 1),
+				                        std::floor(xMax)));
+
+				for (unsigned int column = firstColumn; column <= lastColumn; ++column)
+				{
+					const double left = std::max(clippedMin, static_cast<double>(column));
+					const double right = std::min(xMax, static_cast<double>(column + 1));
+
+					if (right <= left)
+					{
+						continue;
+					}
+
+					//trapezoid right of the edge part inside the voxel, the rest of the height covers all following voxels
+					const double partDy = (right - left) * dyPerX;
+					const double area = partDy * ((column + 1) - 0.5 * (left + right));
+					rowAccumulator[column] += area;
+					rowAccumulator[column + 1] += partDy - area;
+				}
+			}
+
+		}
+	}
+}
@@ -0,0 +1,102 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __BOOST_MASK_SCANLINE_VOXELIZATION_THREAD_H
+#define __BOOST_MASK_SCANLINE_VOXELIZATION_THREAD_H
+
+#include <mutex>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "rttbBaseType.h"
+#include "rttbBoostMaskVoxelizationPlane.h"
+#include "rttbBoostMaskWorkQueue.h"
+
+#include <boost/shared_ptr.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/geometry/geometries/polygon.hpp>
+
+namespace rttb
+{
+	namespace masks
+	{
+		namespace boost
+		{
+			/*! @class BoostMaskScanlineVoxelizationThread
+			*   @brief Computes the voxelization planes of the given contours analytically.
+			*   @details Instead of intersecting every voxel square with the contour polygons, the exact covered area of each voxel
+			*   is obtained by edge integration (Green's theorem): every polygon edge is clipped to the voxel rows it crosses and its
+			*   signed trapezoid area is accumulated per voxel; a prefix sum along each row then yields the volume fractions.
+			*   The cost per contour plane is O(edge crossings + voxels in the bounding box). The resulting planes are equal to the ones
+			*   of BoostMaskVoxelizationThread (up to floating point precision).
+			*/
+			class BoostMaskScanlineVoxelizationThread
+			{
+
+			public:
+				using BoostPolygon2D = ::boost::geometry::model::polygon< ::boost::geometry::model::d2::point_xy<double> >;
+				using BoostPolygonVector = std::vector<BoostPolygon2D>;//polygon with or without holes
+				using BoostPolygonPlane = std::pair<double, BoostPolygonVector>;//z index with the vector of boost 2d polygon
+				using BoostPolygonPlaneVectorPointer = ::boost::shared_ptr<std::vector<BoostPolygonPlane> >;
+				using VoxelIndexVector = std::vector<rttb::VoxelGridIndex3D>;
+
+				/*! @brief Constructor
+				* @param aPlaneVector all contour planes of the structure
+				* @param aPlaneQueue queue of the indices of aPlaneVector, shared by all voxelization threads
+				* @param aMutex a mutex for thread-safe handling of the _resultVoxelization
+				* @param strict true means that volumeFractions of <0 and >1 are NOT corrected. Otherwise, they are automatically corrected to 0 or 1, respectively.
+				*/
+				BoostMaskScanlineVoxelizationThread(BoostPolygonPlaneVectorPointer aPlaneVector, WorkQueuePointer aPlaneQueue,
+				                                    const VoxelIndexVector& aGlobalBoundingBox, VoxelizationPlaneMapPointer anArrayMap,
+				                                    ::boost::shared_ptr<std::mutex> aMutex, bool strict);
+
+				void operator()();
+
+			private:
+				using BoostRing2D = ::boost::geometry::model::ring< ::boost::geometry::model::d2::point_xy<double> >;
+
+				BoostPolygonPlaneVectorPointer _planes;
+				WorkQueuePointer _planeQueue;
+				VoxelIndexVector _globalBoundingBox;
+				VoxelizationPlaneMapPointer _resultVoxelization;
+				::boost::shared_ptr<std::mutex> _mutex;
+				bool _strict;
+
+				/*! @brief Accumulates the signed coverage contribution of all edges of a ring
+				* @param aRing the ring in double geometry coordinates
+				* @param isHole true if the ring is an interior ring, its covered area is subtracted then
+				* @param originX, originY continuous index of the lower corner of the first voxel of the bounding box
+				* @param sizeX number of voxels of a row in the bounding box
+				* @param sizeY number of rows in the bounding box
+				* @param accumulator row wise accumulator of size (sizeX+1)*sizeY
+				*/
+				static void accumulateRing(const BoostRing2D& aRing, bool isHole, double originX, double originY,
+				                           unsigned int sizeX, unsigned int sizeY, std::vector<double>& accumulator);
+
+				/*! @brief Accumulates the signed coverage contribution of the part of an edge inside one voxel row
+				* @param xa, xb x coordinate (relative to the bounding box) of the edge at the lower/upper border of its part in the row
+				* @param dy signed height of the edge part (already multiplied with the orientation factor of the ring)
+				* @param rowAccumulator pointer to the first of the sizeX+1 accumulator entries of the row
+				*/
+				static void accumulateEdgeInRow(double xa, double xb, double dy, unsigned int sizeX,
+				                                double* rowAccumulator);
+			};
+
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,108 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include "rttbBoostMaskSetGenerator.h"
+
+#include <algorithm>
+#include <regex>
+
+#include <boost/make_shared.hpp>
+
+#include "rttbBoostMaskAccessor.h"
+#include "rttbNullPointerException.h"
+#include "rttbThreadPool.h"
+
+namespace rttb
+{
+	namespace masks
+	{
+		namespace boost
+		{
+			BoostMaskSetGenerator::BoostMaskSetGenerator(core::StructureSet::Pointer aStructureSet,
+			        const core::GeometricInfo& aGeometricInfo, bool strict, VoxelizationMethod::Type voxelizationMethod) :
+				_structureSet(aStructureSet), _geometry(::boost::make_shared<BoostMaskGeometry>(aGeometricInfo)),
+				_strict(strict), _voxelizationMethod(voxelizationMethod)
+			{
+				if (_structureSet == nullptr)
+				{
+					throw core::NullPointerException("Error: Structure set is nullptr!");
+				}
+			}
+
+			std::vector<size_t> BoostMaskSetGenerator::getSelectedStructureIndices() const
+			{
+				std::vector<size_t> structureIndices;
+				std::regex e(_activeFilter ? _filterRegEx : ".*");
+
+				for (size_t i = 0; i < _structureSet->getNumberOfStructures(); ++i)
+				{
+					if (!_activeFilter || std::regex_match(_structureSet->getStructure(i)->getLabel(), e))
+					{
+						structureIndices.push_back(i);
+					}
+				}
+
+				return structureIndices;
+			}
+
+			BoostMaskSetGenerator::MaskAccessorVector BoostMaskSetGenerator::generateMasks()
+			{
+				return generateMasks(getSelectedStructureIndices());
+			}
+
+			BoostMaskSetGenerator::MaskAccessorVector BoostMaskSetGenerator::generateMasks(
+			    const std::vector<size_t>& structureIndices)
+			{
+				std::vector<::boost::shared_ptr<BoostMaskAccessor> > maskAccessors;
+
+				for (auto structureIndex : structureIndices)
+				{
+					maskAccessors.push_back(::boost::make_shared<BoostMaskAccessor>(_structureSet->getStructure(structureIndex),
+					                        _geometry, _strict, _voxelizationMethod));
+				}
+
+				//the structures with the most contour points are the most expensive ones, they are started first so that
+				//the small structures at the end balance the load of the threads
+				std::vector<size_t> order(maskAccessors.size());
+
+				for (size_t i = 0; i < order.size(); ++i)
+				{
+					order[i] = i;
+				}
+
+				std::stable_sort(order.begin(), order.end(), [this, &structureIndices](size_t a, size_t b)
+				{
+					return _structureSet->getStructure(structureIndices[a])->getNumberOfEndpoints() >
+					       _structureSet->getStructure(structureIndices[b])->getNumberOfEndpoints();
+				});
+
+				core::TaskGroup tasks;
+
+				for (auto i : order)
+				{
+					auto maskAccessor = maskAccessors[i];
+					tasks.run([maskAccessor]()
+					{
+						maskAccessor->updateMask();
+					});
+				}
+
+				tasks.wait();
+
+				return MaskAccessorVector(maskAccessors.begin(), maskAccessors.end());
+			}
+		}
+	}
+}
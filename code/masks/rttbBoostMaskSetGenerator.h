@@ -0,0 +1,111 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __BOOST_MASK_SET_GENERATOR_H
+#define __BOOST_MASK_SET_GENERATOR_H
+
+#include <string>
+#include <vector>
+
+#include "rttbGeometricInfo.h"
+#include "rttbMaskAccessorInterface.h"
+#include "rttbStructureSet.h"
+#include "rttbBoostMaskGeometry.h"
+#include "rttbBoostMaskVoxelizationMethod.h"
+
+#include "RTTBMaskExports.h"
+
+namespace rttb
+{
+	namespace masks
+	{
+		namespace boost
+		{
+			/*! @class BoostMaskSetGenerator
+			*   @brief Generates the BoostMaskAccessors of several structures of a structure set on the same reference geometry in one job.
+			*   @details The reference geometry is prepared only once (see BoostMaskGeometry) and shared by all masks. The structures are
+			*   voxelized concurrently on the thread pool of the library (see core::ThreadPool), the largest structures (number of contour points)
+			*   first. The voxelization of every structure is parallelized as well, so few large structures use all threads, too.
+			*   The structures can be selected by a regular expression on their labels.
+			*/
+			class RTTBMask_EXPORT BoostMaskSetGenerator
+			{
+			public:
+				using MaskAccessorPointer = core::MaskAccessorInterface::Pointer;
+				using MaskAccessorVector = std::vector<MaskAccessorPointer>;
+
+				/*! @brief Constructor
+				* @param aStructureSet the structures to voxelize
+				* @param aGeometricInfo the reference geometry of all masks
+				* @param strict indicates whether to allow self intersection in the structures (see BoostMaskAccessor).
+				* @param voxelizationMethod algorithm used to compute the voxelization planes (see VoxelizationMethod)
+				* @exception NullPointerException thrown if aStructureSet is nullptr
+				*/
+				BoostMaskSetGenerator(core::StructureSet::Pointer aStructureSet, const core::GeometricInfo& aGeometricInfo,
+				                      bool strict = true, VoxelizationMethod::Type voxelizationMethod = VoxelizationMethod::BoostGeometry);
+
+				void setStructureLabelFilterActive(bool active)
+				{
+					_activeFilter = active;
+				};
+
+				bool getStructureLabelFilterActive() const
+				{
+					return _activeFilter;
+				};
+
+				/*! @brief Sets the regular expression (ECMAScript, whole label) that selects the structures if the filter is active*/
+				void setFilterRegEx(const std::string& filter)
+				{
+					_filterRegEx = filter;
+				};
+
+				std::string getFilterRegEx() const
+				{
+					return _filterRegEx;
+				};
+
+				/*! @brief Returns the indices (in the structure set) of the structures that are selected by the label filter
+				(all structures if the filter is not active)
+				*/
+				std::vector<size_t> getSelectedStructureIndices() const;
+
+				/*! @brief Voxelizes the structures selected by the label filter.
+				* @return the mask accessors (already updated) in the order of getSelectedStructureIndices()
+				* @exception InvalidParameterException thrown if strict is true and a structure has self intersections
+				*/
+				MaskAccessorVector generateMasks();
+
+				/*! @brief Voxelizes the given structures (the label filter is ignored).
+				* @param structureIndices indices of the structures in the structure set
+				* @return the mask accessors (already updated) in the order of structureIndices
+				* @exception InvalidParameterException thrown if an index is invalid or if strict is true and a structure has self intersections
+				*/
+				MaskAccessorVector generateMasks(const std::vector<size_t>& structureIndices);
+
+			private:
+				core::StructureSet::Pointer _structureSet;
+				BoostMaskGeometry::Pointer _geometry;
+				bool _strict;
+				VoxelizationMethod::Type _voxelizationMethod;
+
+				bool _activeFilter{false};
+				std::string _filterRegEx;
+			};
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,39 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __BOOST_MASK_VOXELIZATION_METHOD_H
+#define __BOOST_MASK_VOXELIZATION_METHOD_H
+
+namespace rttb
+{
+	namespace masks
+	{
+		namespace boost
+		{
+			/*! @brief Selects how BoostMask computes the voxelization planes of the contours.
+			*/
+			struct VoxelizationMethod
+			{
+				enum Type
+				{
+					BoostGeometry = 0, //* - Intersect each voxel square with the contour polygons using boost::geometry::intersection (default)
+					Scanline = 1 //* - Analytic coverage computation by integrating the contour edges row by row
+				};
+			};
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,109 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include "rttbBoostMaskVoxelizationPlane.h"
+
+#include <algorithm>
+
+#include "rttbInvalidParameterException.h"
+
+namespace rttb
+{
+	namespace masks
+	{
+		namespace boost
+		{
+			const unsigned int VoxelizationPlane::tileSize;
+			const std::int32_t VoxelizationPlane::emptyTile;
+			const std::int32_t VoxelizationPlane::fullTile;
+
+			VoxelizationPlane::VoxelizationPlane(unsigned int regionBegin0, unsigned int regionBegin1,
+			                                     unsigned int regionSize0, unsigned int regionSize1) : _regionBegin0(regionBegin0),
+				_regionBegin1(regionBegin1), _regionSize0(regionSize0), _regionSize1(regionSize1),
+				_numberOfTiles0((regionSize0 + tileSize - 1) / tileSize), _numberOfTiles1((regionSize1 + tileSize - 1) / tileSize),
+				_tiles(static_cast<size_t>(_numberOfTiles0) * _numberOfTiles1, emptyTile)
+			{
+			}
+
+			void VoxelizationPlane::setRegionValues(const std::vector<double>& regionValues)
+			{
+				if (regionValues.size() != static_cast<size_t>(_regionSize0) * _regionSize1)
+				{
+					throw rttb::core::InvalidParameterException("Error: the number of values does not match the region of the voxelization plane!");
+				}
+
+				_values.clear();
+
+				for (unsigned int tile0 = 0; tile0 < _numberOfTiles0; ++tile0)
+				{
+					const unsigned int begin0 = tile0 * tileSize;
+					const unsigned int end0 = std::min(begin0 + tileSize, _regionSize0);
+
+					for (unsigned int tile1 = 0; tile1 < _numberOfTiles1; ++tile1)
+					{
+						const unsigned int begin1 = tile1 * tileSize;
+						const unsigned int end1 = std::min(begin1 + tileSize, _regionSize1);
+
+						bool isEmpty = true;
+						bool isFull = true;
+
+						for (unsigned int x = begin0; x < end0 && (isEmpty || isFull); ++x)
+						{
+							for (unsigned int y = begin1; y < end1; ++y)
+							{
+								const double value = regionValues[static_cast<size_t>(x) * _regionSize1 + y];
+								isEmpty = isEmpty && value == 0;
+								isFull = isFull && value == 1;
+							}
+						}
+
+						std::int32_t& tile = _tiles[static_cast<size_t>(tile0) * _numberOfTiles1 + tile1];
+
+						if (isEmpty)
+						{
+							tile = emptyTile;
+						}
+						else if (isFull)
+						{
+							tile = fullTile;
+						}
+						else
+						{
+							tile = static_cast<std::int32_t>(_values.size() / (tileSize * tileSize));
+							_values.resize(_values.size() + tileSize * tileSize, 0);
+							double* tileValues = &_values[static_cast<size_t>(tile) * tileSize * tileSize];
+
+							for (unsigned int x = begin0; x < end0; ++x)
+							{
+								for (unsigned int y = begin1; y < end1; ++y)
+								{
+									tileValues[(x - begin0) * tileSize + (y - begin1)] = regionValues[static_cast<size_t>(x) * _regionSize1 + y];
+								}
+							}
+						}
+					}
+				}
+
+				_values.shrink_to_fit();
+			}
+
+			size_t VoxelizationPlane::getNumberOfStoredTiles() const
+			{
+				return _values.size() / (tileSize * tileSize);
+			}
+
+		}
+	}
+}
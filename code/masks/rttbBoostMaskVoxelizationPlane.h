@@ -0,0 +1,133 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __BOOST_MASK_VOXELIZATION_PLANE_H
+#define __BOOST_MASK_VOXELIZATION_PLANE_H
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+namespace rttb
+{
+	namespace masks
+	{
+		namespace boost
+		{
+			/*! @class VoxelizationPlane
+			*   @brief Sparse voxelization plane (the volume fractions of one contour plane) of BoostMask.
+			*   @details The plane is defined on the x/y raster of the global bounding box of the structure, but only the region
+			*   of its own contours is stored. The region is divided into tiles of tileSize x tileSize voxels; tiles that are completely
+			*   outside (0) or completely inside (1) of the contours are stored implicitly, only the other tiles store their values.
+			*   All values outside of the region are 0.
+			*/
+			class VoxelizationPlane
+			{
+			public:
+				/*! Edge length of a tile in voxels*/
+				static const unsigned int tileSize = 16;
+
+				/*! @brief Constructor, all values are 0
+				* @param regionBegin0, regionBegin1 first voxel of the region (relative to the global bounding box)
+				* @param regionSize0, regionSize1 size of the region in voxels
+				*/
+				VoxelizationPlane(unsigned int regionBegin0, unsigned int regionBegin1, unsigned int regionSize0,
+				                  unsigned int regionSize1);
+
+				/*! @brief Sets the values of the region
+				* @param regionValues the values of the region, index x * regionSize1 + y (relative to the region)
+				*/
+				void setRegionValues(const std::vector<double>& regionValues);
+
+				/*! @return the value at the position (x,y) of the global bounding box*/
+				double getValue(unsigned int x, unsigned int y) const
+				{
+					if (x < _regionBegin0 || y < _regionBegin1)
+					{
+						return 0;
+					}
+
+					x -= _regionBegin0;
+					y -= _regionBegin1;
+
+					if (x >= _regionSize0 || y >= _regionSize1)
+					{
+						return 0;
+					}
+
+					const std::int32_t tile = _tiles[(x / tileSize) * _numberOfTiles1 + y / tileSize];
+
+					if (tile == emptyTile)
+					{
+						return 0;
+					}
+					else if (tile == fullTile)
+					{
+						return 1;
+					}
+
+					return _values[static_cast<size_t>(tile) * tileSize * tileSize + (x % tileSize) * tileSize + y % tileSize];
+				}
+
+				unsigned int getRegionBegin0() const
+				{
+					return _regionBegin0;
+				}
+
+				unsigned int getRegionBegin1() const
+				{
+					return _regionBegin1;
+				}
+
+				unsigned int getRegionSize0() const
+				{
+					return _regionSize0;
+				}
+
+				unsigned int getRegionSize1() const
+				{
+					return _regionSize1;
+				}
+
+				/*! @return the number of tiles that store their values explicitly*/
+				size_t getNumberOfStoredTiles() const;
+
+			private:
+				static const std::int32_t emptyTile = -1;
+				static const std::int32_t fullTile = -2;
+
+				unsigned int _regionBegin0;
+				unsigned int _regionBegin1;
+				unsigned int _regionSize0;
+				unsigned int _regionSize1;
+				unsigned int _numberOfTiles0;
+				unsigned int _numberOfTiles1;
+
+				/*! emptyTile, fullTile or the number of the tile in _values, index tileX * _numberOfTiles1 + tileY*/
+				std::vector<std::int32_t> _tiles;
+				/*! values of the stored tiles, tileSize * tileSize values per tile*/
+				std::vector<double> _values;
+			};
+
+			using VoxelizationPlanePointer = ::boost::shared_ptr<VoxelizationPlane>;
+			/*! map of the double z grid index of a contour plane with its voxelization plane*/
+			typedef ::boost::shared_ptr<std::map<double, VoxelizationPlanePointer> > VoxelizationPlaneMapPointer;
+		}
+	}
+}
+
+#endif
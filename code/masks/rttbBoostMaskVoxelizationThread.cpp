@@ -17,6 +17,10 @@
 
 #include "rttbInvalidParameterException.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include <boost/geometry.hpp>
 #include <boost/make_shared.hpp>
 
@@ -26,9 +30,9 @@ namespace rttb
 	{
 		namespace boost
 		{
-			BoostMaskVoxelizationThread::BoostMaskVoxelizationThread(const BoostPolygonMap& APolygonMap,
-                const VoxelIndexVector& aGlobalBoundingBox, BoostArrayMapPointer anArrayMap, ::boost::shared_ptr<std::mutex> aMutex, bool strict) : _geometryCoordinateBoostPolygonMap(APolygonMap),
-                _globalBoundingBox(aGlobalBoundingBox), _resultVoxelization(anArrayMap), _mutex(aMutex), _strict(strict)
+			BoostMaskVoxelizationThread::BoostMaskVoxelizationThread(BoostPolygonPlaneVectorPointer aPlaneVector, WorkQueuePointer aPlaneQueue,
+                const VoxelIndexVector& aGlobalBoundingBox, VoxelizationPlaneMapPointer anArrayMap, ::boost::shared_ptr<std::mutex> aMutex, bool strict) : _planes(aPlaneVector),
+                _planeQueue(aPlaneQueue), _globalBoundingBox(aGlobalBoundingBox), _resultVoxelization(anArrayMap), _mutex(aMutex), _strict(strict)
 			{
 			}
 
@@ -39,39 +43,92 @@ namespace rttb
 				const unsigned int globalBoundingBoxSize0 = maxIndex[0] - minIndex[0] + 1;
 				const unsigned int globalBoundingBoxSize1 = maxIndex[1] - minIndex[1] + 1;
 
-                std::map<double, ::boost::shared_ptr<BoostArray2D> > voxelizationMapInThread;
+                std::map<double, VoxelizationPlanePointer> voxelizationMapInThread;
+
+                std::vector<bool> isBoundaryVoxel;
+                std::vector<unsigned int> numberOfContainingPolygons;
+                std::vector<double> regionValues;
+
+                //temporaries of the intersections are allocated from the arena of this thread and released per slice
+                MonotonicArena arena;
+                MonotonicArena::Scope arenaScope(arena);
+                BoostRing2D voxelPolygon;
 
-                 for (auto & it : _geometryCoordinateBoostPolygonMap)
+                //take the contour planes from the queue shared with the other voxelization threads
+                size_t planeIndex;
+
+                 while (_planeQueue->getNextItem(planeIndex))
 				{
-                    BoostArray2D maskArray(::boost::extents[globalBoundingBoxSize0][globalBoundingBoxSize1]);
+					auto& it = (*_planes)[planeIndex];
+					BoostPolygonVector& boostPolygonVec = it.second;
+
+					//only the region of the contours of this plane is voxelized, all other values are 0
+					unsigned int regionBegin0, regionBegin1, regionSize0, regionSize1;
+					calcPlaneRegion(boostPolygonVec, minIndex, globalBoundingBoxSize0, globalBoundingBoxSize1,
+					                regionBegin0, regionBegin1, regionSize0, regionSize1);
 
-					BoostPolygonVector boostPolygonVec = it.second;
+					rttb::VoxelGridIndex3D regionMinIndex = minIndex;
+					regionMinIndex[0] += regionBegin0;
+					regionMinIndex[1] += regionBegin1;
 
-					for (unsigned int x = 0; x < globalBoundingBoxSize0; ++x)
+					//correct the contours once per slice instead of once per voxel
+					for (auto& polygon : boostPolygonVec)
 					{
-						for (unsigned int y = 0; y < globalBoundingBoxSize1; ++y)
-						{
-							rttb::VoxelGridIndex3D currentIndex;
-							currentIndex[0] = x + minIndex[0];
-							currentIndex[1] = y + minIndex[1];
-							currentIndex[2] = 0;
+						::boost::geometry::correct(polygon);
+					}
+
+					BoostPolygonDeque polygons;
+
+					//only voxels touched by a contour edge need the exact intersection
+					classifyVoxels(boostPolygonVec, regionMinIndex, regionSize0, regionSize1,
+					               isBoundaryVoxel, numberOfContainingPolygons);
 
-							//Get intersection polygons of the dose voxel and the structure
-							BoostPolygonDeque polygons = getIntersections(currentIndex, boostPolygonVec);
+					regionValues.assign(static_cast<size_t>(regionSize0) * regionSize1, 0);
+
+					for (unsigned int x = 0; x < regionSize0; ++x)
+					{
+						for (unsigned int y = 0; y < regionSize1; ++y)
+						{
+							const size_t voxelIndex = static_cast<size_t>(x) * regionSize1 + y;
+							double volumeFraction = 0;
+
+							if (isBoundaryVoxel[voxelIndex])
+							{
+								rttb::VoxelGridIndex3D currentIndex;
+								currentIndex[0] = x + regionMinIndex[0];
+								currentIndex[1] = y + regionMinIndex[1];
+								currentIndex[2] = 0;
+
+								//Get intersection polygons of the dose voxel and the structure
+								getIntersections(currentIndex, boostPolygonVec, voxelPolygon, polygons);
+
+								//Calc areas of all intersection polygons
+								volumeFraction = calcArea(polygons);
+							}
+							else
+							{
+								//the voxel is completely inside of each polygon containing its center
+								volumeFraction = numberOfContainingPolygons[voxelIndex];
+							}
 
-							//Calc areas of all intersection polygons
-							double volumeFraction = calcArea(polygons);
                             volumeFraction = correctForErrorAndStrictness(volumeFraction, _strict);
                             if (volumeFraction < 0 || volumeFraction > 1 )
                             {
                                 throw rttb::core::InvalidParameterException("Mask calculation failed! The volume fraction should >= 0 and <= 1!");
                             }
 
-							maskArray[x][y] = volumeFraction;
+							regionValues[voxelIndex] = volumeFraction;
 						}
 					}
 
-                    voxelizationMapInThread.insert(std::pair<double, BoostArray2DPointer>(it.first, ::boost::make_shared<BoostArray2D>(maskArray)));
+					auto voxelizationPlane = ::boost::make_shared<VoxelizationPlane>(regionBegin0, regionBegin1, regionSize0,
+					                         regionSize1);
+					voxelizationPlane->setRegionValues(regionValues);
+                    voxelizationMapInThread.insert(std::pair<double, VoxelizationPlanePointer>(it.first, voxelizationPlane));
+
+                    //all intersection results of the slice are gone, the arena memory is reused for the next slice
+                    polygons = BoostPolygonDeque();
+                    arena.release();
 				}
                 //insert gathered values into voxelization map
                 std::unique_lock<std::mutex> lock(*_mutex);
@@ -79,53 +136,85 @@ namespace rttb
 
 			}
 
+			void BoostMaskVoxelizationThread::calcPlaneRegion(const BoostPolygonVector& aPolygonVector,
+			        const rttb::VoxelGridIndex3D& aGlobalMinIndex, unsigned int globalBoundingBoxSize0,
+			        unsigned int globalBoundingBoxSize1, unsigned int& regionBegin0, unsigned int& regionBegin1,
+			        unsigned int& regionSize0, unsigned int& regionSize1)
+			{
+				double min0 = std::numeric_limits<double>::max();
+				double min1 = std::numeric_limits<double>::max();
+				double max0 = std::numeric_limits<double>::lowest();
+				double max1 = std::numeric_limits<double>::lowest();
+
+				//the inner rings are inside of the outer ring
+				for (const auto& polygon : aPolygonVector)
+				{
+					for (const auto& point : polygon.outer())
+					{
+						min0 = std::min(min0, point.x() - aGlobalMinIndex[0]);
+						max0 = std::max(max0, point.x() - aGlobalMinIndex[0]);
+						min1 = std::min(min1, point.y() - aGlobalMinIndex[1]);
+						max1 = std::max(max1, point.y() - aGlobalMinIndex[1]);
+					}
+				}
+
+				//the voxel x covers [x-0.5, x+0.5]
+				const double first0 = std::max(0.0, std::floor(min0 + 0.5));
+				const double first1 = std::max(0.0, std::floor(min1 + 0.5));
+				const double last0 = std::min(static_cast<double>(globalBoundingBoxSize0) - 1, std::floor(max0 + 0.5));
+				const double last1 = std::min(static_cast<double>(globalBoundingBoxSize1) - 1, std::floor(max1 + 0.5));
+
+				if (first0 > last0 || first1 > last1)
+				{
+					regionBegin0 = 0;
+					regionBegin1 = 0;
+					regionSize0 = 0;
+					regionSize1 = 0;
+					return;
+				}
+
+				regionBegin0 = static_cast<unsigned int>(first0);
+				regionBegin1 = static_cast<unsigned int>(first1);
+				regionSize0 = static_cast<unsigned int>(last0 - first0) + 1;
+				regionSize1 = static_cast<unsigned int>(last1 - first1) + 1;
+			}
+
 			/*Get intersection polygons of the contour and a voxel polygon*/
-			BoostMaskVoxelizationThread::BoostPolygonDeque BoostMaskVoxelizationThread::getIntersections(
-			    const rttb::VoxelGridIndex3D&
-			    aVoxelIndex3D, const BoostPolygonVector& intersectionSlicePolygons)
+			void BoostMaskVoxelizationThread::getIntersections(const rttb::VoxelGridIndex3D& aVoxelIndex3D,
+			        const BoostPolygonVector& intersectionSlicePolygons, BoostRing2D& voxelPolygon,
+			        BoostPolygonDeque& intersections)
 			{
-				BoostMaskVoxelizationThread::BoostPolygonDeque polygonDeque;
+				intersections.clear();
 
-				BoostRing2D voxelPolygon = get2DContour(aVoxelIndex3D);
+				set2DContour(aVoxelIndex3D, voxelPolygon);
 				::boost::geometry::correct(voxelPolygon);
 
 				BoostPolygonVector::const_iterator it;
 
 				for (it = intersectionSlicePolygons.begin(); it != intersectionSlicePolygons.end(); ++it)
 				{
-					BoostPolygon2D contour = *it;
-					::boost::geometry::correct(contour);
-					
-					BoostPolygonDeque intersection;
-					::boost::geometry::intersection(voxelPolygon, contour, intersection);
-					polygonDeque.insert(polygonDeque.end(), intersection.begin(), intersection.end());
+					::boost::geometry::intersection(voxelPolygon, *it, intersections);
 				}
-
-				return polygonDeque;
 			}
 
-			BoostMaskVoxelizationThread::BoostRing2D BoostMaskVoxelizationThread::get2DContour(
-			    const rttb::VoxelGridIndex3D& aVoxelGrid3D)
+			void BoostMaskVoxelizationThread::set2DContour(const rttb::VoxelGridIndex3D& aVoxelGrid3D,
+			        BoostRing2D& aVoxelPolygon)
 			{
-				BoostRing2D polygon;
-
+				aVoxelPolygon.clear();
 
 				BoostPoint2D point1(aVoxelGrid3D[0] - 0.5, aVoxelGrid3D[1] - 0.5);
-				::boost::geometry::append(polygon, point1);
+				::boost::geometry::append(aVoxelPolygon, point1);
 
 				BoostPoint2D point2(aVoxelGrid3D[0] + 0.5, aVoxelGrid3D[1] - 0.5);
-				::boost::geometry::append(polygon, point2);
+				::boost::geometry::append(aVoxelPolygon, point2);
 
 				BoostPoint2D point3(aVoxelGrid3D[0] + 0.5, aVoxelGrid3D[1] + 0.5);
-				::boost::geometry::append(polygon, point3);
+				::boost::geometry::append(aVoxelPolygon, point3);
 
 				BoostPoint2D point4(aVoxelGrid3D[0] - 0.5, aVoxelGrid3D[1] + 0.5);
-				::boost::geometry::append(polygon, point4);
-
-				::boost::geometry::append(polygon, point1);
-
-				return polygon;
+				::boost::geometry::append(aVoxelPolygon, point4);
 
+				::boost::geometry::append(aVoxelPolygon, point1);
 			}
 
 			/*Calculate the intersection area*/
@@ -143,7 +232,138 @@ namespace rttb
 				return area;
 			}
 
-            double BoostMaskVoxelizationThread::correctForErrorAndStrictness(double volumeFraction, bool strict) const
+			void BoostMaskVoxelizationThread::classifyVoxels(const BoostPolygonVector& aPolygonVector,
+			        const rttb::VoxelGridIndex3D& aMinIndex, unsigned int boundingBoxSize0, unsigned int boundingBoxSize1,
+			        std::vector<bool>& isBoundaryVoxel, std::vector<unsigned int>& numberOfContainingPolygons)
+			{
+				const size_t numberOfVoxels = static_cast<size_t>(boundingBoxSize0) * boundingBoxSize1;
+				isBoundaryVoxel.assign(numberOfVoxels, false);
+				numberOfContainingPolygons.assign(numberOfVoxels, 0);
+
+				std::vector<std::vector<double> > rowCrossings(boundingBoxSize1);
+
+				for (const auto& polygon : aPolygonVector)
+				{
+					for (auto& crossings : rowCrossings)
+					{
+						crossings.clear();
+					}
+
+					markBoundaryVoxels(polygon.outer(), aMinIndex, boundingBoxSize0, boundingBoxSize1, isBoundaryVoxel);
+					collectCenterRowCrossings(polygon.outer(), aMinIndex, boundingBoxSize1, rowCrossings);
+
+					for (const auto& innerRing : polygon.inners())
+					{
+						markBoundaryVoxels(innerRing, aMinIndex, boundingBoxSize0, boundingBoxSize1, isBoundaryVoxel);
+						collectCenterRowCrossings(innerRing, aMinIndex, boundingBoxSize1, rowCrossings);
+					}
+
+					//even-odd fill of the voxel centers between pairs of crossings
+					for (unsigned int y = 0; y < boundingBoxSize1; ++y)
+					{
+						std::vector<double>& crossings = rowCrossings[y];
+						std::sort(crossings.begin(), crossings.end());
+
+						for (size_t i = 0; i + 1 < crossings.size(); i += 2)
+						{
+							const double first = std::max(0.0, std::ceil(crossings[i]));
+							const double last = std::min(static_cast<double>(boundingBoxSize0) - 1, std::floor(crossings[i + 1]));
+
+							for (double x = first; x <= last; ++x)
+							{
+								++numberOfContainingPolygons[static_cast<size_t>(x) * boundingBoxSize1 + y];
+							}
+						}
+					}
+				}
+			}
+
+			void BoostMaskVoxelizationThread::markBoundaryVoxels(const BoostRing2D& aRing,
+			        const rttb::VoxelGridIndex3D& aMinIndex, unsigned int boundingBoxSize0, unsigned int boundingBoxSize1,
+			        std::vector<bool>& isBoundaryVoxel)
+			{
+				//tolerance for edges touching the voxel borders
+				const double tolerance = 1e-9;
+				const size_t numberOfPoints = aRing.size();
+
+				for (size_t i = 0; i < numberOfPoints; ++i)
+				{
+					const BoostPoint2D& p0 = aRing[i];
+					const BoostPoint2D& p1 = aRing[(i + 1) % numberOfPoints];
+
+					//positions relative to the bounding box, the voxel (x,y) covers [x-0.5,x+0.5]x[y-0.5,y+0.5]
+					const double x0 = p0.x() - aMinIndex[0];
+					const double y0 = p0.y() - aMinIndex[1];
+					const double x1 = p1.x() - aMinIndex[0];
+					const double y1 = p1.y() - aMinIndex[1];
+
+					const double firstRow = std::max(0.0, std::floor(std::min(y0, y1) + 0.5 - tolerance));
+					const double lastRow = std::min(static_cast<double>(boundingBoxSize1) - 1,
+					                                std::floor(std::max(y0, y1) + 0.5 + tolerance));
+
+					for (double row = firstRow; row <= lastRow; ++row)
+					{
+						//x range of the edge within the row
+						double xa = x0;
+						double xb = x1;
+
+						if (y0 != y1)
+						{
+							const double slope = (x1 - x0) / (y1 - y0);
+							const double ya = std::min(std::max(y0, row - 0.5), row + 0.5);
+							const double yb = std::min(std::max(y1, row - 0.5), row + 0.5);
+							xa = x0 + (ya - y0) * slope;
+							xb = x0 + (yb - y0) * slope;
+						}
+
+						const double firstColumn = std::max(0.0, std::floor(std::min(xa, xb) + 0.5 - tolerance));
+						const double lastColumn = std::min(static_cast<double>(boundingBoxSize0) - 1,
+						                                   std::floor(std::max(xa, xb) + 0.5 + tolerance));
+
+						for (double column = firstColumn; column <= lastColumn; ++column)
+						{
+							isBoundaryVoxel[static_cast<size_t>(column) * boundingBoxSize1 + static_cast<size_t>(row)] = true;
+						}
+					}
+				}
+			}
+
+			void BoostMaskVoxelizationThread::collectCenterRowCrossings(const BoostRing2D& aRing,
+			        const rttb::VoxelGridIndex3D& aMinIndex, unsigned int boundingBoxSize1,
+			        std::vector<std::vector<double> >& rowCrossings)
+			{
+				const size_t numberOfPoints = aRing.size();
+
+				for (size_t i = 0; i < numberOfPoints; ++i)
+				{
+					const BoostPoint2D& p0 = aRing[i];
+					const BoostPoint2D& p1 = aRing[(i + 1) % numberOfPoints];
+
+					const double x0 = p0.x() - aMinIndex[0];
+					const double y0 = p0.y() - aMinIndex[1];
+					const double x1 = p1.x() - aMinIndex[0];
+					const double y1 = p1.y() - aMinIndex[1];
+
+					if (y0 == y1)
+					{
+						continue;
+					}
+
+					const double firstRow = std::max(0.0, std::ceil(std::min(y0, y1)));
+					const double lastRow = std::min(static_cast<double>(boundingBoxSize1) - 1, std::floor(std::max(y0, y1)));
+
+					for (double row = firstRow; row <= lastRow; ++row)
+					{
+						//half open rule: an edge crosses the row if exactly one of its end points is above the row
+						if ((y0 > row) != (y1 > row))
+						{
+							rowCrossings[static_cast<size_t>(row)].push_back(x0 + (row - y0) * (x1 - x0) / (y1 - y0));
+						}
+					}
+				}
+			}
+
+            double BoostMaskVoxelizationThread::correctForErrorAndStrictness(double volumeFraction, bool strict)
             {
                 if (strict){
                     if (volumeFraction > 1 && (volumeFraction - 1) <= errorConstant)
@@ -19,10 +19,14 @@
 #include <deque>
 #include <mutex>
 #include <map>
+#include <utility>
+#include <vector>
 
 #include "rttbBaseType.h"
+#include "rttbMonotonicArena.h"
+#include "rttbBoostMaskVoxelizationPlane.h"
+#include "rttbBoostMaskWorkQueue.h"
 
-#include <boost/multi_array.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/geometry/geometries/point_xy.hpp>
 #include <boost/geometry/geometries/polygon.hpp>
@@ -42,56 +46,94 @@ namespace rttb
 			public:
 				using BoostPolygon2D = ::boost::geometry::model::polygon< ::boost::geometry::model::d2::point_xy<double> >;
 				using BoostPolygonVector = std::vector<BoostPolygon2D>;//polygon with or without holes
-				typedef std::map<double, BoostPolygonVector>
-				BoostPolygonMap;//map of the z index with the vector of boost 2d polygon
+				using BoostPolygonPlane = std::pair<double, BoostPolygonVector>;//z index with the vector of boost 2d polygon
+				using BoostPolygonPlaneVectorPointer = ::boost::shared_ptr<std::vector<BoostPolygonPlane> >;
 				using VoxelIndexVector = std::vector<rttb::VoxelGridIndex3D>;
-				typedef ::boost::multi_array<double, 2> BoostArray2D;
-                using BoostArray2DPointer = ::boost::shared_ptr<BoostArray2D>;
-                typedef ::boost::shared_ptr<std::map<double, BoostArray2DPointer > > BoostArrayMapPointer;
 
                 /*! @brief Constructor
+                * @param aPlaneVector all contour planes of the structure, the planes are corrected in place (boost::geometry::correct) by the thread processing them
+                * @param aPlaneQueue queue of the indices of aPlaneVector, shared by all voxelization threads
                 * @param aMutex a mutex for thread-safe handling of the _resultVoxelization
                 * @param strict true means that volumeFractions of <0 and >1 are NOT corrected. Otherwise, they are automatically corrected to 0 or 1, respectively.
                 */
-				BoostMaskVoxelizationThread(const BoostPolygonMap& APolygonMap,
-                    const VoxelIndexVector& aGlobalBoundingBox, BoostArrayMapPointer anArrayMap, ::boost::shared_ptr<std::mutex> aMutex, bool strict);
+				BoostMaskVoxelizationThread(BoostPolygonPlaneVectorPointer aPlaneVector, WorkQueuePointer aPlaneQueue,
+                    const VoxelIndexVector& aGlobalBoundingBox, VoxelizationPlaneMapPointer anArrayMap, ::boost::shared_ptr<std::mutex> aMutex, bool strict);
 
 				void operator()();
 
+                /*! @brief Corrects the volumeFraction
+                * @details the volume fraction is corrected in case of strict=false. Otherwise, it's only corrected for double imprecision
+                * @return The corrected volumeFraction
+                */
+                static double correctForErrorAndStrictness(double volumeFraction, bool strict);
+
+                /*! @brief Calculates the region of the global bounding box that is covered by the polygons of a contour plane
+                * @details All voxels outside of the region have the volume fraction 0. The region is empty (size 0) if there are no polygons.
+                * @param regionBegin0, regionBegin1 Return the first voxel of the region (relative to the global bounding box)
+                * @param regionSize0, regionSize1 Return the size of the region in voxels
+                */
+                static void calcPlaneRegion(const BoostPolygonVector& aPolygonVector, const rttb::VoxelGridIndex3D& aGlobalMinIndex,
+                                            unsigned int globalBoundingBoxSize0, unsigned int globalBoundingBoxSize1, unsigned int& regionBegin0,
+                                            unsigned int& regionBegin1, unsigned int& regionSize0, unsigned int& regionSize1);
 
 			private:
-				using BoostPolygonDeque = std::deque<BoostPolygon2D>;
 				using BoostRing2D = ::boost::geometry::model::ring< ::boost::geometry::model::d2::point_xy<double> >;
 				using BoostPoint2D = ::boost::geometry::model::d2::point_xy<double>;
+				/*! intersection results are temporaries of a single voxel, they are allocated from the arena of the thread*/
+				using ArenaPolygon2D = ::boost::geometry::model::polygon<BoostPoint2D, true, true, std::vector, std::vector, ArenaAllocator, ArenaAllocator>;
+				using BoostPolygonDeque = std::deque<ArenaPolygon2D, ArenaAllocator<ArenaPolygon2D> >;
 
 
-				BoostPolygonMap _geometryCoordinateBoostPolygonMap;
+				BoostPolygonPlaneVectorPointer _planes;
+				WorkQueuePointer _planeQueue;
 				VoxelIndexVector _globalBoundingBox;
-        BoostArrayMapPointer _resultVoxelization;
+        VoxelizationPlaneMapPointer _resultVoxelization;
         ::boost::shared_ptr<std::mutex> _mutex;
         bool _strict;
 
 				/*! @brief Get intersection polygons of the contour and a voxel polygon
 				* @param aVoxelIndex3D The 3d grid index of the voxel
-				* @param intersectionSlicePolygons The polygons of the slice intersecting the voxel
-				* @return Return all intersection polygons of the structure and the voxel
+				* @param intersectionSlicePolygons The polygons of the slice intersecting the voxel, they have to be corrected already (boost::geometry::correct)
+				* @param voxelPolygon buffer for the voxel polygon, it is overwritten
+				* @param intersections Returns all intersection polygons of the structure and the voxel, previous content is removed
 				*/
-				static BoostPolygonDeque getIntersections(const rttb::VoxelGridIndex3D& aVoxelIndex3D,
-				        const BoostPolygonVector& intersectionSlicePolygons);
+				static void getIntersections(const rttb::VoxelGridIndex3D& aVoxelIndex3D,
+				                             const BoostPolygonVector& intersectionSlicePolygons, BoostRing2D& voxelPolygon,
+				                             BoostPolygonDeque& intersections);
 
-				/*! @brief Get the voxel 2d contour polygon in geometry coordinate*/
-				static BoostRing2D get2DContour(const rttb::VoxelGridIndex3D& aVoxelGrid3D);
+				/*! @brief Set the voxel 2d contour polygon in geometry coordinate
+				* @details The points of aVoxelPolygon are overwritten, so the ring can be reused for all voxels without reallocation.
+				*/
+				static void set2DContour(const rttb::VoxelGridIndex3D& aVoxelGrid3D, BoostRing2D& aVoxelPolygon);
 
 				/*! @brief Calculate the area of all polygons
 				* @param aPolygonDeque The deque of polygons
 				* @return Return the area of all polygons
 				*/
 				static double calcArea(const BoostPolygonDeque& aPolygonDeque);
-                /*! @brief Corrects the volumeFraction
-                * @details the volume fraction is corrected in case of strict=true. Otherwise, it's only corrected for double imprecision
-                * @return The corrected volumeFraction
-                */
-                double correctForErrorAndStrictness(double volumeFraction, bool strict) const;
+
+				/*! @brief Classify the voxels of the global bounding box for the polygons of a contour plane
+				* @details Voxels whose square is touched by a contour edge are boundary voxels and need the exact intersection.
+				* All other voxels are either completely inside or completely outside of each polygon; for them the number of polygons
+				* containing the voxel center is determined by a scanline fill on the voxel centers (even-odd rule, so holes are respected).
+				* @param isBoundaryVoxel true for the voxels touched by a contour edge, index x * boundingBoxSize1 + y (relative to the bounding box)
+				* @param numberOfContainingPolygons the number of polygons containing the voxel center, same index as isBoundaryVoxel
+				*/
+				static void classifyVoxels(const BoostPolygonVector& aPolygonVector, const rttb::VoxelGridIndex3D& aMinIndex,
+				                           unsigned int boundingBoxSize0, unsigned int boundingBoxSize1,
+				                           std::vector<bool>& isBoundaryVoxel, std::vector<unsigned int>& numberOfContainingPolygons);
+
+				/*! @brief Mark all voxels of the bounding box whose square is touched by an edge of the ring as boundary voxels.
+				* Voxels that are only touched within a small tolerance are marked too.
+				*/
+				static void markBoundaryVoxels(const BoostRing2D& aRing, const rttb::VoxelGridIndex3D& aMinIndex,
+				                               unsigned int boundingBoxSize0, unsigned int boundingBoxSize1, std::vector<bool>& isBoundaryVoxel);
+
+				/*! @brief Collect the x positions (relative to the bounding box) where the edges of the ring cross the voxel center rows
+				* @param rowCrossings one vector of crossings per row of the bounding box
+				*/
+				static void collectCenterRowCrossings(const BoostRing2D& aRing, const rttb::VoxelGridIndex3D& aMinIndex,
+				                                      unsigned int boundingBoxSize1, std::vector<std::vector<double> >& rowCrossings);
             };
 
 		}
@@ -0,0 +1,36 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include "rttbBoostMaskWorkQueue.h"
+
+namespace rttb
+{
+	namespace masks
+	{
+		namespace boost
+		{
+			WorkQueue::WorkQueue(std::size_t beginItem, std::size_t endItem) : _nextItem(beginItem), _endItem(endItem)
+			{
+			}
+
+			bool WorkQueue::getNextItem(std::size_t& item)
+			{
+				item = _nextItem.fetch_add(1);
+				return item < _endItem;
+			}
+
+		}
+	}
+}
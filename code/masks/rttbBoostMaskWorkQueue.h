@@ -0,0 +1,58 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __BOOST_MASK_WORK_QUEUE_H
+#define __BOOST_MASK_WORK_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+#include <boost/shared_ptr.hpp>
+
+namespace rttb
+{
+	namespace masks
+	{
+		namespace boost
+		{
+			/*! @class WorkQueue
+			*   @brief Thread-safe queue of work items (e.g. contour planes or slices) for the BoostMask threads.
+			*   @details The items [beginItem, endItem) are handed out one by one in ascending order. Every thread pulls
+			*   the next item as soon as it has finished the previous one, so threads with cheap items take over more work.
+			*/
+			class WorkQueue
+			{
+			public:
+				WorkQueue(std::size_t beginItem, std::size_t endItem);
+
+				WorkQueue(const WorkQueue&) = delete;
+				WorkQueue& operator=(const WorkQueue&) = delete;
+
+				/*! @brief Takes the next item
+				* @return false if all items have been handed out already
+				*/
+				bool getNextItem(std::size_t& item);
+
+			private:
+				std::atomic<std::size_t> _nextItem;
+				const std::size_t _endItem;
+			};
+
+			using WorkQueuePointer = ::boost::shared_ptr<WorkQueue>;
+		}
+	}
+}
+
+#endif
@@ -31,7 +31,8 @@ namespace rttb
 
 
 		GenericMutableMaskAccessor::GenericMutableMaskAccessor(const core::GeometricInfo& aGeometricInfo) :
-			_geoInfo(aGeometricInfo), _spRelevantVoxelVector(MaskVoxelListPointer())
+			_geoInfo(aGeometricInfo), _spRelevantVoxelVector(MaskVoxelListPointer()), _voxelIndex(aGeometricInfo),
+			_maskRevision(0)
 		{
 			//generate new structure set uid
 			boost::uuids::uuid id;
@@ -87,17 +88,12 @@ namespace rttb
 			//determine how a given voxel on the dose grid is masked
 			if (_spRelevantVoxelVector)
 			{
-				auto it = _spRelevantVoxelVector->begin();
+				const size_t position = _voxelIndex.find(*_spRelevantVoxelVector, aID);
 
-				while (it != _spRelevantVoxelVector->end())
+				if (position != MaskVoxelIndex::notFound)
 				{
-					if ((*it).getVoxelGridID() == aID)
-					{
-						voxel = (*it);
-						return true;
-					}
-
-					++it;
+					voxel = (*_spRelevantVoxelVector)[position];
+					return true;
 				}
 
 				//aID is not in mask
@@ -134,21 +130,33 @@ namespace rttb
 			//determine how a given voxel on the dose grid is masked
 			if (_spRelevantVoxelVector)
 			{
-				auto it = _spRelevantVoxelVector->begin();
+				const size_t position = _voxelIndex.find(*_spRelevantVoxelVector, aID);
 
-				while (it != _spRelevantVoxelVector->end())
+				++_maskRevision;
+
+				if (position != MaskVoxelIndex::notFound)
 				{
-					if ((*it).getVoxelGridID() == aID)
+					(*_spRelevantVoxelVector)[position] = voxel;
+
+					if (voxel.getVoxelGridID() != aID)
 					{
-						(*it) = voxel;
-						return;
+						_voxelIndex.reset();
 					}
 
-					++it;
+					return;
 				}
 
-				//not sID is not found in existing voxels
+				//aID is not found in existing voxels
 				_spRelevantVoxelVector->push_back(voxel);
+
+				if (voxel.getVoxelGridID() == aID)
+				{
+					_voxelIndex.addLastVoxel(*_spRelevantVoxelVector);
+				}
+				else
+				{
+					_voxelIndex.reset();
+				}
 			}
 		}
 
@@ -167,6 +175,8 @@ namespace rttb
 		void GenericMutableMaskAccessor::setRelevantVoxelVector(MaskVoxelListPointer aVoxelListPointer)
 		{
 			_spRelevantVoxelVector = MaskVoxelListPointer(aVoxelListPointer);
+			_voxelIndex.reset();
+			++_maskRevision;
 		}
 
 	}
@@ -19,6 +19,7 @@
 #include "rttbMutableMaskAccessorInterface.h"
 #include "rttbBaseType.h"
 #include "rttbGeometricInfo.h"
+#include "rttbMaskVoxelIndex.h"
 
 namespace rttb
 {
@@ -26,6 +27,8 @@ namespace rttb
 	{
 		/*! @class GenericMutableMaskAccessor
 		@brief Default implementation of MutableMaskAccessorInterface.
+		@details getMaskAt() and setMaskAt() use a MaskVoxelIndex on the voxel list, so the list should only be changed through this
+		accessor (or set again with setRelevantVoxelVector()).
 		@see MutableMaskAccessorInterface
 		*/
 		class GenericMutableMaskAccessor: public core::MutableMaskAccessorInterface
@@ -40,8 +43,14 @@ namespace rttb
 			/*! vector containing list of mask voxels*/
 			MaskVoxelListPointer _spRelevantVoxelVector;
 
+			/*! random access to _spRelevantVoxelVector for getMaskAt() and setMaskAt()*/
+			MaskVoxelIndex _voxelIndex;
+
 			IDType _maskUID;
 
+			/*! incremented by every change of the relevant voxels, see getMaskRevision()*/
+			std::size_t _maskRevision;
+
 			GenericMutableMaskAccessor(const
 			                           GenericMutableMaskAccessor&) = delete; //not implemented on purpose -> non-copyable
 			GenericMutableMaskAccessor& operator=(const
@@ -89,6 +98,11 @@ namespace rttb
 				return _maskUID;
 			};
 
+			std::size_t getMaskRevision() const override
+			{
+				return _maskRevision;
+			};
+
 
 			void setMaskAt(VoxelGridID aID, const core::MaskVoxel& voxel) override;
 
@@ -0,0 +1,253 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include "rttbMaskVoxelIndex.h"
+
+#include <algorithm>
+
+namespace rttb
+{
+	namespace masks
+	{
+		const size_t MaskVoxelIndex::notFound;
+		const double MaskVoxelIndex::denseFillRatio = 0.125;
+
+		MaskVoxelIndex::MaskVoxelIndex() :
+			_numberOfColumns(0), _numberOfRows(0), _indexedListSize(0), _isDense(false), _minIndex{ 0, 0, 0 }, _size{ 0, 0, 0 }
+		{
+		}
+
+		MaskVoxelIndex::MaskVoxelIndex(const core::GeometricInfo& aGeometricInfo) :
+			_numberOfColumns(aGeometricInfo.getNumColumns()), _numberOfRows(aGeometricInfo.getNumRows()),
+			_indexedListSize(0), _isDense(false), _minIndex{ 0, 0, 0 }, _size{ 0, 0, 0 }
+		{
+		}
+
+		MaskVoxelIndex::MaskVoxelIndex(const MaskVoxelIndex& anIndex) :
+			_numberOfColumns(anIndex._numberOfColumns), _numberOfRows(anIndex._numberOfRows),
+			_indexedListSize(0), _isDense(false), _minIndex{ 0, 0, 0 }, _size{ 0, 0, 0 }
+		{
+		}
+
+		MaskVoxelIndex& MaskVoxelIndex::operator=(const MaskVoxelIndex& anIndex)
+		{
+			if (this != &anIndex)
+			{
+				_numberOfColumns = anIndex._numberOfColumns;
+				_numberOfRows = anIndex._numberOfRows;
+				reset();
+			}
+
+			return *this;
+		}
+
+		size_t MaskVoxelIndex::find(const MaskVoxelList& aVoxelList, VoxelGridID aID) const
+		{
+			if (_indexedListSize.load(std::memory_order_acquire) != aVoxelList.size() + 1)
+			{
+				std::lock_guard<std::mutex> lock(_buildMutex);
+
+				if (_indexedListSize.load(std::memory_order_relaxed) != aVoxelList.size() + 1)
+				{
+					build(aVoxelList);
+					_indexedListSize.store(aVoxelList.size() + 1, std::memory_order_release);
+				}
+			}
+
+			if (_isDense)
+			{
+				const size_t offset = getDenseOffset(aID);
+
+				if (offset != notFound && _densePositions[offset] != 0)
+				{
+					return _densePositions[offset] - 1;
+				}
+			}
+			else
+			{
+				auto it = std::lower_bound(_sortedPositions.begin(), _sortedPositions.end(), IDPosition(aID, 0));
+
+				if (it != _sortedPositions.end() && it->first == aID)
+				{
+					return it->second;
+				}
+			}
+
+			if (!_addedPositions.empty())
+			{
+				auto it = _addedPositions.find(aID);
+
+				if (it != _addedPositions.end())
+				{
+					return it->second;
+				}
+			}
+
+			return notFound;
+		}
+
+		void MaskVoxelIndex::addLastVoxel(const MaskVoxelList& aVoxelList)
+		{
+			//only an up to date index can be extended, otherwise it is built again by the next find()
+			if (aVoxelList.empty() || _indexedListSize.load(std::memory_order_relaxed) != aVoxelList.size())
+			{
+				return;
+			}
+
+			const size_t position = aVoxelList.size() - 1;
+			const VoxelGridID id = aVoxelList.back().getVoxelGridID();
+			const size_t offset = _isDense ? getDenseOffset(id) : notFound;
+
+			if (offset != notFound && position < std::numeric_limits<std::uint32_t>::max())
+			{
+				_densePositions[offset] = static_cast<std::uint32_t>(position + 1);
+			}
+			else
+			{
+				_addedPositions.insert(std::make_pair(id, position));
+			}
+
+			_indexedListSize.store(aVoxelList.size() + 1, std::memory_order_relaxed);
+		}
+
+		void MaskVoxelIndex::reset()
+		{
+			_indexedListSize.store(0, std::memory_order_relaxed);
+		}
+
+		bool MaskVoxelIndex::isDense() const
+		{
+			return _isDense;
+		}
+
+		void MaskVoxelIndex::build(const MaskVoxelList& aVoxelList) const
+		{
+			_densePositions.clear();
+			_sortedPositions.clear();
+			_addedPositions.clear();
+			_isDense = false;
+
+			//bounding box of the voxels
+			const size_t sliceSize = static_cast<size_t>(_numberOfColumns) * _numberOfRows;
+			unsigned int maxIndex[3] = { 0, 0, 0 };
+			size_t numberOfValidVoxels = 0;
+
+			if (sliceSize > 0)
+			{
+				_minIndex[0] = _minIndex[1] = _minIndex[2] = std::numeric_limits<unsigned int>::max();
+
+				for (const auto& voxel : aVoxelList)
+				{
+					const VoxelGridID id = voxel.getVoxelGridID();
+
+					if (id < 0)
+					{
+						continue;
+					}
+
+					const unsigned int index[3] = { static_cast<unsigned int>(id % _numberOfColumns),
+					                                static_cast<unsigned int>((id / _numberOfColumns) % _numberOfRows),
+					                                static_cast<unsigned int>(id / sliceSize)
+					                              };
+
+					for (unsigned int i = 0; i < 3; ++i)
+					{
+						_minIndex[i] = std::min(_minIndex[i], index[i]);
+						maxIndex[i] = std::max(maxIndex[i], index[i]);
+					}
+
+					++numberOfValidVoxels;
+				}
+			}
+
+			if (numberOfValidVoxels > 0 && aVoxelList.size() < std::numeric_limits<std::uint32_t>::max())
+			{
+				size_t boundingBoxSize = 1;
+
+				for (unsigned int i = 0; i < 3; ++i)
+				{
+					_size[i] = maxIndex[i] - _minIndex[i] + 1;
+					boundingBoxSize *= _size[i];
+				}
+
+				_isDense = numberOfValidVoxels >= denseFillRatio * boundingBoxSize;
+
+				if (_isDense)
+				{
+					_densePositions.assign(boundingBoxSize, 0);
+				}
+			}
+
+			if (_isDense)
+			{
+				for (size_t position = 0; position < aVoxelList.size(); ++position)
+				{
+					const size_t offset = getDenseOffset(aVoxelList[position].getVoxelGridID());
+
+					if (offset != notFound && _densePositions[offset] == 0)
+					{
+						_densePositions[offset] = static_cast<std::uint32_t>(position + 1);
+					}
+				}
+			}
+			else
+			{
+				_sortedPositions.reserve(aVoxelList.size());
+
+				for (size_t position = 0; position < aVoxelList.size(); ++position)
+				{
+					_sortedPositions.push_back(IDPosition(aVoxelList[position].getVoxelGridID(), position));
+				}
+
+				//sorted by ID and position, so the first voxel of an ID is kept
+				std::sort(_sortedPositions.begin(), _sortedPositions.end());
+				_sortedPositions.erase(std::unique(_sortedPositions.begin(), _sortedPositions.end(),
+				                                   [](const IDPosition& a, const IDPosition& b)
+				{
+					return a.first == b.first;
+				}), _sortedPositions.end());
+			}
+		}
+
+		size_t MaskVoxelIndex::getDenseOffset(VoxelGridID aID) const
+		{
+			if (aID < 0)
+			{
+				return notFound;
+			}
+
+			const size_t sliceSize = static_cast<size_t>(_numberOfColumns) * _numberOfRows;
+			const size_t x = static_cast<size_t>(aID) % _numberOfColumns;
+			const size_t y = (static_cast<size_t>(aID) / _numberOfColumns) % _numberOfRows;
+			const size_t z = static_cast<size_t>(aID) / sliceSize;
+
+			if (x < _minIndex[0] || y < _minIndex[1] || z < _minIndex[2])
+			{
+				return notFound;
+			}
+
+			const size_t offsetX = x - _minIndex[0];
+			const size_t offsetY = y - _minIndex[1];
+			const size_t offsetZ = z - _minIndex[2];
+
+			if (offsetX >= _size[0] || offsetY >= _size[1] || offsetZ >= _size[2])
+			{
+				return notFound;
+			}
+
+			return (offsetZ * _size[1] + offsetY) * _size[0] + offsetX;
+		}
+	}
+}
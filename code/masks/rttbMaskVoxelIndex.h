@@ -0,0 +1,111 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __MASK_VOXEL_INDEX_H
+#define __MASK_VOXEL_INDEX_H
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "rttbBaseType.h"
+#include "rttbGeometricInfo.h"
+#include "rttbMaskAccessorInterface.h"
+
+#include "RTTBMaskExports.h"
+
+namespace rttb
+{
+	namespace masks
+	{
+		/*! @class MaskVoxelIndex
+		@brief Random access to the voxels of a mask voxel list by their voxel grid ID, used by the getMaskAt() of the mask accessors.
+		@details The index is built lazily by the first find() and again whenever the size of the list changed. Depending on the fill
+		ratio of the bounding box of the voxels, it is either a dense volume over the bounding box holding the position of each voxel in
+		the list (constant time), or a vector of IDs and positions sorted by ID (binary search). Voxels appended to the list later that are
+		not covered by the dense volume are held in an additional hash map.
+		Like a linear search in the list, find() returns the first voxel if an ID appears several times.
+		find() may be called concurrently, the other methods must not be called concurrently with any method.
+		*/
+		class RTTBMask_EXPORT MaskVoxelIndex
+		{
+		public:
+			using MaskVoxelList = core::MaskAccessorInterface::MaskVoxelList;
+
+			/*! returned by find() if the ID is not in the list*/
+			static const size_t notFound = std::numeric_limits<size_t>::max();
+
+			/*! the dense volume is used if at least this fraction of the bounding box voxels are in the list*/
+			static const double denseFillRatio;
+
+			/*! @brief Index without geometry, only the sorted vector is used*/
+			MaskVoxelIndex();
+			explicit MaskVoxelIndex(const core::GeometricInfo& aGeometricInfo);
+
+			/*! @brief Copies the geometry only, the copy is built again by its first find()*/
+			MaskVoxelIndex(const MaskVoxelIndex& anIndex);
+			MaskVoxelIndex& operator=(const MaskVoxelIndex& anIndex);
+
+			/*! @brief Returns the position of the (first) voxel with the ID aID in aVoxelList.
+			@details Builds the index if it is not built yet or if the size of aVoxelList changed since it was built.
+			@return notFound if there is no voxel with aID
+			*/
+			size_t find(const MaskVoxelList& aVoxelList, VoxelGridID aID) const;
+
+			/*! @brief Adds the last voxel of aVoxelList to the index, after it was appended to the list.
+			@pre there was no voxel with the same ID in the list before
+			*/
+			void addLastVoxel(const MaskVoxelList& aVoxelList);
+
+			/*! @brief Discards the index, e.g. because the voxel list was replaced. It is built again by the next find().*/
+			void reset();
+
+			/*! @brief If the index uses the dense volume (only valid after the first find())*/
+			bool isDense() const;
+
+		private:
+			using IDPosition = std::pair<VoxelGridID, size_t>;
+
+			VoxelGridDimensionType _numberOfColumns;
+			VoxelGridDimensionType _numberOfRows;
+
+			mutable std::mutex _buildMutex;
+			/*! size of the indexed voxel list + 1, 0 if the index is not built*/
+			mutable std::atomic<size_t> _indexedListSize;
+
+			mutable bool _isDense;
+			/*! bounding box of the voxels in grid indices (dense volume only)*/
+			mutable unsigned int _minIndex[3];
+			mutable unsigned int _size[3];
+			/*! position + 1 of the voxel in the list for each voxel of the bounding box, 0 if it is not in the list*/
+			mutable std::vector<std::uint32_t> _densePositions;
+			/*! IDs and positions of the voxels sorted by ID, the first position for each ID (sparse index only)*/
+			mutable std::vector<IDPosition> _sortedPositions;
+			/*! positions of appended voxels not covered by the dense volume or the sorted vector*/
+			mutable std::unordered_map<VoxelGridID, size_t> _addedPositions;
+
+			void build(const MaskVoxelList& aVoxelList) const;
+
+			/*! @brief Position in the dense volume or notFound if the ID is outside of the bounding box*/
+			size_t getDenseOffset(VoxelGridID aID) const;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,87 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include "rttbMonotonicArena.h"
+
+#include <algorithm>
+
+namespace rttb
+{
+	namespace masks
+	{
+		namespace boost
+		{
+			namespace
+			{
+				thread_local MonotonicArena* currentArena = nullptr;
+			}
+
+			MonotonicArena::Scope::Scope(MonotonicArena& anArena) : _previousArena(currentArena)
+			{
+				currentArena = &anArena;
+			}
+
+			MonotonicArena::Scope::~Scope()
+			{
+				currentArena = _previousArena;
+			}
+
+			MonotonicArena::MonotonicArena(std::size_t blockSize) : _blockSize(blockSize), _currentBlock(0), _offset(0)
+			{
+			}
+
+			void* MonotonicArena::allocate(std::size_t bytes, std::size_t alignment)
+			{
+				while (_currentBlock < _blocks.size())
+				{
+					Block& block = _blocks[_currentBlock];
+					const auto address = reinterpret_cast<std::size_t>(block.memory.get()) + _offset;
+					const std::size_t padding = (alignment - address % alignment) % alignment;
+
+					if (_offset + padding + bytes <= block.size)
+					{
+						_offset += padding + bytes;
+						return block.memory.get() + (_offset - bytes);
+					}
+
+					++_currentBlock;
+					_offset = 0;
+				}
+
+				//no space left in the existing blocks
+				Block newBlock;
+				newBlock.size = std::max(_blockSize, bytes + alignment);
+				newBlock.memory.reset(new char[newBlock.size]);
+				_blocks.push_back(std::move(newBlock));
+				_currentBlock = _blocks.size() - 1;
+				_offset = 0;
+
+				return allocate(bytes, alignment);
+			}
+
+			void MonotonicArena::release()
+			{
+				_currentBlock = 0;
+				_offset = 0;
+			}
+
+			MonotonicArena* MonotonicArena::getCurrent()
+			{
+				return currentArena;
+			}
+
+		}
+	}
+}
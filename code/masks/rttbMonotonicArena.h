@@ -0,0 +1,144 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __MONOTONIC_ARENA_H
+#define __MONOTONIC_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace rttb
+{
+	namespace masks
+	{
+		namespace boost
+		{
+			/*! @class MonotonicArena
+			*   @brief Monotonic memory arena for short living temporaries of a single thread.
+			*   @details Memory is handed out from large blocks and is never freed individually. release() rewinds the arena
+			*   so the blocks are reused by the next allocations (e.g. for the next slice), the blocks themselves are only freed on destruction.
+			*   An arena is not thread-safe, each thread uses its own one. ArenaAllocator instances that are default constructed
+			*   allocate from the arena that is current for the calling thread (see Scope).
+			*/
+			class MonotonicArena
+			{
+			public:
+				/*! @brief Sets an arena as the current arena of the calling thread as long as the scope exists.*/
+				class Scope
+				{
+				public:
+					explicit Scope(MonotonicArena& anArena);
+					~Scope();
+
+					Scope(const Scope&) = delete;
+					Scope& operator=(const Scope&) = delete;
+
+				private:
+					MonotonicArena* _previousArena;
+				};
+
+				/*! @param blockSize size of the memory blocks in bytes. Bigger requests get a block of their own.*/
+				explicit MonotonicArena(std::size_t blockSize = 64 * 1024);
+
+				MonotonicArena(const MonotonicArena&) = delete;
+				MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+				void* allocate(std::size_t bytes, std::size_t alignment);
+
+				/*! @brief Makes all memory of the arena available again.
+				* @pre No object allocated from the arena is in use anymore.
+				*/
+				void release();
+
+				/*! @return the arena that is current for the calling thread, nullptr if there is none*/
+				static MonotonicArena* getCurrent();
+
+			private:
+				struct Block
+				{
+					std::unique_ptr<char[]> memory;
+					std::size_t size;
+				};
+
+				std::vector<Block> _blocks;
+				std::size_t _blockSize;
+				std::size_t _currentBlock;
+				std::size_t _offset;
+			};
+
+			/*! @class ArenaAllocator
+			*   @brief STL allocator that takes its memory from a MonotonicArena.
+			*   @details deallocate() is a no-op for arena memory, the memory is reclaimed by MonotonicArena::release().
+			*   Without arena (no current arena of the thread on construction) the allocator behaves like std::allocator.
+			*/
+			template <typename T>
+			class ArenaAllocator
+			{
+			public:
+				using value_type = T;
+
+				ArenaAllocator() : _arena(MonotonicArena::getCurrent()) {}
+
+				explicit ArenaAllocator(MonotonicArena* anArena) : _arena(anArena) {}
+
+				template <typename U>
+				ArenaAllocator(const ArenaAllocator<U>& anAllocator) : _arena(anAllocator.getArena()) {}
+
+				T* allocate(std::size_t n)
+				{
+					if (_arena)
+					{
+						return static_cast<T*>(_arena->allocate(n * sizeof(T), alignof(T)));
+					}
+
+					return static_cast<T*>(::operator new(n * sizeof(T)));
+				}
+
+				void deallocate(T* p, std::size_t)
+				{
+					if (!_arena)
+					{
+						::operator delete(p);
+					}
+				}
+
+				MonotonicArena* getArena() const
+				{
+					return _arena;
+				}
+
+			private:
+				MonotonicArena* _arena;
+			};
+
+			template <typename T, typename U>
+			bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b)
+			{
+				return a.getArena() == b.getArena();
+			}
+
+			template <typename T, typename U>
+			bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b)
+			{
+				return !(a == b);
+			}
+
+		}
+	}
+}
+
+#endif
@@ -40,6 +40,7 @@ namespace rttb
 		/*! @brief BinaryFunctorAccessorTest - tests functors of two accessors
 				1) test constructor
 				2) test getDoseAt
+				3) test bulk access
 			*/
 
 		int BinaryFunctorAccessorTest(int argc, char* argv[])
@@ -119,6 +120,31 @@ namespace rttb
 			CHECK_EQUAL(spBinaryFunctorDoseAccessorAddWeighted->getValueAt(aIdInvalid), -1.0);
 			CHECK_EQUAL(spBinaryFunctorDoseAccessorAddWeighted->getValueAt(aIndexInvalid), -1.0);
 
+			//3) Test bulk access
+			const unsigned int numberOfColumns = spBinaryFunctorDoseAccessorAdd->getGeometricInfo().getNumColumns();
+			std::vector<GenericValueType> rowValues(numberOfColumns);
+			std::vector<GenericValueType> operandValues(numberOfColumns);
+			CHECK_NO_THROW(spBinaryFunctorDoseAccessorAddWeighted->getRowValues(1, 2, rowValues.data()));
+			CHECK_NO_THROW(spDoseAccessor->getRowValues(1, 2, operandValues.data()));
+
+			for (unsigned int i = 0; i < numberOfColumns; ++i)
+			{
+				const VoxelGridID id = (2 * spBinaryFunctorDoseAccessorAdd->getGeometricInfo().getNumRows() + 1) * numberOfColumns + i;
+				CHECK_EQUAL(rowValues[i], spBinaryFunctorDoseAccessorAddWeighted->getValueAt(id));
+				CHECK_EQUAL(operandValues[i], spDoseAccessor->getValueAt(id));
+			}
+
+			std::vector<GenericValueType> gatheredValues(3);
+			CHECK_NO_THROW(spBinaryFunctorDoseAccessorAdd->gatherValues(aId, 3, gatheredValues.data()));
+
+			for (int i = 0; i < 3; ++i)
+			{
+				CHECK_EQUAL(gatheredValues[i], spBinaryFunctorDoseAccessorAdd->getValueAt(aId[i]));
+			}
+
+			CHECK_THROW_EXPLICIT(spBinaryFunctorDoseAccessorAdd->getValues(lastIndex, 2, gatheredValues.data()),
+			                     core::IndexOutOfBoundsException);
+
 			RETURN_AND_REPORT_TEST_SUCCESS;
 		}
 	}
@@ -13,6 +13,8 @@
 //
 //------------------------------------------------------------------------
 
+#include <algorithm>
+
 #include <boost/make_shared.hpp>
 #include <boost/shared_ptr.hpp>
 
@@ -23,9 +25,11 @@
 #include "rttbDoseIteratorInterface.h"
 #include "rttbNullPointerException.h"
 #include "rttbDoseStatisticsCalculator.h"
+#include "rttbDVHCalculator.h"
 #include "rttbInvalidDoseException.h"
 #include "rttbInvalidParameterException.h"
 #include "rttbDataNotAvailableException.h"
+#include "rttbThreadPool.h"
 
 #include "rttbDicomFileDoseAccessorGenerator.h"
 #include "rttbDicomFileStructureSetGenerator.h"
@@ -51,6 +55,7 @@ namespace rttb
 			2) test setDoseIterator
 			3) test calculateDoseSatistics
 			4) get statistical values
+			5) test the DVH calculated together with the statistics
 		*/
 
 		int DoseStatisticsCalculatorTest(int argc, char* argv[])
@@ -70,6 +75,9 @@ namespace rttb
 
 			DoseIteratorPointer spDoseIteratorNull;
 
+			//compute in parallel, also on machines with one core
+			CHECK_NO_THROW(core::ThreadPool::setConcurrency(4));
+
 			if (argc > 3)
 			{
 				referenceXMLFilename = argv[1];
@@ -120,6 +128,49 @@ namespace rttb
 			CHECK_NO_THROW(theStatisticsDefault->getDx().getValue(0.95 * theStatisticsDefault->getVolume()));
 			CHECK_NO_THROW(theStatisticsDefault->getDx().getValue(0.98 * theStatisticsDefault->getVolume()));
 
+			//the concurrently computed values are the same as the sequentially computed ones
+			rttb::algorithms::DoseStatisticsCalculator mySequentialDoseStatsCalculator(spDoseIterator);
+			DoseStatisticsPointer theStatisticsSequential = mySequentialDoseStatsCalculator.calculateDoseStatistics(true);
+			CHECK(theStatisticsDefault->getVx().getAllValues() == theStatisticsSequential->getVx().getAllValues());
+			CHECK(theStatisticsDefault->getDx().getAllValues() == theStatisticsSequential->getDx().getAllValues());
+			CHECK(theStatisticsDefault->getMOHx().getAllValues() == theStatisticsSequential->getMOHx().getAllValues());
+			CHECK(theStatisticsDefault->getMOCx().getAllValues() == theStatisticsSequential->getMOCx().getAllValues());
+			CHECK(theStatisticsDefault->getMaxOHx().getAllValues() == theStatisticsSequential->getMaxOHx().getAllValues());
+			CHECK(theStatisticsDefault->getMinOCx().getAllValues() == theStatisticsSequential->getMinOCx().getAllValues());
+
+			//the complex statistics can be computed for any x from the sorted dose values, the same as precomputed
+			CHECK(theStatisticsSequential->hasSampleStore());
+
+			for (const auto& vx : theStatisticsSequential->getVx().getAllValues())
+			{
+				CHECK_EQUAL(theStatisticsSequential->computeVx(vx.first), vx.second);
+			}
+
+			for (const auto& dx : theStatisticsSequential->getDx().getAllValues())
+			{
+				CHECK_EQUAL(theStatisticsSequential->computeDx(dx.first), dx.second);
+				CHECK_EQUAL(theStatisticsSequential->computeMOHx(dx.first), theStatisticsSequential->getMOHx().getValue(dx.first));
+				CHECK_EQUAL(theStatisticsSequential->computeMOCx(dx.first), theStatisticsSequential->getMOCx().getValue(dx.first));
+				CHECK_EQUAL(theStatisticsSequential->computeMaxOHx(dx.first), theStatisticsSequential->getMaxOHx().getValue(dx.first));
+				CHECK_EQUAL(theStatisticsSequential->computeMinOCx(dx.first), theStatisticsSequential->getMinOCx().getValue(dx.first));
+			}
+
+			CHECK_THROW_EXPLICIT(theStatisticsSequential->getDx().getValue(0.33 * theStatisticsSequential->getVolume()),
+				core::DataNotAvailableException);
+			CHECK_NO_THROW(theStatisticsSequential->computeDx(0.33 * theStatisticsSequential->getVolume()));
+			CHECK_CLOSE(theStatisticsSequential->computeVx(theStatisticsSequential->getMinimum()),
+				theStatisticsSequential->getVolume(), errorConstant);
+			CHECK_EQUAL(theStatisticsSequential->computeVx(theStatisticsSequential->getMaximum() + 1), 0);
+			//the voxels receiving exactly x are part of Vx
+			CHECK(theStatisticsSequential->computeVx(theStatisticsSequential->getMaximum()) > 0);
+
+			theStatisticsSequential->releaseSampleStore();
+			CHECK(!theStatisticsSequential->hasSampleStore());
+			CHECK_THROW_EXPLICIT(theStatisticsSequential->computeVx(0.33 * theStatisticsSequential->getMaximum()),
+				core::DataNotAvailableException);
+			CHECK_THROW_EXPLICIT(theStatisticsSequential->computeMinOCx(0.33 * theStatisticsSequential->getVolume()),
+				core::DataNotAvailableException);
+
 			//check manually set reference dose and the default x values
 			CHECK_NO_THROW(theStatistics = myDoseStatsCalculator.calculateDoseStatistics(100.0));
 			CHECK_THROW_EXPLICIT(theStatistics->getVx().getValue(0.1 * theStatistics->getMaximum()),
@@ -294,6 +345,18 @@ namespace rttb
 				CHECK_EQUAL(minimaPositionsIterator->first, theStatistics->getMinimum());
 			}
 
+			//Vx is computed from the sorted dose values, compare with counting the voxels
+			const VolumeType voxelVolume = theStatistics->getVolume() / theStatistics->getNumberOfVoxels();
+
+			for (const auto& vx : theStatistics->getVx().getAllValues())
+			{
+				const auto numberOfVoxelsVx = std::count_if(doseVals->begin(), doseVals->end(), [&vx](DoseTypeGy dose)
+				{
+					return dose >= vx.first;
+				});
+				CHECK_CLOSE(vx.second, numberOfVoxelsVx * voxelVolume, errorConstant);
+			}
+
 
 			//generate specific example dose
 			maximum = 9.5;
@@ -349,6 +412,52 @@ namespace rttb
 				CHECK_EQUAL(minimaPositionsIterator->first, theStatistics3->getMinimum());
 			}
 
+			//the first positions in iteration order are stored (the first voxel was a minimum candidate too)
+			CHECK_EQUAL(maximaPositions->size(), 10);
+			CHECK_EQUAL(minimaPositions->size(), 10);
+
+			for (size_t i = 0; i < std::min<size_t>(10, std::min(maximaPositions->size(), minimaPositions->size())); ++i)
+			{
+				CHECK_EQUAL(maximaPositions->at(i).second, 2 * i);
+				CHECK_EQUAL(minimaPositions->at(i).second, 2 * i + 1);
+			}
+
+			//5) test the DVH calculated together with the statistics
+			CHECK(!myDoseStatsCalculator2.getDVH());
+			CHECK_THROW_EXPLICIT(myDoseStatsCalculator2.enableDVHCalculation("struct", "dose", -1),
+				core::InvalidParameterException);
+			CHECK_THROW_EXPLICIT(myDoseStatsCalculator2.enableDVHCalculation("struct", "dose", 0, 0),
+				core::InvalidParameterException);
+
+			for (DoseIteratorPointer aDoseIterator : { spDoseIterator, spDoseIterator2 })
+			{
+				rttb::algorithms::DoseStatisticsCalculator dvhDoseStatsCalculator(aDoseIterator);
+				CHECK_NO_THROW(dvhDoseStatsCalculator.enableDVHCalculation("struct", "dose"));
+				CHECK_NO_THROW(dvhDoseStatsCalculator.calculateDoseStatistics(true));
+				core::DVH::Pointer dvh = dvhDoseStatsCalculator.getDVH();
+				CHECK(dvh);
+
+				core::DVH::Pointer expectedDVH = core::DVHCalculator(aDoseIterator, "struct", "dose").generateDVH();
+				CHECK_EQUAL(dvh->getDeltaD(), expectedDVH->getDeltaD());
+				CHECK_EQUAL(dvh->getDeltaV(), expectedDVH->getDeltaV());
+				CHECK_EQUAL(dvh->getStructureID(), expectedDVH->getStructureID());
+				CHECK_EQUAL(dvh->getDoseID(), expectedDVH->getDoseID());
+				const core::DVH::DataDifferentialType dataDifferential = dvh->getDataDifferential();
+				const core::DVH::DataDifferentialType expectedDataDifferential = expectedDVH->getDataDifferential();
+				CHECK_EQUAL(dataDifferential.size(), expectedDataDifferential.size());
+
+				for (size_t i = 0; i < std::min(dataDifferential.size(), expectedDataDifferential.size()); ++i)
+				{
+					CHECK_CLOSE(dataDifferential[i], expectedDataDifferential[i], errorConstant);
+				}
+			}
+
+			//too few bins for the maximum dose
+			rttb::algorithms::DoseStatisticsCalculator tooFewBinsDoseStatsCalculator(spDoseIterator2);
+			tooFewBinsDoseStatsCalculator.enableDVHCalculation("struct", "dose", 1, 5);
+			CHECK_THROW_EXPLICIT(tooFewBinsDoseStatsCalculator.calculateDoseStatistics(),
+				core::InvalidParameterException);
+
 			// compare with actual XML
 			io::dicom::DicomFileDoseAccessorGenerator doseAccessorGenerator(doseFilename.c_str());
 			core::DoseAccessorInterface::Pointer doseAccessorPointer(doseAccessorGenerator.generateDoseAccessor());
@@ -0,0 +1,160 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+
+#include <vector>
+
+#include <boost/make_shared.hpp>
+
+#include "litCheckMacros.h"
+
+#include "rttbBaseType.h"
+#include "rttbSortedDoseSampleStore.h"
+#include "rttbInvalidParameterException.h"
+
+namespace rttb
+{
+	namespace testing
+	{
+
+		/*! @brief SortedDoseSampleStoreTest - tests the binary search of SortedDoseSampleStore against summing up the voxels one by one
+			1) test constructor
+			2) test Vx
+			3) test Dx, MOHx, MOCx, MaxOHx and MinOCx
+			4) test empty store
+		*/
+		int SortedDoseSampleStoreTest(int argc, char* argv[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			//sorted doses with repeated values, partial and empty voxel proportions
+			std::vector<DoseTypeGy> doseVector;
+			std::vector<double> voxelProportionVector;
+
+			for (unsigned int i = 0; i < 200; ++i)
+			{
+				doseVector.push_back(0.1 * (i / 3));
+				voxelProportionVector.push_back((i % 7 == 0) ? 0 : ((i % 5 == 0) ? 0.25 : 1));
+			}
+
+			const DoseVoxelVolumeType voxelVolume = 0.5;
+			const DoseStatisticType minimum = doseVector.front();
+			const DoseStatisticType maximum = doseVector.back();
+
+			//1) test constructor
+			CHECK_THROW_EXPLICIT(algorithms::SortedDoseSampleStore(doseVector, std::vector<double>(3, 1), voxelVolume),
+			                     core::InvalidParameterException);
+			algorithms::SortedDoseSampleStore store(doseVector, voxelProportionVector, voxelVolume);
+			CHECK_EQUAL(store.size(), doseVector.size());
+			CHECK(store.getDoseVector() == doseVector);
+			CHECK(store.getVoxelProportionVector() == voxelProportionVector);
+			CHECK_EQUAL(store.getVoxelVolume(), voxelVolume);
+			CHECK(store.getMemorySize() >= doseVector.size() * (sizeof(DoseTypeGy) + sizeof(double)));
+
+			//2) test Vx, the stored doses are found by themselves
+			std::vector<DoseTypeGy> xDoses = doseVector;
+
+			for (DoseTypeGy xDose = -0.05; xDose < 7.5; xDose += 0.05)
+			{
+				xDoses.push_back(xDose);
+			}
+
+			for (DoseTypeGy xDose : xDoses)
+			{
+				double countVoxels = 0;
+
+				for (size_t i = 0; i < doseVector.size(); ++i)
+				{
+					if (doseVector[i] >= xDose)
+					{
+						countVoxels += voxelProportionVector[i];
+					}
+				}
+
+				CHECK_CLOSE(store.computeVx(xDose), countVoxels * voxelVolume, errorConstant);
+			}
+
+			//3) test the volume based statistics, summed up voxel by voxel from the top/from the bottom
+			double totalVoxels = 0;
+
+			for (double voxelProportion : voxelProportionVector)
+			{
+				totalVoxels += voxelProportion;
+			}
+
+			for (double noOfVoxel = 0; noOfVoxel < totalVoxels + 3; noOfVoxel += 0.75)
+			{
+				const VolumeType xVolume = noOfVoxel * voxelVolume;
+
+				DoseTypeGy expectedDx = minimum;
+				DoseTypeGy expectedMaxOHx = 0;
+				double countVoxels = 0;
+				double sum = 0;
+
+				for (auto i = doseVector.size() - 1; i != static_cast<size_t>(-1); i--)
+				{
+					countVoxels += voxelProportionVector[i];
+					sum += doseVector[i] * voxelProportionVector[i];
+
+					if (countVoxels >= noOfVoxel)
+					{
+						expectedDx = doseVector[i];
+						expectedMaxOHx = (i > 0) ? doseVector[i - 1] : 0;
+						break;
+					}
+				}
+
+				const DoseTypeGy expectedMOHx = (noOfVoxel == 0) ? 0 : sum / noOfVoxel;
+
+				DoseTypeGy expectedMinOCx = minimum;
+				countVoxels = 0;
+				sum = 0;
+
+				for (size_t i = 0; i < doseVector.size(); ++i)
+				{
+					countVoxels += voxelProportionVector[i];
+					sum += doseVector[i] * voxelProportionVector[i];
+
+					if (countVoxels >= noOfVoxel)
+					{
+						expectedMinOCx = (i + 1 < doseVector.size()) ? doseVector[i + 1] : maximum;
+						break;
+					}
+				}
+
+				const DoseTypeGy expectedMOCx = (noOfVoxel == 0) ? 0 : sum / noOfVoxel;
+
+				CHECK_EQUAL(store.computeDx(xVolume, minimum), expectedDx);
+				CHECK_EQUAL(store.computeMaxOHx(xVolume), expectedMaxOHx);
+				CHECK_CLOSE(store.computeMOHx(xVolume), expectedMOHx, errorConstant);
+				CHECK_CLOSE(store.computeMOCx(xVolume), expectedMOCx, errorConstant);
+				CHECK_EQUAL(store.computeMinOCx(xVolume, minimum, maximum), expectedMinOCx);
+			}
+
+			//4) test empty store
+			algorithms::SortedDoseSampleStore emptyStore(std::vector<DoseTypeGy>(), std::vector<double>(), voxelVolume);
+			CHECK_EQUAL(emptyStore.size(), 0);
+			CHECK_EQUAL(emptyStore.computeVx(0), 0);
+			CHECK_EQUAL(emptyStore.computeDx(1, 2), 2);
+			CHECK_EQUAL(emptyStore.computeMOHx(1), 0);
+			CHECK_EQUAL(emptyStore.computeMOCx(1), 0);
+			CHECK_EQUAL(emptyStore.computeMaxOHx(1), 0);
+			CHECK_EQUAL(emptyStore.computeMinOCx(1, 2, 3), 2);
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+
+	}//testing
+}//rttb
@@ -1,6 +1,7 @@
 SET(CPP_FILES 
 	DoseStatisticsTest.cpp
 	DoseStatisticsCalculatorTest.cpp
+	SortedDoseSampleStoreTest.cpp
 	ArithmeticTest.cpp
 	BinaryFunctorAccessorTest.cpp
 	rttbAlgorithmsTests.cpp
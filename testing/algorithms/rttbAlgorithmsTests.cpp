@@ -31,6 +31,7 @@ namespace rttb
 		{
 			LIT_REGISTER_TEST(DoseStatisticsTest);
 			LIT_REGISTER_TEST(DoseStatisticsCalculatorTest);
+			LIT_REGISTER_TEST(SortedDoseSampleStoreTest);
 			LIT_REGISTER_TEST(ArithmeticTest);
 			LIT_REGISTER_TEST(BinaryFunctorAccessorTest);
 		}
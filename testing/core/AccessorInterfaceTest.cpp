@@ -0,0 +1,104 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include <vector>
+
+#include <boost/make_shared.hpp>
+
+#include "litCheckMacros.h"
+
+#include "rttbBaseType.h"
+#include "rttbGeometricInfo.h"
+#include "rttbIndexOutOfBoundsException.h"
+#include "DummyDoseAccessor.h"
+
+namespace rttb
+{
+	namespace testing
+	{
+
+		/*! @brief AccessorInterfaceTest - test the bulk value access of AccessorInterface (default implementation)
+			1) test getValues
+			2) test getRowValues/getSliceValues
+			3) test gatherValues
+			4) test exceptions
+		*/
+		int AccessorInterfaceTest(int argc, char* argv[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			boost::shared_ptr<DummyDoseAccessor> spDoseAccessor = boost::make_shared<DummyDoseAccessor>();
+			const core::GeometricInfo& geoInfo = spDoseAccessor->getGeometricInfo();
+			const std::vector<DoseTypeGy>* doseVals = spDoseAccessor->getDoseVector();
+
+			const unsigned int numberOfColumns = geoInfo.getNumColumns();
+			const unsigned int sliceSize = numberOfColumns * geoInfo.getNumRows();
+			std::vector<GenericValueType> values(sliceSize, -1);
+
+			//1) test getValues
+			CHECK_NO_THROW(spDoseAccessor->getValues(17, 25, values.data()));
+
+			for (unsigned int i = 0; i < 25; ++i)
+			{
+				CHECK_EQUAL(values[i], doseVals->at(17 + i));
+			}
+
+			CHECK_EQUAL(values[25], -1);
+			CHECK_NO_THROW(spDoseAccessor->getValues(0, 0, nullptr));
+
+			//2) test getRowValues/getSliceValues
+			CHECK_NO_THROW(spDoseAccessor->getRowValues(3, 2, values.data()));
+
+			for (unsigned int i = 0; i < numberOfColumns; ++i)
+			{
+				CHECK_EQUAL(values[i], doseVals->at(2 * sliceSize + 3 * numberOfColumns + i));
+			}
+
+			const unsigned int lastSlice = geoInfo.getNumSlices() - 1;
+			CHECK_NO_THROW(spDoseAccessor->getSliceValues(lastSlice, values.data()));
+
+			for (unsigned int i = 0; i < sliceSize; ++i)
+			{
+				CHECK_EQUAL(values[i], doseVals->at(lastSlice * sliceSize + i));
+			}
+
+			//3) test gatherValues
+			const std::vector<VoxelGridID> ids = { 0, 5, 6, 100, static_cast<VoxelGridID>(doseVals->size() - 1) };
+			CHECK_NO_THROW(spDoseAccessor->gatherValues(ids.data(), ids.size(), values.data()));
+
+			for (size_t i = 0; i < ids.size(); ++i)
+			{
+				CHECK_EQUAL(values[i], doseVals->at(ids[i]));
+			}
+
+			//4) test exceptions
+			const VoxelGridID numberOfVoxels = static_cast<VoxelGridID>(geoInfo.getNumberOfVoxels());
+			CHECK_THROW_EXPLICIT(spDoseAccessor->getValues(-1, 2, values.data()), core::IndexOutOfBoundsException);
+			CHECK_THROW_EXPLICIT(spDoseAccessor->getValues(numberOfVoxels - 1, 2, values.data()),
+			                     core::IndexOutOfBoundsException);
+			CHECK_NO_THROW(spDoseAccessor->getValues(numberOfVoxels - 1, 1, values.data()));
+			CHECK_THROW_EXPLICIT(spDoseAccessor->getRowValues(geoInfo.getNumRows(), 0, values.data()),
+			                     core::IndexOutOfBoundsException);
+			CHECK_THROW_EXPLICIT(spDoseAccessor->getSliceValues(geoInfo.getNumSlices(), values.data()),
+			                     core::IndexOutOfBoundsException);
+			const std::vector<VoxelGridID> invalidIDs = { 0, numberOfVoxels };
+			CHECK_THROW_EXPLICIT(spDoseAccessor->gatherValues(invalidIDs.data(), invalidIDs.size(), values.data()),
+			                     core::IndexOutOfBoundsException);
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+
+	}//testing
+}//rttb
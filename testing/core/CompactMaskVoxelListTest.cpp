@@ -0,0 +1,131 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include <algorithm>
+#include <vector>
+
+#include "litCheckMacros.h"
+
+#include "rttbBaseType.h"
+#include "rttbMaskVoxel.h"
+#include "rttbCompactMaskVoxelList.h"
+
+namespace rttb
+{
+	namespace testing
+	{
+
+		/*! @brief CompactMaskVoxelListTest - test the API of CompactMaskVoxelList
+			1) test empty list
+			2) test spans (sorting, fully inside runs, partial voxels)
+			3) test toMaskVoxelList
+			4) test quantized fractions
+		*/
+		int CompactMaskVoxelListTest(int argc, char* argv[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			typedef core::CompactMaskVoxelList::MaskVoxelList MaskVoxelList;
+
+			//1) test empty list
+			core::CompactMaskVoxelList emptyList;
+			CHECK(emptyList.empty());
+			CHECK_EQUAL(emptyList.size(), 0);
+			CHECK_EQUAL(emptyList.getNumberOfSpans(), 0);
+			CHECK(core::CompactMaskVoxelList(MaskVoxelList()).toMaskVoxelList().empty());
+
+			//2) test spans: unsorted input with a run of fully inside voxels between partial voxels
+			MaskVoxelList voxelList;
+			voxelList.push_back(core::MaskVoxel(13, 1));
+			voxelList.push_back(core::MaskVoxel(10, 0.25));
+			voxelList.push_back(core::MaskVoxel(11, 1));
+			voxelList.push_back(core::MaskVoxel(12, 1));
+			voxelList.push_back(core::MaskVoxel(14, 0.5));
+			voxelList.push_back(core::MaskVoxel(15, 0.75));
+			voxelList.push_back(core::MaskVoxel(40, 1));
+			voxelList.push_back(core::MaskVoxel(2, 0.1));
+
+			core::CompactMaskVoxelList compactList(voxelList);
+			CHECK(!compactList.empty());
+			CHECK(!compactList.areFractionsQuantized());
+			CHECK_EQUAL(compactList.size(), voxelList.size());
+			CHECK_EQUAL(compactList.getNumberOfSpans(), 5);
+
+			CHECK_EQUAL(compactList.getSpanStart(0), 2);
+			CHECK_EQUAL(compactList.getSpanLength(0), 1);
+			CHECK(!compactList.isSpanFullyInside(0));
+			CHECK_EQUAL(compactList.getFraction(0, 0), 0.1);
+
+			CHECK_EQUAL(compactList.getSpanStart(1), 10);
+			CHECK_EQUAL(compactList.getSpanLength(1), 1);
+			CHECK_EQUAL(compactList.getFraction(1, 0), 0.25);
+
+			CHECK_EQUAL(compactList.getSpanStart(2), 11);
+			CHECK_EQUAL(compactList.getSpanLength(2), 3);
+			CHECK(compactList.isSpanFullyInside(2));
+			CHECK_EQUAL(compactList.getFraction(2, 2), 1);
+
+			CHECK_EQUAL(compactList.getSpanStart(3), 14);
+			CHECK_EQUAL(compactList.getSpanLength(3), 2);
+			CHECK(!compactList.isSpanFullyInside(3));
+			CHECK_EQUAL(compactList.getFraction(3, 0), 0.5);
+			CHECK_EQUAL(compactList.getFraction(3, 1), 0.75);
+
+			CHECK_EQUAL(compactList.getSpanStart(4), 40);
+			CHECK(compactList.isSpanFullyInside(4));
+
+			//fully inside voxels need no fraction
+			CHECK(compactList.getMemorySize() < voxelList.size() * sizeof(core::MaskVoxel));
+
+			//3) test toMaskVoxelList
+			MaskVoxelList sortedVoxelList = voxelList;
+			std::sort(sortedVoxelList.begin(), sortedVoxelList.end(), [](const core::MaskVoxel& a, const core::MaskVoxel& b)
+			{
+				return a.getVoxelGridID() < b.getVoxelGridID();
+			});
+			CHECK(compactList.toMaskVoxelList() == sortedVoxelList);
+
+			//duplicated IDs are kept
+			MaskVoxelList duplicateList;
+			duplicateList.push_back(core::MaskVoxel(5, 0.5));
+			duplicateList.push_back(core::MaskVoxel(5, 0.3));
+			core::CompactMaskVoxelList compactDuplicateList(duplicateList);
+			CHECK_EQUAL(compactDuplicateList.getNumberOfSpans(), 2);
+			CHECK(compactDuplicateList.toMaskVoxelList() == duplicateList);
+
+			//4) test quantized fractions
+			core::CompactMaskVoxelList quantizedList(voxelList, true);
+			CHECK(quantizedList.areFractionsQuantized());
+			CHECK_EQUAL(quantizedList.getNumberOfSpans(), compactList.getNumberOfSpans());
+			CHECK(quantizedList.getMemorySize() < compactList.getMemorySize());
+
+			const FractionType maxQuantizationError = 0.5 / core::CompactMaskVoxelList::quantizationSteps;
+
+			for (core::CompactMaskVoxelList::SpanIndexType span = 0; span < compactList.getNumberOfSpans(); ++span)
+			{
+				CHECK_EQUAL(quantizedList.getSpanStart(span), compactList.getSpanStart(span));
+				CHECK_EQUAL(quantizedList.getSpanLength(span), compactList.getSpanLength(span));
+
+				for (core::CompactMaskVoxelList::SpanLengthType offset = 0; offset < compactList.getSpanLength(span); ++offset)
+				{
+					CHECK_CLOSE(quantizedList.getFraction(span, offset), compactList.getFraction(span, offset), maxQuantizationError);
+				}
+			}
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+
+	}//testing
+}//rttb
@@ -16,6 +16,12 @@
 // this file defines the rttbCoreTests for the test driver
 // and all it expects is that you have a function called RegisterTests
 
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <utility>
+#include <vector>
+
 #include <boost/make_shared.hpp>
 #include <boost/shared_ptr.hpp>
 
@@ -28,6 +34,7 @@
 #include "rttbGenericDoseIterator.h"
 #include "rttbNullPointerException.h"
 #include "rttbInvalidParameterException.h"
+#include "rttbThreadPool.h"
 #include "DummyDoseAccessor.h"
 #include "DummyMaskAccessor.h"
 
@@ -41,15 +48,52 @@ namespace rttb
 		typedef core::DVHCalculator::DoseIteratorPointer DoseIteratorPointer;
 		typedef core::DVHCalculator::MaskedDoseIteratorPointer MaskedDoseIteratorPointer;
 
+		/*! @brief dose accessor that stores the dose as raw integers with a scaling (like DICOM)*/
+		class RawDummyDoseAccessor : public DummyDoseAccessor
+		{
+		private:
+			std::vector<std::uint16_t> _rawDoseData;
+			GenericValueType _doseGridScaling;
+
+			static std::vector<DoseTypeGy> scale(const std::vector<std::uint16_t>& aRawDoseData, GenericValueType aDoseGridScaling)
+			{
+				std::vector<DoseTypeGy> doseData;
+
+				for (const auto rawValue : aRawDoseData)
+				{
+					doseData.push_back(rawValue * aDoseGridScaling);
+				}
+
+				return doseData;
+			}
+
+		public:
+			RawDummyDoseAccessor(const std::vector<std::uint16_t>& aRawDoseData, GenericValueType aDoseGridScaling,
+			                     const core::GeometricInfo& geoInfo) : DummyDoseAccessor(scale(aRawDoseData, aDoseGridScaling), geoInfo),
+				_rawDoseData(aRawDoseData), _doseGridScaling(aDoseGridScaling)
+			{
+			}
+
+			const std::uint16_t* getRawUInt16Values(GenericValueType& aScaling) const override
+			{
+				aScaling = _doseGridScaling;
+				return _rawDoseData.data();
+			}
+		};
+
 
 		/*!@brief DVHTest - test the API of DVH
 		 1) test constructors (values as expected?)
+		 2) test the lookup table for raw integer doses
 		*/
 
 		int DVHCalculatorTest(int argc, char* argv[])
 		{
 			PREPARE_DEFAULT_TEST_REPORTING;
 
+			//calculate in parallel, also on machines with one core
+			CHECK_NO_THROW(core::ThreadPool::setConcurrency(4));
+
 			//create null pointer to DoseIterator
 			DoseIteratorPointer spDoseIteratorNull;
 
@@ -141,6 +185,64 @@ namespace rttb
       CHECK_NO_THROW(dvh = myDVHCalc3.generateDVH());
       CHECK(dvh);
 
+			//the merged histograms of the parts equal a serial calculation
+			const DoseTypeGy deltaD = dvh->getDeltaD();
+			std::deque<DoseCalcType> expectedDataDifferential(201, 0);
+			DoseTypeGy expectedMaximum = 0;
+
+			for (spMaskedDoseIterator->reset(); spMaskedDoseIterator->isPositionValid(); spMaskedDoseIterator->next())
+			{
+				const DoseTypeGy currentVal = spMaskedDoseIterator->getCurrentDoseValue();
+				expectedMaximum = std::max(expectedMaximum, currentVal);
+				expectedDataDifferential[static_cast<int>(currentVal / deltaD)] +=
+				    spMaskedDoseIterator->getCurrentRelevantVolumeFraction();
+			}
+
+			CHECK_EQUAL(deltaD, expectedMaximum * 1.5 / 201);
+			const std::deque<DoseCalcType> dataDifferential = dvh->getDataDifferential();
+			CHECK_EQUAL(dataDifferential.size(), expectedDataDifferential.size());
+
+			for (size_t i = 0; i < expectedDataDifferential.size(); ++i)
+			{
+				CHECK_CLOSE(dataDifferential.at(i), expectedDataDifferential[i], errorConstant);
+			}
+
+			//2) test the lookup table for raw integer doses: the DVHs equal those of the scaled doses
+			const core::GeometricInfo& doseGeoInfo = spDoseAccessor->getGeometricInfo();
+			std::vector<std::uint16_t> rawDoseData;
+
+			for (GridSizeType i = 0; i < doseGeoInfo.getNumberOfVoxels(); ++i)
+			{
+				rawDoseData.push_back(static_cast<std::uint16_t>(rand() % 65536));
+			}
+
+			const GenericValueType doseGridScaling = 0.000731;
+			DoseAccessorPointer spRawDoseAccessor = boost::make_shared<RawDummyDoseAccessor>(rawDoseData, doseGridScaling,
+			                                        doseGeoInfo);
+			DoseAccessorPointer spScaledDoseAccessor = boost::make_shared<DummyDoseAccessor>(
+			            *(boost::static_pointer_cast<RawDummyDoseAccessor>(spRawDoseAccessor)->getDoseVector()), doseGeoInfo);
+			GenericValueType scaling = 0;
+			CHECK(spRawDoseAccessor->getRawUInt16Values(scaling) != nullptr);
+			CHECK(spScaledDoseAccessor->getRawUInt16Values(scaling) == nullptr);
+
+			const std::vector<std::pair<DoseIteratorPointer, DoseIteratorPointer> > iteratorPairs = {
+				std::make_pair(boost::make_shared<core::GenericDoseIterator>(spRawDoseAccessor),
+				boost::make_shared<core::GenericDoseIterator>(spScaledDoseAccessor)),
+				std::make_pair(boost::make_shared<core::GenericMaskedDoseIterator>(spMaskAccessor, spRawDoseAccessor),
+				boost::make_shared<core::GenericMaskedDoseIterator>(spMaskAccessor, spScaledDoseAccessor))
+			};
+
+			for (const auto& iteratorPair : iteratorPairs)
+			{
+				core::DVH::Pointer rawDVH = core::DVHCalculator(iteratorPair.first, structureID, doseID).generateDVH();
+				core::DVH::Pointer scaledDVH = core::DVHCalculator(iteratorPair.second, structureID, doseID).generateDVH();
+				CHECK_EQUAL(rawDVH->getDeltaD(), scaledDVH->getDeltaD());
+				CHECK(rawDVH->getDataDifferential() == scaledDVH->getDataDifferential());
+
+				core::DVHCalculator tooFewBinsDVHCalc(iteratorPair.first, structureID, doseID, rawDVH->getDeltaD(), 10);
+				CHECK_THROW_EXPLICIT(tooFewBinsDVHCalc.generateDVH(), core::InvalidParameterException);
+			}
+
 			RETURN_AND_REPORT_TEST_SUCCESS;
 		}
 
@@ -34,6 +34,7 @@ namespace rttb
 			1) test constructor (values as expected?)
 			2) test reset/next/get current values/isPositionValid
       3) test DoseIteratorInterface functions
+			4) test split
 		*/
 		int GenericDoseIteratorTest(int argc, char* argv[])
 		{
@@ -98,6 +99,49 @@ namespace rttb
 
       CHECK_THROW_EXPLICIT(genDoseIteratorInhomo.getCurrentVoxelVolume(), core::InvalidParameterException);
 
+			//4) test split
+			const VoxelGridID numberOfVoxels = static_cast<VoxelGridID>(geoInfo.getNumberOfVoxels());
+			CHECK_THROW_EXPLICIT(core::GenericDoseIterator(spDoseAccessor, 5, 4), core::InvalidParameterException);
+			CHECK_THROW_EXPLICIT(core::GenericDoseIterator(spDoseAccessor, 0, numberOfVoxels + 1),
+			                     core::InvalidParameterException);
+
+			core::GenericDoseIterator rangeIterator(spDoseAccessor, 10, 20);
+			rangeIterator.reset();
+			CHECK_EQUAL(rangeIterator.getCurrentVoxelGridID(), 10);
+			position = 10;
+
+			while (rangeIterator.isPositionValid())
+			{
+				CHECK_EQUAL(rangeIterator.getCurrentDoseValue(), doseVals->at(position));
+				rangeIterator.next();
+				position++;
+			}
+
+			CHECK_EQUAL(position, 20);
+
+			std::vector<core::DoseIteratorInterface::Pointer> parts = genDoseIterator.split(7);
+			CHECK_EQUAL(parts.size(), 7);
+			position = 0;
+
+			for (const auto& part : parts)
+			{
+				part->reset();
+				CHECK_EQUAL(part->getCurrentVoxelVolume(), homogeneousVoxelVolume);
+
+				while (part->isPositionValid())
+				{
+					CHECK_EQUAL(position, part->getCurrentVoxelGridID());
+					part->next();
+					position++;
+				}
+			}
+
+			CHECK_EQUAL(position, numberOfVoxels);
+
+			//not more parts than voxels
+			CHECK_EQUAL(rangeIterator.split(100).size(), 10);
+			CHECK_EQUAL(core::GenericDoseIterator(spDoseAccessor, 3, 3).split(4).size(), 1);
+
 			RETURN_AND_REPORT_TEST_SUCCESS;
 		}
 
@@ -23,6 +23,7 @@
 #include "rttbNullPointerException.h"
 #include "rttbInvalidParameterException.h"
 #include "rttbException.h"
+#include "rttbGenericMutableMaskAccessor.h"
 #include "DummyDoseAccessor.h"
 #include "DummyInhomogeneousDoseAccessor.h"
 #include "DummyMaskAccessor.h"
@@ -38,6 +39,8 @@ namespace rttb
 		/*! @brief GenericMaskedDoseIteratorTest.
 			1) test constructor (values as expected?)
 			2) test reset/next/get current values/isPositionValid
+			3) test split
+			4) test that reset() takes the voxel lists again after the mask was changed
 		*/
 		int GenericMaskedDoseIteratorTest(int argc, char* argv[])
 		{
@@ -127,6 +130,114 @@ namespace rttb
 			CHECK_EQUAL(defaultDoseVoxelGridID, genMaskedDoseIterator.getCurrentVoxelGridID());
 			CHECK(genMaskedDoseIterator.isPositionValid());//at start of dose
 
+			//the voxel lists are taken from the mask only once (the default implementation of the mask converts on every call)
+			const core::GenericMaskedDoseIterator::CompactMaskVoxelListPointer compactMaskVoxelList =
+			    genMaskedDoseIterator.getCompactMaskVoxelList();
+			genMaskedDoseIterator.reset();
+			CHECK(genMaskedDoseIterator.getCompactMaskVoxelList() == compactMaskVoxelList);
+			const boost::shared_ptr<core::GenericMaskedDoseIterator> firstPart =
+			    boost::dynamic_pointer_cast<core::GenericMaskedDoseIterator>(genMaskedDoseIterator.split(2).front());
+			CHECK(firstPart->getCompactMaskVoxelList() == compactMaskVoxelList);
+
+			//3) test split: the parts visit the voxels of the iterator in the same order
+			std::vector<VoxelGridID> visitedIDs;
+			std::vector<FractionType> visitedFractions;
+			genMaskedDoseIterator.reset();
+
+			while (genMaskedDoseIterator.isPositionValid())
+			{
+				visitedIDs.push_back(genMaskedDoseIterator.getCurrentVoxelGridID());
+				visitedFractions.push_back(genMaskedDoseIterator.getCurrentRelevantVolumeFraction());
+				genMaskedDoseIterator.next();
+			}
+
+			for (unsigned int numberOfParts : {1, 3, 16})
+			{
+				std::vector<core::DoseIteratorInterface::Pointer> parts = genMaskedDoseIterator.split(numberOfParts);
+				CHECK_EQUAL(parts.size(), numberOfParts);
+				size_t partPosition = 0;
+
+				for (const auto& part : parts)
+				{
+					part->reset();
+
+					while (part->isPositionValid())
+					{
+						CHECK_EQUAL(part->getCurrentVoxelGridID(), visitedIDs.at(partPosition));
+						CHECK_EQUAL(part->getCurrentRelevantVolumeFraction(), visitedFractions.at(partPosition));
+						part->next();
+						partPosition++;
+					}
+				}
+
+				CHECK_EQUAL(partPosition, visitedIDs.size());
+
+				//visitVoxels of the parts
+				partPosition = 0;
+
+				for (const auto& part : parts)
+				{
+					boost::dynamic_pointer_cast<core::GenericMaskedDoseIterator>(part)->visitVoxels([&](VoxelGridID anID,
+					        DoseTypeGy aDose, FractionType aFraction)
+					{
+						CHECK_EQUAL(anID, visitedIDs.at(partPosition));
+						CHECK_EQUAL(aDose, doseVals->at(anID));
+						CHECK_EQUAL(aFraction, visitedFractions.at(partPosition));
+						partPosition++;
+					});
+				}
+
+				CHECK_EQUAL(partPosition, visitedIDs.size());
+			}
+
+			//4) test that reset() takes the voxel lists again after the mask was changed (the UID of the mask stays the same)
+			auto spMutableMaskAccessor = boost::make_shared<masks::GenericMutableMaskAccessor>
+			                             (spTestDoseAccessor->getGeometricInfo());
+			auto mutableMaskVoxels = boost::make_shared<core::MaskAccessorInterface::MaskVoxelList>();
+			mutableMaskVoxels->push_back(core::MaskVoxel(2, 1));
+			mutableMaskVoxels->push_back(core::MaskVoxel(7, 0.5));
+			spMutableMaskAccessor->setRelevantVoxelVector(mutableMaskVoxels);
+
+			core::GenericMaskedDoseIterator mutableMaskIterator(spMutableMaskAccessor, spDoseAccessor);
+			const IDType mutableMaskUID = spMutableMaskAccessor->getMaskUID();
+
+			auto collectVoxels = [&mutableMaskIterator](std::vector<VoxelGridID>& anIDs, std::vector<FractionType>& aFractions)
+			{
+				anIDs.clear();
+				aFractions.clear();
+				mutableMaskIterator.reset();
+
+				while (mutableMaskIterator.isPositionValid())
+				{
+					anIDs.push_back(mutableMaskIterator.getCurrentVoxelGridID());
+					aFractions.push_back(mutableMaskIterator.getCurrentRelevantVolumeFraction());
+					mutableMaskIterator.next();
+				}
+			};
+
+			std::vector<VoxelGridID> mutableMaskIDs;
+			std::vector<FractionType> mutableMaskFractions;
+			collectVoxels(mutableMaskIDs, mutableMaskFractions);
+			CHECK(mutableMaskIDs == std::vector<VoxelGridID>({2, 7}));
+			CHECK(mutableMaskFractions == std::vector<FractionType>({1, 0.5}));
+
+			//changed fraction of a voxel and a new voxel
+			spMutableMaskAccessor->setMaskAt(7, core::MaskVoxel(7, 0.25));
+			spMutableMaskAccessor->setMaskAt(4, core::MaskVoxel(4, 0.75));
+			CHECK_EQUAL(spMutableMaskAccessor->getMaskUID(), mutableMaskUID);
+			collectVoxels(mutableMaskIDs, mutableMaskFractions);
+			CHECK(mutableMaskIDs == std::vector<VoxelGridID>({2, 4, 7}));
+			CHECK(mutableMaskFractions == std::vector<FractionType>({1, 0.75, 0.25}));
+
+			//new voxel list
+			auto newMutableMaskVoxels = boost::make_shared<core::MaskAccessorInterface::MaskVoxelList>();
+			newMutableMaskVoxels->push_back(core::MaskVoxel(9, 0.125));
+			spMutableMaskAccessor->setRelevantVoxelVector(newMutableMaskVoxels);
+			CHECK_EQUAL(spMutableMaskAccessor->getMaskUID(), mutableMaskUID);
+			collectVoxels(mutableMaskIDs, mutableMaskFractions);
+			CHECK(mutableMaskIDs == std::vector<VoxelGridID>({9}));
+			CHECK(mutableMaskFractions == std::vector<FractionType>({0.125}));
+
 			RETURN_AND_REPORT_TEST_SUCCESS;
 		}
 
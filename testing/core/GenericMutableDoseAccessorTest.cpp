@@ -0,0 +1,95 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include <vector>
+
+#include "litCheckMacros.h"
+
+#include "rttbBaseType.h"
+#include "rttbGeometricInfo.h"
+#include "rttbGenericMutableDoseAccessor.h"
+
+namespace rttb
+{
+	namespace testing
+	{
+
+		/*! @brief GenericMutableDoseAccessorTest - test the API of GenericMutableDoseAccessor
+			1) test constructor and UID
+			2) test setDoseAt/getValueAt
+			3) test bulk access
+		*/
+		int GenericMutableDoseAccessorTest(int argc, char* argv[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			core::GeometricInfo geoInfo;
+			geoInfo.setImageSize(ImageSize(4, 3, 2));
+			const VoxelGridID numberOfVoxels = static_cast<VoxelGridID>(geoInfo.getNumberOfVoxels());
+
+			//1) test constructor and UID
+			core::GenericMutableDoseAccessor accessor(geoInfo);
+			CHECK_EQUAL(accessor.getGeometricInfo(), geoInfo);
+			CHECK_EQUAL(accessor.getDoseVector().size(), static_cast<size_t>(numberOfVoxels));
+			CHECK(!accessor.getUID().empty());
+			CHECK(accessor.getUID() != core::GenericMutableDoseAccessor(geoInfo).getUID());
+			CHECK_EQUAL(core::GenericMutableDoseAccessor(geoInfo, "dose").getUID(), "dose");
+
+			for (VoxelGridID id = 0; id < numberOfVoxels; ++id)
+			{
+				CHECK_EQUAL(accessor.getValueAt(id), 0);
+			}
+
+			//2) test setDoseAt/getValueAt
+			accessor.setDoseAt(5, 1.5);
+			accessor.setDoseAt(VoxelGridIndex3D(3, 2, 1), 2.5);
+			CHECK_EQUAL(accessor.getValueAt(5), 1.5);
+			CHECK_EQUAL(accessor.getValueAt(VoxelGridIndex3D(1, 1, 0)), 1.5);
+			CHECK_EQUAL(accessor.getValueAt(numberOfVoxels - 1), 2.5);
+			CHECK_EQUAL(accessor.getDoseVector()[numberOfVoxels - 1], 2.5);
+
+			//invalid voxels are ignored
+			CHECK_NO_THROW(accessor.setDoseAt(numberOfVoxels, 3));
+			CHECK_NO_THROW(accessor.setDoseAt(VoxelGridIndex3D(4, 0, 0), 3));
+			CHECK_EQUAL(accessor.getValueAt(numberOfVoxels), -1);
+			CHECK_EQUAL(accessor.getValueAt(VoxelGridIndex3D(4, 0, 0)), -1);
+
+			//3) test bulk access
+			for (VoxelGridID id = 0; id < numberOfVoxels; ++id)
+			{
+				accessor.getDoseVector()[id] = id * 0.5;
+			}
+
+			std::vector<GenericValueType> values(numberOfVoxels, -1);
+			accessor.getSliceValues(1, values.data());
+
+			for (VoxelGridID i = 0; i < 12; ++i)
+			{
+				CHECK_EQUAL(values[i], (12 + i) * 0.5);
+			}
+
+			const std::vector<VoxelGridID> ids = { 0, 7, numberOfVoxels - 1 };
+			accessor.gatherValues(ids.data(), ids.size(), values.data());
+
+			for (size_t i = 0; i < ids.size(); ++i)
+			{
+				CHECK_EQUAL(values[i], ids[i] * 0.5);
+			}
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+
+	}//testing
+}//rttb
@@ -0,0 +1,133 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include <stdexcept>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+
+#include "litCheckMacros.h"
+
+#include "rttbBaseType.h"
+#include "rttbParallelReduce.h"
+#include "rttbGenericDoseIterator.h"
+#include "rttbGenericMaskedDoseIterator.h"
+#include "DummyDoseAccessor.h"
+#include "DummyMaskAccessor.h"
+
+namespace rttb
+{
+	namespace testing
+	{
+
+		/*! @brief ParallelReduceTest - tests parallelReduce
+			1) index ranges (chunks are joined in order, empty ranges, exceptions)
+			2) dose iterators (split and not split)
+		*/
+		int ParallelReduceTest(int argc, char* argv[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			core::ThreadPool pool(4);
+			core::ThreadPool singlePool(1);
+
+			//1) index ranges
+			auto appendIndices = [](size_t aBegin, size_t anEnd, std::vector<size_t>& indices)
+			{
+				for (size_t i = aBegin; i < anEnd; ++i)
+				{
+					indices.push_back(i);
+				}
+			};
+			auto append = [](std::vector<size_t>& indices, const std::vector<size_t>& chunkIndices)
+			{
+				indices.insert(indices.end(), chunkIndices.begin(), chunkIndices.end());
+			};
+
+			for (core::ThreadPool* aPool : { &pool, &singlePool })
+			{
+				const std::vector<size_t> indices = core::parallelReduce(3, 1003, std::vector<size_t>(), appendIndices, append, 1,
+				                                    *aPool);
+				CHECK_EQUAL(indices.size(), 1000);
+				bool inOrder = true;
+
+				for (size_t i = 0; i < indices.size(); ++i)
+				{
+					inOrder = inOrder && (indices[i] == i + 3);
+				}
+
+				CHECK(inOrder);
+			}
+
+			CHECK(core::parallelReduce(5, 5, std::vector<size_t>(), appendIndices, append, 1, pool).empty());
+
+			//the minimal chunk size limits the number of chunks
+			auto countChunks = [](size_t, size_t, int& numberOfChunks)
+			{
+				++numberOfChunks;
+			};
+			auto add = [](int& sum, int chunkSum)
+			{
+				sum += chunkSum;
+			};
+			CHECK_EQUAL(core::parallelReduce(0, 100, 0, countChunks, add, 50, pool), 2);
+			CHECK_EQUAL(core::parallelReduce(0, 100, 0, countChunks, add, 1, singlePool), 1);
+
+			auto throwingBody = [](size_t aBegin, size_t, int&)
+			{
+				if (aBegin == 0)
+				{
+					throw std::runtime_error("test");
+				}
+			};
+			CHECK_THROW_EXPLICIT(core::parallelReduce(0, 100, 0, throwingBody, add, 1, pool), std::runtime_error);
+
+			//2) dose iterators
+			boost::shared_ptr<DummyDoseAccessor> spDoseAccessor = boost::make_shared<DummyDoseAccessor>();
+			boost::shared_ptr<DummyMaskAccessor> spMaskAccessor = boost::make_shared<DummyMaskAccessor>
+			        (spDoseAccessor->getGeometricInfo());
+
+			auto sumDose = [](core::DoseIteratorInterface& anIterator, DoseTypeGy& sum)
+			{
+				for (; anIterator.isPositionValid(); anIterator.next())
+				{
+					sum += anIterator.getCurrentDoseValue() * anIterator.getCurrentRelevantVolumeFraction();
+				}
+			};
+			auto addDose = [](DoseTypeGy& sum, DoseTypeGy partSum)
+			{
+				sum += partSum;
+			};
+
+			core::DoseIteratorInterface::Pointer doseIterator = boost::make_shared<core::GenericDoseIterator>(spDoseAccessor);
+			core::DoseIteratorInterface::Pointer maskedDoseIterator = boost::make_shared<core::GenericMaskedDoseIterator>
+			        (spMaskAccessor, spDoseAccessor);
+
+			for (const auto& anIterator : { doseIterator, maskedDoseIterator })
+			{
+				DoseTypeGy sequentialSum = 0;
+				anIterator->reset();
+				sumDose(*anIterator, sequentialSum);
+
+				CHECK_CLOSE(core::parallelReduce(*anIterator, DoseTypeGy(0), sumDose, addDose, pool), sequentialSum,
+				            errorConstant * sequentialSum);
+				CHECK_EQUAL(core::parallelReduce(*anIterator, DoseTypeGy(0), sumDose, addDose, singlePool), sequentialSum);
+			}
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+
+	}//testing
+}//rttb
@@ -0,0 +1,93 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "litCheckMacros.h"
+
+#include "rttbParallelSort.h"
+
+namespace rttb
+{
+	namespace testing
+	{
+
+		/*! @brief ParallelSortTest - tests parallelStableSort
+			1) same result as std::stable_sort (order of equal elements, odd number of chunks)
+			2) empty and small ranges
+			3) exceptions
+		*/
+		int ParallelSortTest(int argc, char* argv[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			core::ThreadPool pool(4);
+			core::ThreadPool oddPool(3);
+			core::ThreadPool singlePool(1);
+
+			//1) pairs of key and insertion index, many equal keys
+			typedef std::pair<int, size_t> ElementType;
+			auto lessKey = [](const ElementType& a, const ElementType& b)
+			{
+				return a.first < b.first;
+			};
+
+			std::vector<ElementType> elements;
+
+			for (size_t i = 0; i < 10007; ++i)
+			{
+				elements.push_back(std::make_pair(static_cast<int>((i * 7919) % 101), i));
+			}
+
+			std::vector<ElementType> expectedElements = elements;
+			std::stable_sort(expectedElements.begin(), expectedElements.end(), lessKey);
+
+			for (core::ThreadPool* aPool : { &pool, &oddPool, &singlePool })
+			{
+				for (size_t minChunkSize : { 1, 100, 5000, 100000 })
+				{
+					std::vector<ElementType> sortedElements = elements;
+					core::parallelStableSort(sortedElements.begin(), sortedElements.end(), lessKey, minChunkSize, *aPool);
+					CHECK(sortedElements == expectedElements);
+				}
+			}
+
+			//2) empty and small ranges
+			std::vector<ElementType> emptyElements;
+			CHECK_NO_THROW(core::parallelStableSort(emptyElements.begin(), emptyElements.end(), lessKey, 1, pool));
+			CHECK(emptyElements.empty());
+
+			std::vector<ElementType> smallElements = { ElementType(2, 0), ElementType(1, 1), ElementType(2, 2) };
+			core::parallelStableSort(smallElements.begin(), smallElements.end(), lessKey, 1, pool);
+			CHECK(smallElements == std::vector<ElementType>({ ElementType(1, 1), ElementType(2, 0), ElementType(2, 2) }));
+
+			//3) exceptions
+			auto throwingLess = [](const ElementType& a, const ElementType& b) -> bool
+			{
+				throw std::runtime_error("test");
+			};
+			std::vector<ElementType> throwingElements = elements;
+			CHECK_THROW_EXPLICIT(core::parallelStableSort(throwingElements.begin(), throwingElements.end(), throwingLess, 100,
+			                     pool), std::runtime_error);
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+
+	}//testing
+}//rttb
@@ -0,0 +1,181 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "litCheckMacros.h"
+
+#include "rttbThreadPool.h"
+#include "rttbInvalidParameterException.h"
+
+namespace rttb
+{
+	namespace testing
+	{
+
+		/*! @brief ThreadPoolTest - tests the API of ThreadPool and TaskGroup
+		1) concurrency 1: all tasks run in the calling thread
+		2) many tasks on several worker threads
+		3) nested task groups
+		4) exceptions of tasks are rethrown by wait()
+		5) concurrency of the pool of the library
+		*/
+		int ThreadPoolTest(int argc, char* argv[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			//1) concurrency 1
+			{
+				core::ThreadPool singlePool(1);
+				CHECK_EQUAL(singlePool.getConcurrency(), 1);
+
+				const std::thread::id callingThread = std::this_thread::get_id();
+				std::vector<std::thread::id> threadIds(10);
+
+				core::TaskGroup tasks(singlePool);
+
+				for (size_t i = 0; i < threadIds.size(); ++i)
+				{
+					tasks.run([&threadIds, i]()
+					{
+						threadIds[i] = std::this_thread::get_id();
+					});
+				}
+
+				CHECK_NO_THROW(tasks.wait());
+
+				for (const auto& id : threadIds)
+				{
+					CHECK(id == callingThread);
+				}
+			}
+
+			//2) many tasks on several worker threads
+			{
+				core::ThreadPool pool(4);
+				CHECK_EQUAL(pool.getConcurrency(), 4);
+
+				std::atomic<unsigned int> sum(0);
+				core::TaskGroup tasks(pool);
+
+				for (unsigned int i = 1; i <= 1000; ++i)
+				{
+					tasks.run([&sum, i]()
+					{
+						sum += i;
+					});
+				}
+
+				CHECK_NO_THROW(tasks.wait());
+				CHECK_EQUAL(sum.load(), 500500u);
+
+				//the group can be reused after wait()
+				tasks.run([&sum]()
+				{
+					sum = 0;
+				});
+				CHECK_NO_THROW(tasks.wait());
+				CHECK_EQUAL(sum.load(), 0u);
+			}
+
+			//3) nested task groups (more nested groups than worker threads, must not dead lock)
+			{
+				core::ThreadPool pool(2);
+
+				std::atomic<unsigned int> count(0);
+				core::TaskGroup outerTasks(pool);
+
+				for (unsigned int i = 0; i < 8; ++i)
+				{
+					outerTasks.run([&pool, &count]()
+					{
+						core::TaskGroup innerTasks(pool);
+
+						for (unsigned int j = 0; j < 8; ++j)
+						{
+							innerTasks.run([&count]()
+							{
+								++count;
+							});
+						}
+
+						innerTasks.wait();
+					});
+				}
+
+				CHECK_NO_THROW(outerTasks.wait());
+				CHECK_EQUAL(count.load(), 64u);
+			}
+
+			//4) exceptions
+			{
+				core::ThreadPool pool(3);
+
+				std::atomic<unsigned int> count(0);
+				core::TaskGroup tasks(pool);
+
+				for (unsigned int i = 0; i < 10; ++i)
+				{
+					tasks.run([&count, i]()
+					{
+						++count;
+
+						if (i % 2 == 0)
+						{
+							throw std::runtime_error("task failed");
+						}
+					});
+				}
+
+				CHECK_THROW_EXPLICIT(tasks.wait(), std::runtime_error);
+				//all tasks were executed nevertheless
+				CHECK_EQUAL(count.load(), 10u);
+				//the exception is only rethrown once
+				CHECK_NO_THROW(tasks.wait());
+			}
+
+			//5) pool of the library
+			CHECK_NO_THROW(core::ThreadPool::setConcurrency(2));
+			CHECK_NO_THROW(core::ThreadPool::setConcurrency(3));
+			CHECK_EQUAL(core::ThreadPool::getInstance().getConcurrency(), 3);
+			CHECK(&core::ThreadPool::getInstance() == &core::ThreadPool::getInstance());
+			//same concurrency as the existing pool is fine, a different one not
+			CHECK_NO_THROW(core::ThreadPool::setConcurrency(3));
+			CHECK_THROW_EXPLICIT(core::ThreadPool::setConcurrency(5), core::InvalidParameterException);
+
+			{
+				std::atomic<unsigned int> count(0);
+				core::TaskGroup tasks;
+
+				for (unsigned int i = 0; i < 100; ++i)
+				{
+					tasks.run([&count]()
+					{
+						++count;
+					});
+				}
+
+				CHECK_NO_THROW(tasks.wait());
+				CHECK_EQUAL(count.load(), 100u);
+			}
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+
+	}//testing
+}//rttb
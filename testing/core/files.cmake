@@ -10,6 +10,7 @@ SET(CPP_FILES
 	StructureTest.cpp
 	GeometricInfoTest.cpp
 	MaskVoxelTest.cpp
+	CompactMaskVoxelListTest.cpp
 	GenericDoseIteratorTest.cpp
 	GenericMaskedDoseIteratorTest.cpp
 	DVHCalculatorTest.cpp
@@ -18,6 +19,11 @@ SET(CPP_FILES
 	StrVectorStructureSetGeneratorTest.cpp
 	StructureSetTest.cpp
 	BaseTypeTest.cpp
+	AccessorInterfaceTest.cpp
+	GenericMutableDoseAccessorTest.cpp
+	ThreadPoolTest.cpp
+	ParallelReduceTest.cpp
+	ParallelSortTest.cpp
   )
 
 SET(H_FILES 
@@ -31,6 +31,7 @@ namespace rttb
 		{
 			LIT_REGISTER_TEST(GeometricInfoTest);
 			LIT_REGISTER_TEST(MaskVoxelTest);
+			LIT_REGISTER_TEST(CompactMaskVoxelListTest);
 			LIT_REGISTER_TEST(GenericDoseIteratorTest);
 			LIT_REGISTER_TEST(GenericMaskedDoseIteratorTest);
 			LIT_REGISTER_TEST(DVHCalculatorTest);
@@ -43,6 +44,11 @@ namespace rttb
 			LIT_REGISTER_TEST(StrVectorStructureSetGeneratorTest);
 			LIT_REGISTER_TEST(StructureSetTest);
       LIT_REGISTER_TEST(BaseTypeTest);
+      LIT_REGISTER_TEST(AccessorInterfaceTest);
+      LIT_REGISTER_TEST(GenericMutableDoseAccessorTest);
+      LIT_REGISTER_TEST(ThreadPoolTest);
+      LIT_REGISTER_TEST(ParallelReduceTest);
+      LIT_REGISTER_TEST(ParallelSortTest);
 		}
 	}
 }
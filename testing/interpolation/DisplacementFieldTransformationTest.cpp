@@ -0,0 +1,230 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+
+#include "litCheckMacros.h"
+
+#include "rttbBaseType.h"
+#include "rttbGeometricInfo.h"
+#include "rttbDisplacementFieldTransformation.h"
+#include "rttbSimpleMappableDoseAccessor.h"
+#include "rttbLinearInterpolation.h"
+#include "rttbInvalidParameterException.h"
+#include "../core/DummyDoseAccessor.h"
+#include "DummyTransformation.h"
+
+namespace rttb
+{
+	namespace testing
+	{
+		/*! @class AffineTestTransformation
+			@brief affine transformation that fails for target points with x >= -5 (to test undefined displacements)
+		*/
+		class AffineTestTransformation : public interpolation::TransformationInterface
+		{
+		public:
+			bool transformInverse(const WorldCoordinate3D& worldCoordinateTarget,
+			                      WorldCoordinate3D& worldCoordinateMoving) const override
+			{
+				worldCoordinateMoving = WorldCoordinate3D(1.1 * worldCoordinateTarget.x() + 0.2 * worldCoordinateTarget.y() + 1.5,
+				                        worldCoordinateTarget.y() - 0.1 * worldCoordinateTarget.z() - 2, worldCoordinateTarget.z() + 0.5);
+				return worldCoordinateTarget.x() < -5;
+			}
+
+			bool transform(const WorldCoordinate3D& /*worldCoordinateMoving*/,
+			               WorldCoordinate3D& /*worldCoordinateTarget*/) const override
+			{
+				return false;
+			}
+		};
+
+		/*! @brief DisplacementFieldTransformationTest - test the API of DisplacementFieldTransformation
+			1) test constructors
+			2) test lookup (voxel centers, interpolation, border and undefined displacements)
+			3) test write/read
+			4) test mapping with the field
+		*/
+		int DisplacementFieldTransformationTest(int argc, char* argv[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			std::string FIELD_FILENAME = "displacementField.bin";
+
+			if (argc > 1)
+			{
+				FIELD_FILENAME = argv[1];
+			}
+
+			core::GeometricInfo fieldGeometry;
+			fieldGeometry.setImageSize(ImageSize(10, 8, 6));
+			fieldGeometry.setSpacing(SpacingVectorType3D(2, 2.5, 3));
+			fieldGeometry.setImagePositionPatient(WorldCoordinate3D(-20, 1, 36));
+			fieldGeometry.setOrientationMatrix(OrientationMatrix());
+
+			const size_t numberOfVoxels = static_cast<size_t>(fieldGeometry.getNumberOfVoxels());
+			AffineTestTransformation affineTransformation;
+			DummyTransformation identityTransformation;
+
+			//1) test constructors
+			CHECK_NO_THROW(interpolation::DisplacementFieldTransformation(identityTransformation, fieldGeometry));
+			CHECK_THROW_EXPLICIT(interpolation::DisplacementFieldTransformation(identityTransformation, core::GeometricInfo()),
+			                     core::InvalidParameterException);
+			CHECK_NO_THROW(interpolation::DisplacementFieldTransformation(fieldGeometry,
+			               std::vector<double>(3 * numberOfVoxels, 1.0)));
+			CHECK_THROW_EXPLICIT(interpolation::DisplacementFieldTransformation(fieldGeometry,
+			                     std::vector<double>(3 * numberOfVoxels - 1, 1.0)), core::InvalidParameterException);
+
+			interpolation::DisplacementFieldTransformation identityField(identityTransformation, fieldGeometry);
+			CHECK(identityField.getFieldGeometry() == fieldGeometry);
+			CHECK(identityField.getDisplacements() == std::vector<double>(3 * numberOfVoxels, 0.0));
+
+			interpolation::DisplacementFieldTransformation affineField(affineTransformation, fieldGeometry);
+
+			//2) test lookup
+			WorldCoordinate3D target;
+			WorldCoordinate3D expected;
+			WorldCoordinate3D moving;
+
+			//voxel centers and points in between (a trilinear interpolation of an affine field is exact), voxels with x >= -5 are undefined
+			const std::vector<ContinuousVoxelGridIndex3D> insideIndices = { ContinuousVoxelGridIndex3D(0, 0, 0),
+			                                                                ContinuousVoxelGridIndex3D(3, 7, 5), ContinuousVoxelGridIndex3D(2.5, 1.25, 4.75),
+			                                                                ContinuousVoxelGridIndex3D(6.8, 0.5, 0.5), ContinuousVoxelGridIndex3D(5, 3.4, 2.2)
+			                                                              };
+
+			for (const auto& index : insideIndices)
+			{
+				fieldGeometry.continuousIndexToWorldCoordinate(index, target);
+				CHECK(affineTransformation.transformInverse(target, expected));
+				CHECK(affineField.transformInverse(target, moving));
+
+				for (unsigned int i = 0; i < 3; ++i)
+				{
+					CHECK_CLOSE(moving(i), expected(i), errorConstant);
+				}
+			}
+
+			//points up to half a voxel outside get the displacement of the border voxels
+			fieldGeometry.continuousIndexToWorldCoordinate(ContinuousVoxelGridIndex3D(-0.4, 2, 5.4), target);
+			CHECK(affineField.transformInverse(target, moving));
+			WorldCoordinate3D borderVoxel;
+			fieldGeometry.continuousIndexToWorldCoordinate(ContinuousVoxelGridIndex3D(0, 2, 5), borderVoxel);
+			CHECK(affineTransformation.transformInverse(borderVoxel, expected));
+
+			for (unsigned int i = 0; i < 3; ++i)
+			{
+				CHECK_CLOSE(moving(i) - target(i), expected(i) - borderVoxel(i), errorConstant);
+			}
+
+			fieldGeometry.continuousIndexToWorldCoordinate(ContinuousVoxelGridIndex3D(-0.6, 2, 2), target);
+			CHECK(!affineField.transformInverse(target, moving));
+			fieldGeometry.continuousIndexToWorldCoordinate(ContinuousVoxelGridIndex3D(3, 2, 5.6), target);
+			CHECK(!affineField.transformInverse(target, moving));
+
+			//x of voxel 7 is -6, x of voxel 8 is -4 (undefined)
+			fieldGeometry.continuousIndexToWorldCoordinate(ContinuousVoxelGridIndex3D(7, 2, 2), target);
+			CHECK(affineField.transformInverse(target, moving));
+			fieldGeometry.continuousIndexToWorldCoordinate(ContinuousVoxelGridIndex3D(7.5, 2, 2), target);
+			CHECK(!affineField.transformInverse(target, moving));
+			CHECK(!affineField.transform(moving, target));
+
+			//batch
+			std::vector<WorldCoordinate3D> targetCoordinates(insideIndices.size());
+			std::vector<WorldCoordinate3D> movingCoordinates(insideIndices.size());
+
+			for (size_t i = 0; i < insideIndices.size(); ++i)
+			{
+				fieldGeometry.continuousIndexToWorldCoordinate(insideIndices.at(i), targetCoordinates.at(i));
+			}
+
+			CHECK(affineField.transformInverseBatch(targetCoordinates.data(), targetCoordinates.size(),
+			                                        movingCoordinates.data()));
+
+			for (size_t i = 0; i < insideIndices.size(); ++i)
+			{
+				CHECK(affineField.transformInverse(targetCoordinates.at(i), moving));
+				CHECK_EQUAL(movingCoordinates.at(i), moving);
+			}
+
+			fieldGeometry.continuousIndexToWorldCoordinate(ContinuousVoxelGridIndex3D(-1, 0, 0), targetCoordinates.at(2));
+			CHECK(!affineField.transformInverseBatch(targetCoordinates.data(), targetCoordinates.size(),
+			                                         movingCoordinates.data()));
+			CHECK(std::isnan(movingCoordinates.at(2).x()));
+			CHECK_EQUAL(movingCoordinates.at(4), moving);
+
+			//3) test write/read
+			CHECK(affineField.getTransformationIdentifier().empty());
+			affineField.setTransformationIdentifier("affine test transformation");
+			CHECK_NO_THROW(affineField.write(FIELD_FILENAME));
+			interpolation::DisplacementFieldTransformation::Pointer readField;
+			CHECK_NO_THROW(readField = interpolation::DisplacementFieldTransformation::read(FIELD_FILENAME));
+			CHECK(readField->getFieldGeometry() == fieldGeometry);
+			CHECK_EQUAL(readField->getTransformationIdentifier(), "affine test transformation");
+			CHECK_EQUAL(readField->getDisplacements().size(), affineField.getDisplacements().size());
+			size_t numberOfDifferentDisplacements = 0;
+
+			for (size_t i = 0; i < affineField.getDisplacements().size(); ++i)
+			{
+				const double writtenDisplacement = affineField.getDisplacements().at(i);
+				const double readDisplacement = readField->getDisplacements().at(i);
+
+				if (writtenDisplacement != readDisplacement && !(std::isnan(writtenDisplacement) && std::isnan(readDisplacement)))
+				{
+					++numberOfDifferentDisplacements;
+				}
+			}
+
+			CHECK_EQUAL(numberOfDifferentDisplacements, static_cast<size_t>(0));
+			CHECK_EQUAL(std::remove(FIELD_FILENAME.c_str()), 0);
+
+			CHECK_THROW_EXPLICIT(interpolation::DisplacementFieldTransformation::read("invalidFileName.bin"),
+			                     core::InvalidParameterException);
+			CHECK_THROW_EXPLICIT(affineField.write("invalidDirectory/displacementField.bin"), core::InvalidParameterException);
+
+			//4) test mapping with the field: at the voxel centers of the field geometry the mapping is the same as with the original transformation,
+			//voxels with undefined displacement are padded
+			boost::shared_ptr<DummyDoseAccessor> spDoseAccessor = boost::make_shared<DummyDoseAccessor>();
+			auto spAffineTransformation = boost::make_shared<AffineTestTransformation>();
+			auto mappableDose = boost::make_shared<interpolation::SimpleMappableDoseAccessor>(fieldGeometry, spDoseAccessor,
+			                    spAffineTransformation, boost::make_shared<interpolation::LinearInterpolation>(), true, 0);
+			auto mappableDoseWithField = boost::make_shared<interpolation::SimpleMappableDoseAccessor>(fieldGeometry,
+			                             spDoseAccessor, readField, boost::make_shared<interpolation::LinearInterpolation>(), true, 0);
+
+			for (VoxelGridID id = 0; id < static_cast<VoxelGridID>(numberOfVoxels); ++id)
+			{
+				VoxelGridIndex3D index;
+				fieldGeometry.convert(id, index);
+				fieldGeometry.indexToWorldCoordinate(index, target);
+
+				if (affineTransformation.transformInverse(target, expected))
+				{
+					CHECK_CLOSE(mappableDoseWithField->getValueAt(id), mappableDose->getValueAt(id), errorConstant);
+				}
+				else
+				{
+					CHECK_EQUAL(mappableDoseWithField->getValueAt(id), 0);
+				}
+			}
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+
+	}//testing
+}//rttb
@@ -13,6 +13,8 @@
 //
 //------------------------------------------------------------------------
 
+#include <array>
+
 #include "litCheckMacros.h"
 
 #include "rttbBaseType.h"
@@ -45,6 +47,8 @@ namespace rttb
 			2) test getDoseAt()
 				a) with Identity transform
 				b) with translation transform
+				c) batch transformation
+				d) resample() with translation transform (affine mapping in index space)
 		*/
 
 		int SimpleMappableDoseAccessorWithITKTest(int argc, char* argv[])
@@ -164,6 +168,43 @@ namespace rttb
 				            aSimpleMappableDoseAccessorITKTranslation->getValueAt(currentId));
 			}
 
+			//	c) test the batch transformation (same results as the transformation of the single points)
+			std::vector<WorldCoordinate3D> targetCoordinates;
+			targetCoordinates.push_back(WorldCoordinate3D(0.0, 0.0, 0.0));
+			targetCoordinates.push_back(WorldCoordinate3D(-12.5, 3.25, 100.0));
+			targetCoordinates.push_back(WorldCoordinate3D(7.0, -1000.0, 0.5));
+			std::vector<WorldCoordinate3D> movingCoordinates(targetCoordinates.size());
+
+			CHECK(transformITKTranslation->transformInverseBatch(targetCoordinates.data(), targetCoordinates.size(),
+			                                                     movingCoordinates.data()));
+
+			for (size_t i = 0; i < targetCoordinates.size(); i++)
+			{
+				WorldCoordinate3D movingCoordinate;
+				CHECK(transformITKTranslation->transformInverse(targetCoordinates.at(i), movingCoordinate));
+				CHECK_EQUAL(movingCoordinates.at(i), movingCoordinate);
+			}
+
+			CHECK(transformITKTranslation->transformInverseBatch(nullptr, 0, nullptr));
+
+			//	d) test resample() with translation transform: the translation is detected as affine transformation and mapped in
+			//	index space, the values have to be the same as getValueAt()
+			std::array<std::array<double, 3>, 3> affineMatrix;
+			std::array<double, 3> affineOffset;
+			CHECK(transformITKTranslation->getInverseAffineParameters(affineMatrix, affineOffset));
+			CHECK_EQUAL(affineMatrix[0][0], 1.0);
+			CHECK_EQUAL(affineMatrix[0][1], 0.0);
+			CHECK_EQUAL(affineOffset[0], 5.0);
+
+			core::GenericMutableDoseAccessor::Pointer resampledDose;
+			CHECK_NO_THROW(resampledDose = aSimpleMappableDoseAccessorITKTranslation->resample());
+
+			for (VoxelGridID id = 0; id < static_cast<VoxelGridID>(resampledDose->getGridSize()); ++id)
+			{
+				CHECK_CLOSE(resampledDose->getValueAt(id), aSimpleMappableDoseAccessorITKTranslation->getValueAt(id),
+				            errorConstant);
+			}
+
 
 			RETURN_AND_REPORT_TEST_SUCCESS;
 		}
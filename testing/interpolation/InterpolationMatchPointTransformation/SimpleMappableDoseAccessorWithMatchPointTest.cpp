@@ -52,6 +52,7 @@ namespace rttb
 			2) test getDoseAt()
 				a) with Identity transform
 				b) with translation transform
+				c) batch transformation
 			[3) test with rigid registration optional (if filenames are given as argument)]
 		*/
 
@@ -172,6 +173,25 @@ namespace rttb
 			CHECK_EQUAL(aSimpleMappableDoseAccessorMPTranslationNN->getValueAt(aIndexBeforeTransformation3),
 			            doseAccessor2->getValueAt(aIndexAfterTransformation3));
 
+			//	c) test the batch transformation (same results as the transformation of the single points)
+			std::vector<WorldCoordinate3D> targetCoordinates;
+			targetCoordinates.push_back(WorldCoordinate3D(0.0, 0.0, 0.0));
+			targetCoordinates.push_back(WorldCoordinate3D(-12.5, 3.25, 100.0));
+			targetCoordinates.push_back(WorldCoordinate3D(7.0, -1000.0, 0.5));
+			std::vector<WorldCoordinate3D> movingCoordinates(targetCoordinates.size());
+
+			CHECK(transformMP->transformInverseBatch(targetCoordinates.data(), targetCoordinates.size(),
+			                                         movingCoordinates.data()));
+
+			for (size_t i = 0; i < targetCoordinates.size(); i++)
+			{
+				WorldCoordinate3D movingCoordinate;
+				CHECK(transformMP->transformInverse(targetCoordinates.at(i), movingCoordinate));
+				CHECK_EQUAL(movingCoordinates.at(i), movingCoordinate);
+			}
+
+			CHECK(transformMP->transformInverseBatch(nullptr, 0, nullptr));
+
 			if (RTDOSE_FILENAME_REALISTIC != "" && CT_FRACTION != "" && CT_PLANNING != "")
 			{
 				//3) test with rigid registration
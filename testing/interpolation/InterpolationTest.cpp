@@ -13,6 +13,8 @@
 //
 //------------------------------------------------------------------------
 
+#include <array>
+#include <cmath>
 #include <vector>
 
 #include <boost/shared_ptr.hpp>
@@ -29,6 +31,8 @@
 #include "rttbNullPointerException.h"
 #include "rttbMappingOutsideOfImageException.h"
 
+#include "../core/DummyDoseAccessor.h"
+
 namespace rttb
 {
 	namespace testing
@@ -43,6 +47,10 @@ namespace rttb
 				2) test both interpolation types with increasing x image values image (Dose = y value)
 				3) test right corner interpolation
 				4) test exception handling
+				5) test batch interpolation (getValues)
+				6) test interpolation on a line in index space (getInsideRangeOnLine/getValuesOnLine)
+				7) test that the interpolation agrees with GeometricInfo at the image borders (rotated image, non-integer spacing)
+				8) test linear interpolation on flipped and permuted images (neighbors are chosen in index space)
 			*/
 
 		int InterpolationTest(int argc, char* argv[])
@@ -215,6 +223,162 @@ namespace rttb
 			CHECK_NO_THROW(boost::make_shared<NearestNeighborInterpolation>());
 			CHECK_NO_THROW(boost::make_shared<LinearInterpolation>());
 
+			//TEST 5) batch interpolation has to return the same values as the interpolation of single coordinates
+			std::vector<DoseTypeGy> batchValuesNN(coordinatesToCheck.size(), -1);
+			std::vector<DoseTypeGy> batchValuesLinear(coordinatesToCheck.size(), -1);
+			CHECK_NO_THROW(interpolationNN2->getValues(coordinatesToCheck.data(), coordinatesToCheck.size(),
+			               batchValuesNN.data()));
+			CHECK_NO_THROW(interpolationLinear2->getValues(coordinatesToCheck.data(), coordinatesToCheck.size(),
+			               batchValuesLinear.data()));
+
+			for (size_t i = 0; i < coordinatesToCheck.size(); ++i)
+			{
+				CHECK_EQUAL(batchValuesNN[i], interpolationNN2->getValue(coordinatesToCheck[i]));
+				CHECK_EQUAL(batchValuesLinear[i], interpolationLinear2->getValue(coordinatesToCheck[i]));
+			}
+
+			std::vector<WorldCoordinate3D> coordinatesWithOutside = {coordinatesToCheck.front(), positionOutsideOfImageRight};
+			CHECK_THROW_EXPLICIT(interpolationLinear2->getValues(coordinatesWithOutside.data(), coordinatesWithOutside.size(),
+			                     batchValuesLinear.data()), core::MappingOutsideOfImageException);
+			CHECK_THROW_EXPLICIT(interpolationNullLinear->getValues(coordinatesToCheck.data(), 1, batchValuesLinear.data()),
+			                     core::NullPointerException);
+
+			//TEST 6) the points of a line in index space (start + i * step) have to be interpolated like their world coordinates.
+			//The line starts before the image and leaves it on the right side (no point is at a voxel border).
+			const core::GeometricInfo& geoInfo2 = doseAccessor2->getGeometricInfo();
+			const std::array<double, 3> lineStart = {{-2.2, 2.25, 1.6}};
+			const std::array<double, 3> lineStep = {{1.25, 0.0, 0.0}};
+			const size_t numberOfLinePoints = size[0] + 3;
+			size_t firstInsidePoint = 0;
+			size_t endInsidePoint = 0;
+			CHECK_NO_THROW(interpolationLinear2->getInsideRangeOnLine(lineStart, lineStep, numberOfLinePoints, firstInsidePoint,
+			               endInsidePoint));
+			CHECK_EQUAL(firstInsidePoint, static_cast<size_t>(2));
+			CHECK(endInsidePoint < numberOfLinePoints);
+
+			std::vector<WorldCoordinate3D> lineCoordinates(numberOfLinePoints);
+
+			for (size_t i = 0; i < numberOfLinePoints; ++i)
+			{
+				geoInfo2.continuousIndexToWorldCoordinate(ContinuousVoxelGridIndex3D(lineStart[0] + lineStep[0] * i, lineStart[1],
+				        lineStart[2]), lineCoordinates[i]);
+				CHECK_EQUAL(i >= firstInsidePoint && i < endInsidePoint, interpolationLinear2->isInside(lineCoordinates[i]));
+			}
+
+			std::vector<DoseTypeGy> lineValuesNN(numberOfLinePoints, -1);
+			std::vector<DoseTypeGy> lineValuesLinear(numberOfLinePoints, -1);
+			CHECK_NO_THROW(interpolationNN2->getValuesOnLine(lineStart, lineStep, firstInsidePoint, endInsidePoint,
+			               lineValuesNN.data()));
+			CHECK_NO_THROW(interpolationLinear2->getValuesOnLine(lineStart, lineStep, firstInsidePoint, endInsidePoint,
+			               lineValuesLinear.data()));
+
+			for (size_t i = firstInsidePoint; i < endInsidePoint; ++i)
+			{
+				CHECK_EQUAL(lineValuesNN[i - firstInsidePoint], interpolationNN2->getValue(lineCoordinates[i]));
+				CHECK_CLOSE(lineValuesLinear[i - firstInsidePoint], interpolationLinear2->getValue(lineCoordinates[i]), errorConstant);
+			}
+
+			CHECK_THROW_EXPLICIT(interpolationLinear2->getValuesOnLine(lineStart, lineStep, 0, numberOfLinePoints,
+			                     lineValuesLinear.data()), core::MappingOutsideOfImageException);
+			CHECK_THROW_EXPLICIT(interpolationNullLinear->getInsideRangeOnLine(lineStart, lineStep, numberOfLinePoints,
+			                     firstInsidePoint, endInsidePoint), core::NullPointerException);
+			CHECK_THROW_EXPLICIT(interpolationNullNN->getValuesOnLine(lineStart, lineStep, 0, 1, lineValuesNN.data()),
+			                     core::NullPointerException);
+
+			//TEST 7) points within a few ulps of the image borders have to be inside exactly if GeometricInfo says so, and
+			//nearest neighbor has to return the voxel GeometricInfo maps them to
+			core::GeometricInfo rotatedGeoInfo;
+			rotatedGeoInfo.setImageSize(ImageSize(7, 5, 3));
+			rotatedGeoInfo.setSpacing(SpacingVectorType3D(0.3, 0.7, 1.1));
+			rotatedGeoInfo.setImagePositionPatient(WorldCoordinate3D(-12.3, 4.1, 0.7));
+			OrientationMatrix rotatedOrientation;
+			rotatedOrientation(0, 0) = std::cos(0.5);
+			rotatedOrientation(0, 1) = -std::sin(0.5);
+			rotatedOrientation(1, 0) = std::sin(0.5);
+			rotatedOrientation(1, 1) = std::cos(0.5);
+			rotatedGeoInfo.setOrientationMatrix(rotatedOrientation);
+
+			std::vector<DoseTypeGy> rotatedDoseVector(rotatedGeoInfo.getNumberOfVoxels());
+
+			for (size_t i = 0; i < rotatedDoseVector.size(); ++i)
+			{
+				rotatedDoseVector[i] = static_cast<DoseTypeGy>(i);
+			}
+
+			auto rotatedDoseAccessor = boost::make_shared<DummyDoseAccessor>(rotatedDoseVector, rotatedGeoInfo);
+			auto interpolationNNRotated = boost::make_shared<NearestNeighborInterpolation>();
+			interpolationNNRotated->setAccessorPointer(rotatedDoseAccessor);
+
+			const double rotatedSize[] = {7, 5, 3};
+
+			for (unsigned int dimension = 0; dimension < 3; ++dimension)
+			{
+				for (double border : {-0.5, rotatedSize[dimension] - 0.5})
+				{
+					for (int ulps = -20; ulps <= 20; ++ulps)
+					{
+						ContinuousVoxelGridIndex3D borderIndex(2.1, 1.7, 1.3);
+						borderIndex(dimension) = border + ulps * 1e-15;
+						WorldCoordinate3D borderCoordinate;
+						rotatedGeoInfo.continuousIndexToWorldCoordinate(borderIndex, borderCoordinate);
+
+						VoxelGridIndex3D nearestIndex;
+						const bool isInside = rotatedGeoInfo.worldCoordinateToIndex(borderCoordinate, nearestIndex);
+						CHECK_EQUAL(interpolationNNRotated->isInside(borderCoordinate), isInside);
+
+						if (isInside)
+						{
+							VoxelGridID nearestID = 0;
+							rotatedGeoInfo.convert(nearestIndex, nearestID);
+							CHECK_EQUAL(interpolationNNRotated->getValue(borderCoordinate), rotatedDoseVector[nearestID]);
+						}
+					}
+				}
+			}
+
+			//TEST 8) the dose is linear in the voxel index, so the linear interpolation has to return the same linear function of
+			//the continuous index for every orientation of the image (the neighbors and weights are determined in index space)
+			OrientationMatrix flippedOrientation;
+			flippedOrientation(0, 0) = -1;
+			flippedOrientation(2, 2) = -1;
+			OrientationMatrix permutedOrientation(0);
+			permutedOrientation(1, 0) = 1;
+			permutedOrientation(2, 1) = 1;
+			permutedOrientation(0, 2) = 1;
+
+			for (const OrientationMatrix& orientation : {flippedOrientation, permutedOrientation, rotatedOrientation})
+			{
+				core::GeometricInfo orientedGeoInfo;
+				orientedGeoInfo.setImageSize(ImageSize(6, 5, 4));
+				orientedGeoInfo.setSpacing(SpacingVectorType3D(1.5, 2.0, 2.5));
+				orientedGeoInfo.setImagePositionPatient(WorldCoordinate3D(3.1, -4.2, 5.3));
+				orientedGeoInfo.setOrientationMatrix(orientation);
+
+				std::vector<DoseTypeGy> linearDoseVector(orientedGeoInfo.getNumberOfVoxels());
+
+				for (VoxelGridID id = 0; id < static_cast<VoxelGridID>(linearDoseVector.size()); ++id)
+				{
+					VoxelGridIndex3D voxelIndex;
+					orientedGeoInfo.convert(id, voxelIndex);
+					linearDoseVector[id] = 1.0 * voxelIndex(0) + 10.0 * voxelIndex(1) + 100.0 * voxelIndex(2);
+				}
+
+				auto orientedDoseAccessor = boost::make_shared<DummyDoseAccessor>(linearDoseVector, orientedGeoInfo);
+				auto interpolationLinearOriented = boost::make_shared<LinearInterpolation>();
+				interpolationLinearOriented->setAccessorPointer(orientedDoseAccessor);
+
+				for (const ContinuousVoxelGridIndex3D& continuousIndex : {ContinuousVoxelGridIndex3D(0.25, 1.5, 2.75),
+				        ContinuousVoxelGridIndex3D(3.6, 0.1, 1.3), ContinuousVoxelGridIndex3D(4.9, 3.45, 0.5),
+				        ContinuousVoxelGridIndex3D(2.0, 2.0, 2.0)
+				                                                        })
+				{
+					WorldCoordinate3D orientedCoordinate;
+					orientedGeoInfo.continuousIndexToWorldCoordinate(continuousIndex, orientedCoordinate);
+					CHECK_CLOSE(interpolationLinearOriented->getValue(orientedCoordinate),
+					            continuousIndex(0) + 10.0 * continuousIndex(1) + 100.0 * continuousIndex(2), errorConstant);
+				}
+			}
+
 			RETURN_AND_REPORT_TEST_SUCCESS;
 		}
 	}
@@ -38,6 +38,7 @@ namespace rttb
 		/*! @brief RosuMappableDoseAccessorTest - test the API of RosuMappableDoseAccessor
 			1) Constructor
 			2) test getDoseAt()
+			3) test resample()
 		*/
 
 		int RosuMappableDoseAccessorTest(int argc, char* argv[])
@@ -136,6 +137,18 @@ namespace rttb
 			CHECK_THROW_EXPLICIT(aRosuMappableDoseAccessorNoPadding->getValueAt(invalidIndex),
 			                     core::MappingOutsideOfImageException);
 
+			//3) test resample(): same values as getValueAt() for all voxels
+			core::GenericMutableDoseAccessor::Pointer resampledDose;
+			CHECK_NO_THROW(resampledDose = aRosuMappableDoseAccessorDefault->resample());
+			CHECK_EQUAL(resampledDose->getGeometricInfo(), doseAccessor1->getGeometricInfo());
+			CHECK_EQUAL(resampledDose->getUID(), aRosuMappableDoseAccessorDefault->getUID());
+
+			for (VoxelGridID id = 0; id < static_cast<VoxelGridID>(resampledDose->getGridSize()); ++id)
+			{
+				CHECK_EQUAL(resampledDose->getValueAt(id), aRosuMappableDoseAccessorDefault->getValueAt(id));
+			}
+
+			CHECK_NO_THROW(aRosuMappableDoseAccessorNoPadding->resample());
 
 			RETURN_AND_REPORT_TEST_SUCCESS;
 		}
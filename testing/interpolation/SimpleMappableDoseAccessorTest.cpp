@@ -41,7 +41,9 @@ namespace rttb
 
 		/*! @brief SimpleMappableDoseAccessorTest - test the API of SimpleMappableDoseAccessor
 			1) Test constructor
-			2) test getDoseAt()
+			2) test getGeometricInfo(), getGridSize(), getDoseUID()
+			3) test getDoseAt()
+			4) test resample()
 		*/
 
 		int SimpleMappableDoseAccessorTest(int argc, char* argv[])
@@ -155,6 +157,24 @@ namespace rttb
 			CHECK_THROW_EXPLICIT(aSimpleMappableDoseAccessorNoPadding->getValueAt(invalidIndex),
 			                     core::MappingOutsideOfImageException);
 
+			//4) test resample(): same values as getValueAt() for all voxels
+			auto aSimpleMappableDoseAccessorNN = boost::make_shared<SimpleMappableDoseAccessor>(
+			        doseAccessor1->getGeometricInfo(), doseAccessor2, transformDummy, interpolationNN);
+			core::GenericMutableDoseAccessor::Pointer resampledDose;
+			core::GenericMutableDoseAccessor::Pointer resampledDoseNN;
+			CHECK_NO_THROW(resampledDose = aSimpleMappableDoseAccessorDefault->resample());
+			CHECK_NO_THROW(resampledDoseNN = aSimpleMappableDoseAccessorNN->resample());
+			CHECK_EQUAL(resampledDose->getGeometricInfo(), doseAccessor1GeometricInfo);
+			CHECK_EQUAL(resampledDose->getUID(), doseAccessor2->getUID());
+
+			for (VoxelGridID id = 0; id < static_cast<VoxelGridID>(resampledDose->getGridSize()); ++id)
+			{
+				CHECK_EQUAL(resampledDose->getValueAt(id), aSimpleMappableDoseAccessorDefault->getValueAt(id));
+				CHECK_EQUAL(resampledDoseNN->getValueAt(id), aSimpleMappableDoseAccessorNN->getValueAt(id));
+			}
+
+			CHECK_NO_THROW(aSimpleMappableDoseAccessorNoPadding->resample());
+
 			RETURN_AND_REPORT_TEST_SUCCESS;
 		}
 
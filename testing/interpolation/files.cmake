@@ -2,10 +2,13 @@ SET(CPP_FILES
 	SimpleMappableDoseAccessorTest.cpp
 	RosuMappableDoseAccessorTest.cpp
 	InterpolationTest.cpp
+	DisplacementFieldTransformationTest.cpp
 	DummyTransformation.cpp
+	../core/DummyDoseAccessor.cpp
 	rttbInterpolationTests.cpp
    )
 
 SET(H_FILES
 	DummyTransformation.h
+	../core/DummyDoseAccessor.h
    )
@@ -31,6 +31,7 @@ namespace rttb
 			LIT_REGISTER_TEST(SimpleMappableDoseAccessorTest);
 			LIT_REGISTER_TEST(RosuMappableDoseAccessorTest);
 			LIT_REGISTER_TEST(InterpolationTest);
+			LIT_REGISTER_TEST(DisplacementFieldTransformationTest);
 		}
 	}
 }
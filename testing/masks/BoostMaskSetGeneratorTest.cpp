@@ -0,0 +1,145 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "litCheckMacros.h"
+
+#include "rttbBaseType.h"
+
+#include "../core/DummyStructure.h"
+#include "../core/DummyDoseAccessor.h"
+#include "rttbStructureSet.h"
+#include "rttbBoostMaskAccessor.h"
+#include "rttbBoostMaskSetGenerator.h"
+#include "rttbInvalidParameterException.h"
+#include "rttbNullPointerException.h"
+
+namespace rttb
+{
+	namespace testing
+	{
+
+		/*! @brief BoostMaskSetGeneratorTest - tests the voxelization of several structures of a structure set in one job
+			1) test constructor
+			2) test label filter
+			3) test generateMasks (same voxels as separate BoostMaskAccessors)
+			4) test exceptions
+		*/
+		int BoostMaskSetGeneratorTest(int argc, char* argv[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			boost::shared_ptr<DummyDoseAccessor> spTestDoseAccessor = boost::make_shared<DummyDoseAccessor>();
+			const core::GeometricInfo& geometricInfo = spTestDoseAccessor->getGeometricInfo();
+
+			DummyStructure myStructGenerator(geometricInfo);
+
+			std::vector<core::Structure::Pointer> structures;
+			structures.push_back(boost::make_shared<core::Structure>(myStructGenerator.CreateRectangularStructureCentered(2, 3)));
+			structures.back()->setLabel("Liver");
+			structures.push_back(boost::make_shared<core::Structure>(myStructGenerator.CreateTestStructureCircle(4)));
+			structures.back()->setLabel("Kidney_left");
+			structures.push_back(boost::make_shared<core::Structure>(myStructGenerator.CreateRectangularStructureCentered(2, 3, 6, 7)));
+			structures.back()->setLabel("Kidney_right");
+
+			core::StructureSet::Pointer spStructureSet = boost::make_shared<core::StructureSet>(structures);
+
+			//1) test constructor
+			CHECK_NO_THROW(masks::boost::BoostMaskSetGenerator(spStructureSet, geometricInfo));
+			CHECK_THROW_EXPLICIT(masks::boost::BoostMaskSetGenerator(core::StructureSet::Pointer(), geometricInfo),
+			                     core::NullPointerException);
+
+			masks::boost::BoostMaskSetGenerator generator(spStructureSet, geometricInfo);
+
+			//2) test label filter
+			CHECK_EQUAL(generator.getStructureLabelFilterActive(), false);
+			std::vector<size_t> expectedIndices{ 0, 1, 2 };
+			CHECK(generator.getSelectedStructureIndices() == expectedIndices);
+
+			generator.setFilterRegEx("Kidney.*");
+			CHECK_EQUAL(generator.getFilterRegEx(), "Kidney.*");
+			//the filter is not active yet
+			CHECK(generator.getSelectedStructureIndices() == expectedIndices);
+
+			generator.setStructureLabelFilterActive(true);
+			CHECK_EQUAL(generator.getStructureLabelFilterActive(), true);
+			expectedIndices = { 1, 2 };
+			CHECK(generator.getSelectedStructureIndices() == expectedIndices);
+
+			generator.setFilterRegEx("Lung");
+			CHECK(generator.getSelectedStructureIndices().empty());
+			CHECK(generator.generateMasks().empty());
+
+			//3) test generateMasks
+			generator.setFilterRegEx("Kidney.*");
+			masks::boost::BoostMaskSetGenerator::MaskAccessorVector maskAccessors;
+			CHECK_NO_THROW(maskAccessors = generator.generateMasks());
+			CHECK_EQUAL(maskAccessors.size(), 2);
+
+			for (size_t i = 0; i < maskAccessors.size(); ++i)
+			{
+				masks::boost::BoostMaskAccessor referenceAccessor(structures[expectedIndices[i]], geometricInfo);
+				core::MaskAccessorInterface::MaskVoxelList referenceVoxels = *(referenceAccessor.getRelevantVoxelVector());
+				core::MaskAccessorInterface::MaskVoxelList voxels = *(maskAccessors[i]->getRelevantVoxelVector());
+
+				CHECK(!voxels.empty());
+				std::sort(referenceVoxels.begin(), referenceVoxels.end());
+				std::sort(voxels.begin(), voxels.end());
+				CHECK(voxels == referenceVoxels);
+				CHECK(maskAccessors[i]->getGeometricInfo() == geometricInfo);
+			}
+
+			//explicit indices ignore the filter, the order of the indices is kept
+			CHECK_NO_THROW(maskAccessors = generator.generateMasks({ 2, 0 }));
+			CHECK_EQUAL(maskAccessors.size(), 2);
+			CHECK_EQUAL(maskAccessors[0]->getRelevantVoxelVector()->size(),
+			            masks::boost::BoostMaskAccessor(structures[2], geometricInfo).getRelevantVoxelVector()->size());
+			CHECK_EQUAL(maskAccessors[1]->getRelevantVoxelVector()->size(),
+			            masks::boost::BoostMaskAccessor(structures[0], geometricInfo).getRelevantVoxelVector()->size());
+			CHECK(maskAccessors[0]->getMaskUID() != maskAccessors[1]->getMaskUID());
+
+			//4) test exceptions
+			CHECK_THROW_EXPLICIT(generator.generateMasks({ 0, 3 }), core::InvalidParameterException);
+
+			//two overlapping contours in the same plane: volume fractions > 1
+			PolygonSequenceType overlappingContours = myStructGenerator.CreateRectangularStructureCentered(2).getStructureVector();
+			PolygonType shiftedContour = overlappingContours.front();
+
+			for (auto& point : shiftedContour)
+			{
+				point(0) += 2.0;
+			}
+
+			overlappingContours.push_back(shiftedContour);
+			structures.push_back(boost::make_shared<core::Structure>(overlappingContours));
+			core::StructureSet::Pointer spIntersectingStructureSet = boost::make_shared<core::StructureSet>(structures);
+
+			masks::boost::BoostMaskSetGenerator strictGenerator(spIntersectingStructureSet, geometricInfo, true);
+			CHECK_THROW_EXPLICIT(strictGenerator.generateMasks(), core::InvalidParameterException);
+
+			masks::boost::BoostMaskSetGenerator nonStrictGenerator(spIntersectingStructureSet, geometricInfo, false);
+			CHECK_NO_THROW(maskAccessors = nonStrictGenerator.generateMasks());
+			CHECK_EQUAL(maskAccessors.size(), 4);
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+
+	}//testing
+}//rttb
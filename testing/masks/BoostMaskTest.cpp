@@ -241,6 +241,40 @@ namespace rttb
 				spTestDoseAccessor->getGeometricInfo(), true);
 			CHECK_NO_THROW(boostMaskAccessor3.getRelevantVoxelVector());
 
+			//4) test scanline voxelization, it has to yield the same mask as the boost::geometry voxelization
+			CHECK_NO_THROW(rttb::masks::boost::BoostMask(geometricPtr, spMyStruct, true, 0,
+			               rttb::masks::boost::VoxelizationMethod::Scanline));
+			rttb::masks::boost::BoostMaskAccessor scanlineMaskAccessor(spMyStruct,
+			        spTestDoseAccessor->getGeometricInfo(), true, rttb::masks::boost::VoxelizationMethod::Scanline);
+			rttb::masks::boost::BoostMaskAccessor scanlineMaskAccessor2(spMyStruct2,
+			        spTestDoseAccessor->getGeometricInfo(), true, rttb::masks::boost::VoxelizationMethod::Scanline);
+			CHECK_NO_THROW(scanlineMaskAccessor.getRelevantVoxelVector());
+			CHECK_NO_THROW(scanlineMaskAccessor2.getRelevantVoxelVector());
+			CHECK_EQUAL(boostMaskAccessor.getRelevantVoxelVector()->size(),
+			            scanlineMaskAccessor.getRelevantVoxelVector()->size());
+			CHECK_EQUAL(boostMaskAccessor2.getRelevantVoxelVector()->size(),
+			            scanlineMaskAccessor2.getRelevantVoxelVector()->size());
+
+			for (const auto& maskVoxel : *(boostMaskAccessor.getRelevantVoxelVector()))
+			{
+				CHECK(scanlineMaskAccessor.getMaskAt(maskVoxel.getVoxelGridID(), tmpMV1));
+				CHECK_CLOSE(maskVoxel.getRelevantVolumeFraction(), tmpMV1.getRelevantVolumeFraction(),
+				            errorConstantBoostMask);
+			}
+
+			for (const auto& maskVoxel : *(boostMaskAccessor2.getRelevantVoxelVector()))
+			{
+				CHECK(scanlineMaskAccessor2.getMaskAt(maskVoxel.getVoxelGridID(), tmpMV1));
+				CHECK_CLOSE(maskVoxel.getRelevantVolumeFraction(), tmpMV1.getRelevantVolumeFraction(),
+				            errorConstantBoostMask);
+			}
+
+			CHECK(scanlineMaskAccessor.getMaskAt(inMask2, tmpMV1));
+			CHECK_EQUAL(1, tmpMV1.getRelevantVolumeFraction());
+			CHECK(scanlineMaskAccessor2.getMaskAt(inMask2, tmpMV1));
+			CHECK_EQUAL(0.75, tmpMV1.getRelevantVolumeFraction());
+			CHECK(!scanlineMaskAccessor.getMaskAt(outMask1, tmpMV1));
+
             RETURN_AND_REPORT_TEST_SUCCESS;
 		}
 	}//testing
@@ -0,0 +1,155 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include <boost/make_shared.hpp>
+
+#include "litCheckMacros.h"
+
+#include "rttbBaseType.h"
+#include "rttbGeometricInfo.h"
+#include "rttbMaskVoxel.h"
+#include "rttbMaskVoxelIndex.h"
+#include "rttbGenericMutableMaskAccessor.h"
+
+namespace rttb
+{
+	namespace testing
+	{
+
+		/*! @brief MaskVoxelIndexTest - tests the random access to mask voxel lists
+			1) test dense index
+			2) test sparse index
+			3) test duplicated IDs (the first voxel is found)
+			4) test addLastVoxel and reset
+			5) test GenericMutableMaskAccessor getMaskAt/setMaskAt
+		*/
+		int MaskVoxelIndexTest(int argc, char* argv[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			typedef masks::MaskVoxelIndex MaskVoxelIndex;
+			typedef core::MaskAccessorInterface::MaskVoxelList MaskVoxelList;
+
+			core::GeometricInfo geoInfo;
+			geoInfo.setImageSize(ImageSize(10, 20, 30));
+			const VoxelGridID sliceSize = 10 * 20;
+
+			//1) test dense index: a filled block, unsorted
+			MaskVoxelList denseList;
+
+			for (VoxelGridID z = 5; z >= 3; --z)
+			{
+				for (VoxelGridID y = 2; y < 6; ++y)
+				{
+					for (VoxelGridID x = 1; x < 4; ++x)
+					{
+						denseList.push_back(core::MaskVoxel(z * sliceSize + y * 10 + x, 0.5));
+					}
+				}
+			}
+
+			MaskVoxelIndex denseIndex(geoInfo);
+			CHECK_EQUAL(denseIndex.find(denseList, 0), MaskVoxelIndex::notFound);
+			CHECK(denseIndex.isDense());
+
+			for (size_t i = 0; i < denseList.size(); ++i)
+			{
+				CHECK_EQUAL(denseIndex.find(denseList, denseList[i].getVoxelGridID()), i);
+			}
+
+			//inside and outside of the bounding box, but not in the list
+			CHECK_EQUAL(denseIndex.find(denseList, 4 * sliceSize + 2 * 10 + 4), MaskVoxelIndex::notFound);
+			CHECK_EQUAL(denseIndex.find(denseList, 4 * sliceSize + 2 * 10 + 0), MaskVoxelIndex::notFound);
+			CHECK_EQUAL(denseIndex.find(denseList, 6 * sliceSize + 2 * 10 + 1), MaskVoxelIndex::notFound);
+			CHECK_EQUAL(denseIndex.find(denseList, -1), MaskVoxelIndex::notFound);
+
+			//2) test sparse index: few voxels far apart
+			MaskVoxelList sparseList;
+			sparseList.push_back(core::MaskVoxel(29 * sliceSize + 199, 1));
+			sparseList.push_back(core::MaskVoxel(0, 0.1));
+			sparseList.push_back(core::MaskVoxel(15 * sliceSize + 55, 0.2));
+
+			MaskVoxelIndex sparseIndex(geoInfo);
+			CHECK_EQUAL(sparseIndex.find(sparseList, 0), 1);
+			CHECK(!sparseIndex.isDense());
+			CHECK_EQUAL(sparseIndex.find(sparseList, 29 * sliceSize + 199), 0);
+			CHECK_EQUAL(sparseIndex.find(sparseList, 15 * sliceSize + 55), 2);
+			CHECK_EQUAL(sparseIndex.find(sparseList, 15 * sliceSize + 56), MaskVoxelIndex::notFound);
+
+			MaskVoxelIndex emptyIndex(geoInfo);
+			CHECK_EQUAL(emptyIndex.find(MaskVoxelList(), 0), MaskVoxelIndex::notFound);
+
+			//3) test duplicated IDs
+			MaskVoxelList duplicateList = denseList;
+			duplicateList.push_back(core::MaskVoxel(denseList[3].getVoxelGridID(), 1));
+			MaskVoxelIndex duplicateIndex(geoInfo);
+			CHECK_EQUAL(duplicateIndex.find(duplicateList, denseList[3].getVoxelGridID()), 3);
+
+			MaskVoxelList sparseDuplicateList = sparseList;
+			sparseDuplicateList.push_back(core::MaskVoxel(0, 1));
+			MaskVoxelIndex sparseDuplicateIndex(geoInfo);
+			CHECK_EQUAL(sparseDuplicateIndex.find(sparseDuplicateList, 0), 1);
+
+			//4) test addLastVoxel and reset
+			denseList.push_back(core::MaskVoxel(4 * sliceSize + 2 * 10 + 0, 0.3));
+			denseIndex.addLastVoxel(denseList);
+			CHECK_EQUAL(denseIndex.find(denseList, 4 * sliceSize + 2 * 10 + 0), denseList.size() - 1);
+			denseList.push_back(core::MaskVoxel(28 * sliceSize, 0.3));
+			denseIndex.addLastVoxel(denseList);
+			CHECK_EQUAL(denseIndex.find(denseList, 28 * sliceSize), denseList.size() - 1);
+			CHECK_EQUAL(denseIndex.find(denseList, denseList[0].getVoxelGridID()), 0);
+
+			sparseList.push_back(core::MaskVoxel(7, 0.3));
+			sparseIndex.addLastVoxel(sparseList);
+			CHECK_EQUAL(sparseIndex.find(sparseList, 7), 3);
+
+			//the list was changed without a change of its size
+			sparseList[0] = core::MaskVoxel(8, 1);
+			sparseIndex.reset();
+			CHECK_EQUAL(sparseIndex.find(sparseList, 8), 0);
+			CHECK_EQUAL(sparseIndex.find(sparseList, 29 * sliceSize + 199), MaskVoxelIndex::notFound);
+
+			//an index that is not up to date is built again by find()
+			sparseList.push_back(core::MaskVoxel(9, 0.3));
+			sparseList.push_back(core::MaskVoxel(10, 0.3));
+			sparseIndex.addLastVoxel(sparseList);
+			CHECK_EQUAL(sparseIndex.find(sparseList, 9), 4);
+			CHECK_EQUAL(sparseIndex.find(sparseList, 10), 5);
+
+			//5) test GenericMutableMaskAccessor
+			masks::GenericMutableMaskAccessor accessor(geoInfo);
+			accessor.setRelevantVoxelVector(boost::make_shared<MaskVoxelList>(sparseList));
+			core::MaskVoxel voxel(0);
+			CHECK(accessor.getMaskAt(7, voxel));
+			CHECK_EQUAL(voxel.getRelevantVolumeFraction(), 0.3);
+			CHECK(!accessor.getMaskAt(11, voxel));
+
+			accessor.setMaskAt(7, core::MaskVoxel(7, 0.7));
+			accessor.setMaskAt(11, core::MaskVoxel(11, 0.8));
+			CHECK(accessor.getMaskAt(7, voxel));
+			CHECK_EQUAL(voxel.getRelevantVolumeFraction(), 0.7);
+			CHECK(accessor.getMaskAt(11, voxel));
+			CHECK_EQUAL(voxel.getRelevantVolumeFraction(), 0.8);
+			CHECK_EQUAL(accessor.getRelevantVoxelVector()->size(), sparseList.size() + 1);
+
+			accessor.setRelevantVoxelVector(boost::make_shared<MaskVoxelList>(denseList));
+			CHECK(!accessor.getMaskAt(11, voxel));
+			CHECK(accessor.getMaskAt(denseList[5].getVoxelGridID(), voxel));
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+
+	}//testing
+}//rttb
@@ -0,0 +1,98 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "litCheckMacros.h"
+
+#include "rttbMonotonicArena.h"
+
+namespace rttb
+{
+	namespace testing
+	{
+
+		/*! @brief MonotonicArenaTest.
+			1) test allocation and alignment
+			2) test release
+			3) test ArenaAllocator with and without current arena
+		*/
+		int MonotonicArenaTest(int argc, char* argv[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			typedef masks::boost::MonotonicArena MonotonicArena;
+
+			//1) test allocation and alignment
+			MonotonicArena arena(256);
+
+			void* first = arena.allocate(3, 1);
+			void* second = arena.allocate(sizeof(double), alignof(double));
+			CHECK(first != nullptr);
+			CHECK(second != nullptr);
+			CHECK(first != second);
+			CHECK_EQUAL(0, reinterpret_cast<std::uintptr_t>(second) % alignof(double));
+
+			//requests bigger than the block size get their own block
+			void* big = arena.allocate(1000, alignof(double));
+			CHECK(big != nullptr);
+			CHECK_EQUAL(0, reinterpret_cast<std::uintptr_t>(big) % alignof(double));
+
+			//2) test release: the memory is reused
+			arena.release();
+			CHECK_EQUAL(first, arena.allocate(3, 1));
+
+			//3) test ArenaAllocator
+			CHECK(MonotonicArena::getCurrent() == nullptr);
+			{
+				MonotonicArena::Scope scope(arena);
+				CHECK(MonotonicArena::getCurrent() == &arena);
+
+				masks::boost::ArenaAllocator<int> allocator;
+				CHECK(allocator.getArena() == &arena);
+
+				std::vector<int, masks::boost::ArenaAllocator<int> > values;
+
+				for (int i = 0; i < 1000; ++i)
+				{
+					values.push_back(i);
+				}
+
+				CHECK_EQUAL(1000, values.size());
+				CHECK_EQUAL(999, values.back());
+
+				std::deque<double, masks::boost::ArenaAllocator<double> > copy(values.begin(), values.end());
+				CHECK_EQUAL(500, copy[500]);
+
+				{
+					MonotonicArena nestedArena;
+					MonotonicArena::Scope nestedScope(nestedArena);
+					CHECK(MonotonicArena::getCurrent() == &nestedArena);
+				}
+				CHECK(MonotonicArena::getCurrent() == &arena);
+			}
+			CHECK(MonotonicArena::getCurrent() == nullptr);
+
+			//without arena the allocator uses the heap
+			std::vector<int, masks::boost::ArenaAllocator<int> > heapValues(100, 1);
+			CHECK(heapValues.get_allocator().getArena() == nullptr);
+			CHECK_EQUAL(100, heapValues.size());
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+	}
+}
@@ -0,0 +1,109 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include <vector>
+
+#include "litCheckMacros.h"
+
+#include "rttbBaseType.h"
+#include "rttbBoostMaskVoxelizationPlane.h"
+#include "rttbInvalidParameterException.h"
+
+namespace rttb
+{
+	namespace testing
+	{
+
+		/*! @brief VoxelizationPlaneTest.
+			1) test empty plane
+			2) test setRegionValues/getValue
+			3) test implicit storage of empty and full tiles
+		*/
+		int VoxelizationPlaneTest(int argc, char* argv[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			typedef masks::boost::VoxelizationPlane VoxelizationPlane;
+			const unsigned int tileSize = VoxelizationPlane::tileSize;
+
+			//1) test empty plane
+			VoxelizationPlane emptyPlane(0, 0, 0, 0);
+			CHECK_EQUAL(0, emptyPlane.getValue(0, 0));
+			CHECK_EQUAL(0, emptyPlane.getValue(10, 3));
+			CHECK_EQUAL(0, emptyPlane.getNumberOfStoredTiles());
+
+			//2) test setRegionValues/getValue: a region of 3x2 tiles (the last ones only partially used) starting at (5,7)
+			const unsigned int regionSize0 = 2 * tileSize + 3;
+			const unsigned int regionSize1 = tileSize + 1;
+			VoxelizationPlane plane(5, 7, regionSize0, regionSize1);
+			CHECK_EQUAL(5, plane.getRegionBegin0());
+			CHECK_EQUAL(7, plane.getRegionBegin1());
+			CHECK_EQUAL(regionSize0, plane.getRegionSize0());
+			CHECK_EQUAL(regionSize1, plane.getRegionSize1());
+
+			CHECK_THROW_EXPLICIT(plane.setRegionValues(std::vector<double>(5, 0.5)), core::InvalidParameterException);
+
+			//first tile column: full, second: empty, third: partial values
+			std::vector<double> values(static_cast<size_t>(regionSize0) * regionSize1, 0);
+
+			for (unsigned int x = 0; x < regionSize0; ++x)
+			{
+				for (unsigned int y = 0; y < regionSize1; ++y)
+				{
+					if (x < tileSize)
+					{
+						values[x * regionSize1 + y] = 1;
+					}
+					else if (x >= 2 * tileSize)
+					{
+						values[x * regionSize1 + y] = 0.01 * (x + y);
+					}
+				}
+			}
+
+			CHECK_NO_THROW(plane.setRegionValues(values));
+
+			bool allValuesEqual = true;
+
+			for (unsigned int x = 0; x < regionSize0; ++x)
+			{
+				for (unsigned int y = 0; y < regionSize1; ++y)
+				{
+					allValuesEqual = allValuesEqual && plane.getValue(x + 5, y + 7) == values[x * regionSize1 + y];
+				}
+			}
+
+			CHECK(allValuesEqual);
+
+			//outside of the region
+			CHECK_EQUAL(0, plane.getValue(4, 7));
+			CHECK_EQUAL(0, plane.getValue(5, 6));
+			CHECK_EQUAL(0, plane.getValue(5 + regionSize0, 7));
+			CHECK_EQUAL(0, plane.getValue(5, 7 + regionSize1));
+			CHECK_EQUAL(0, plane.getValue(1000, 1000));
+
+			//3) test implicit storage: only the 2 tiles of the third tile column are stored
+			CHECK_EQUAL(2, plane.getNumberOfStoredTiles());
+
+			std::vector<double> fullValues(static_cast<size_t>(regionSize0) * regionSize1, 1);
+			plane.setRegionValues(fullValues);
+			CHECK_EQUAL(0, plane.getNumberOfStoredTiles());
+			CHECK_EQUAL(1, plane.getValue(5 + regionSize0 - 1, 7 + regionSize1 - 1));
+			CHECK_EQUAL(0, plane.getValue(5 + regionSize0, 7 + regionSize1 - 1));
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+	}
+}
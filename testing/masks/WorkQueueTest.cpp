@@ -0,0 +1,98 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "litCheckMacros.h"
+
+#include "rttbBoostMaskWorkQueue.h"
+
+namespace rttb
+{
+	namespace testing
+	{
+
+		/*! @brief WorkQueueTest.
+			1) test getNextItem
+			2) test that concurrent threads get every item exactly once
+		*/
+		int WorkQueueTest(int argc, char* argv[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			typedef masks::boost::WorkQueue WorkQueue;
+
+			//1) test getNextItem
+			WorkQueue queue(3, 5);
+			size_t item = 0;
+			CHECK(queue.getNextItem(item));
+			CHECK_EQUAL(3, item);
+			CHECK(queue.getNextItem(item));
+			CHECK_EQUAL(4, item);
+			CHECK(!queue.getNextItem(item));
+			CHECK(!queue.getNextItem(item));
+
+			WorkQueue emptyQueue(7, 7);
+			CHECK(!emptyQueue.getNextItem(item));
+
+			//2) test concurrent access
+			const size_t numberOfItems = 10000;
+			WorkQueue sharedQueue(0, numberOfItems);
+			std::vector<std::vector<size_t> > itemsOfThreads(8);
+			std::vector<std::thread> threads;
+
+			for (auto& itemsOfThread : itemsOfThreads)
+			{
+				threads.emplace_back([&sharedQueue, &itemsOfThread]()
+				{
+					size_t threadItem;
+
+					while (sharedQueue.getNextItem(threadItem))
+					{
+						itemsOfThread.push_back(threadItem);
+					}
+				});
+			}
+
+			for (auto& thread : threads)
+			{
+				thread.join();
+			}
+
+			std::vector<size_t> allItems;
+
+			for (const auto& itemsOfThread : itemsOfThreads)
+			{
+				allItems.insert(allItems.end(), itemsOfThread.begin(), itemsOfThread.end());
+			}
+
+			std::sort(allItems.begin(), allItems.end());
+			CHECK_EQUAL(numberOfItems, allItems.size());
+
+			bool everyItemOnce = true;
+
+			for (size_t i = 0; i < allItems.size(); ++i)
+			{
+				everyItemOnce = everyItemOnce && allItems[i] == i;
+			}
+
+			CHECK(everyItemOnce);
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+	}
+}
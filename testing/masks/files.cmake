@@ -3,6 +3,11 @@ SET(CPP_FILES
 	../core/DummyDoseAccessor.cpp
 	../core/CreateTestStructure.cpp
 	BoostMaskTest.cpp
+	BoostMaskSetGeneratorTest.cpp
+	MaskVoxelIndexTest.cpp
+	MonotonicArenaTest.cpp
+	VoxelizationPlaneTest.cpp
+	WorkQueueTest.cpp
 	rttbBoostMaskTests.cpp
 )
 
@@ -29,6 +29,11 @@ namespace rttb
 		void registerTests()
 		{
 			LIT_REGISTER_TEST(BoostMaskTest);
+			LIT_REGISTER_TEST(BoostMaskSetGeneratorTest);
+			LIT_REGISTER_TEST(MaskVoxelIndexTest);
+			LIT_REGISTER_TEST(MonotonicArenaTest);
+			LIT_REGISTER_TEST(VoxelizationPlaneTest);
+			LIT_REGISTER_TEST(WorkQueueTest);
 		}
 	}
 }
@@ -0,0 +1,211 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html [^]
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE. See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+// this file defines the rttbCoreTests for the test driver
+// and all it expects is that you have a function called RegisterTests
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <ctime>
+#include <list>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "litCheckMacros.h"
+
+#include "rttbBaseType.h"
+#include "rttbGenericDoseIterator.h"
+#include "rttbDicomDoseAccessor.h"
+#include "rttbDicomFileDoseAccessorGenerator.h"
+#include "rttbLinearInterpolation.h"
+
+namespace rttb
+{
+
+	namespace testing
+	{
+
+		/*! @brief Linear interpolation as it was done before the interpolation kernel of InterpolationBase: the 8 corner
+		indices are collected in a std::list, every corner is checked with GeometricInfo and read with getValueAt(), and the
+		values are stored in a heap allocated array.
+		@pre aWorldCoordinate is at least one voxel away from the image borders (no edge handling)
+		*/
+		DoseTypeGy legacyLinearInterpolation(const core::DoseAccessorInterface& aDoseAccessor,
+		                                     const WorldCoordinate3D& aWorldCoordinate)
+		{
+			const core::GeometricInfo& geoInfo = aDoseAccessor.getGeometricInfo();
+			std::array<double, 3> target = {{0.0, 0.0, 0.0}};
+			auto values = boost::make_shared<DoseTypeGy[]>(8);
+
+			VoxelGridIndex3D aIndex;
+			geoInfo.worldCoordinateToIndex(aWorldCoordinate, aIndex);
+
+			WorldCoordinate3D theNextVoxel;
+			geoInfo.indexToWorldCoordinate(aIndex, theNextVoxel);
+			SpacingVectorType3D pixelSpacing = geoInfo.getSpacing();
+			VoxelGridIndex3D leftTopFrontCoordinate;
+
+			for (unsigned int i = 0; i < 3; i++)
+			{
+				if (aWorldCoordinate[i] < theNextVoxel[i])
+				{
+					leftTopFrontCoordinate[i] = aIndex[i] - 1;
+					target[i] = (aWorldCoordinate[i] - (theNextVoxel[i] - pixelSpacing[i])) / pixelSpacing[i];
+				}
+				else
+				{
+					leftTopFrontCoordinate[i] = aIndex[i];
+					target[i] = (aWorldCoordinate[i] - theNextVoxel[i]) / pixelSpacing[i];
+				}
+			}
+
+			std::list<VoxelGridIndex3D> cornerPoints;
+
+			for (unsigned int zIncr = 0; zIncr < 2; zIncr++)
+			{
+				for (unsigned int yIncr = 0; yIncr < 2; yIncr++)
+				{
+					for (unsigned int xIncr = 0; xIncr < 2; xIncr++)
+					{
+						cornerPoints.emplace_back(leftTopFrontCoordinate[0] + xIncr, leftTopFrontCoordinate[1] + yIncr,
+						                          leftTopFrontCoordinate[2] + zIncr);
+					}
+				}
+			}
+
+			unsigned int count = 0;
+
+			for (auto cornerPointsIterator = cornerPoints.begin(); cornerPointsIterator != cornerPoints.end();
+			     ++cornerPointsIterator, ++count)
+			{
+				if (geoInfo.isInside(*cornerPointsIterator))
+				{
+					values[count] = aDoseAccessor.getValueAt(*cornerPointsIterator);
+				}
+			}
+
+			DoseTypeGy c_00 = values[0] * (1.0 - target[0]) + values[1] * target[0];
+			DoseTypeGy c_10 = values[2] * (1.0 - target[0]) + values[3] * target[0];
+			DoseTypeGy c_01 = values[4] * (1.0 - target[0]) + values[5] * target[0];
+			DoseTypeGy c_11 = values[6] * (1.0 - target[0]) + values[7] * target[0];
+
+			DoseTypeGy c_0 = c_00 * (1.0 - target[1]) + c_10 * target[1];
+			DoseTypeGy c_1 = c_01 * (1.0 - target[1]) + c_11 * target[1];
+
+			return (c_0 * (1.0 - target[2]) + c_1 * target[2]);
+		}
+
+		/*! @brief LinearInterpolationBenchmarkTest.
+		Measures the time per sample of the linear interpolation of a dicom dose (raw value buffer available):
+			1) legacy interpolation (see legacyLinearInterpolation())
+			2) LinearInterpolation::getValue() for every sample
+			3) LinearInterpolation::getValues() for all samples
+		The times are only printed, all three have to return the same values.
+		*/
+		int LinearInterpolationBenchmarkTest(int argc, char* argv[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			typedef core::GenericDoseIterator::DoseAccessorPointer DoseAccessorPointer;
+
+			std::string RTDOSE_FILENAME;
+
+			if (argc > 1)
+			{
+				RTDOSE_FILENAME = argv[1];
+			}
+
+			/* read dicom-rt dose */
+			io::dicom::DicomFileDoseAccessorGenerator doseAccessorGenerator1(RTDOSE_FILENAME.c_str());
+			DoseAccessorPointer doseAccessor1(doseAccessorGenerator1.generateDoseAccessor());
+			const core::GeometricInfo& geoInfo = doseAccessor1->getGeometricInfo();
+
+			auto interpolation = boost::make_shared<interpolation::LinearInterpolation>();
+			interpolation->setAccessorPointer(doseAccessor1);
+
+			//samples at quasi random positions, at least one voxel away from the image borders
+			const size_t numberOfSamples = 500000;
+			const double goldenRatio[] = {0.6180339887498949, 0.7548776662466927, 0.5698402909980532};
+			const double imageSize[] = {static_cast<double>(geoInfo.getNumColumns()), static_cast<double>(geoInfo.getNumRows()),
+			                            static_cast<double>(geoInfo.getNumSlices())};
+			std::vector<WorldCoordinate3D> samples(numberOfSamples);
+
+			for (size_t i = 0; i < numberOfSamples; ++i)
+			{
+				ContinuousVoxelGridIndex3D sampleIndex;
+
+				for (unsigned int d = 0; d < 3; ++d)
+				{
+					const double fraction = (i + 1) * goldenRatio[d] - static_cast<size_t>((i + 1) * goldenRatio[d]);
+					sampleIndex(d) = 1.0 + fraction * (imageSize[d] - 3.0);
+				}
+
+				geoInfo.continuousIndexToWorldCoordinate(sampleIndex, samples[i]);
+			}
+
+			std::vector<DoseTypeGy> legacyValues(numberOfSamples);
+			std::vector<DoseTypeGy> singleValues(numberOfSamples);
+			std::vector<DoseTypeGy> batchValues(numberOfSamples);
+
+			clock_t startLegacy(clock());
+
+			for (size_t i = 0; i < numberOfSamples; ++i)
+			{
+				legacyValues[i] = legacyLinearInterpolation(*doseAccessor1, samples[i]);
+			}
+
+			clock_t finishLegacy(clock());
+
+			for (size_t i = 0; i < numberOfSamples; ++i)
+			{
+				singleValues[i] = interpolation->getValue(samples[i]);
+			}
+
+			clock_t finishSingle(clock());
+
+			CHECK_NO_THROW(interpolation->getValues(samples.data(), numberOfSamples, batchValues.data()));
+
+			clock_t finishBatch(clock());
+
+			const double nsPerClock = 1e9 / CLOCKS_PER_SEC;
+			std::cout << "linear interpolation of " << numberOfSamples << " samples, legacy: "
+			          << (finishLegacy - startLegacy) * nsPerClock / numberOfSamples << " ns/sample, getValue: "
+			          << (finishSingle - finishLegacy) * nsPerClock / numberOfSamples << " ns/sample, getValues: "
+			          << (finishBatch - finishSingle) * nsPerClock / numberOfSamples << " ns/sample" << std::endl;
+
+			double maxLegacyDifference = 0;
+			size_t numberOfDifferentBatchValues = 0;
+
+			for (size_t i = 0; i < numberOfSamples; ++i)
+			{
+				maxLegacyDifference = std::max(maxLegacyDifference, std::abs(legacyValues[i] - singleValues[i]));
+
+				if (singleValues[i] != batchValues[i])
+				{
+					++numberOfDifferentBatchValues;
+				}
+			}
+
+			CHECK_CLOSE(0.0, maxLegacyDifference, errorConstant);
+			CHECK_EQUAL(numberOfDifferentBatchValues, static_cast<size_t>(0));
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+
+	}//testing
+}//rttb
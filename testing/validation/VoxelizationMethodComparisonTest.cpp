@@ -0,0 +1,135 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html [^]
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE. See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+// this file defines the rttbCoreTests for the test driver
+// and all it expects is that you have a function called RegisterTests
+
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "litCheckMacros.h"
+
+#include "rttbBaseType.h"
+#include "rttbGenericDoseIterator.h"
+#include "rttbDicomDoseAccessor.h"
+#include "rttbDicomFileDoseAccessorGenerator.h"
+#include "rttbDicomFileStructureSetGenerator.h"
+#include "rttbBoostMaskAccessor.h"
+
+namespace rttb
+{
+
+	namespace testing
+	{
+
+		/*! @brief Compares two mask voxel lists independent of their order.
+		@return the maximal difference of the volume fractions (a voxel missing in one list has the fraction 0)
+		*/
+		double maxVolumeFractionDifference(core::MaskAccessorInterface::MaskVoxelList list1,
+		                                   core::MaskAccessorInterface::MaskVoxelList list2)
+		{
+			std::sort(list1.begin(), list1.end());
+			std::sort(list2.begin(), list2.end());
+
+			double maxDifference = 0;
+			auto it1 = list1.cbegin();
+			auto it2 = list2.cbegin();
+
+			while (it1 != list1.cend() || it2 != list2.cend())
+			{
+				if (it2 == list2.cend() || (it1 != list1.cend() && it1->getVoxelGridID() < it2->getVoxelGridID()))
+				{
+					maxDifference = std::max(maxDifference, it1->getRelevantVolumeFraction());
+					++it1;
+				}
+				else if (it1 == list1.cend() || it2->getVoxelGridID() < it1->getVoxelGridID())
+				{
+					maxDifference = std::max(maxDifference, it2->getRelevantVolumeFraction());
+					++it2;
+				}
+				else
+				{
+					maxDifference = std::max(maxDifference,
+					                         std::abs(it1->getRelevantVolumeFraction() - it2->getRelevantVolumeFraction()));
+					++it1;
+					++it2;
+				}
+			}
+
+			return maxDifference;
+		}
+
+		/*! @brief VoxelizationMethodComparisonTest.
+		Compare the scanline voxelization to the boost::geometry voxelization of BoostMask.
+		The scanline voxelization is exact, the boost::geometry intersection has a precision of about 1e-6.
+		*/
+		int VoxelizationMethodComparisonTest(int argc, char* argv[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			typedef core::GenericDoseIterator::DoseAccessorPointer DoseAccessorPointer;
+			typedef core::StructureSet::Pointer StructureSetPointer;
+
+			std::string RTSTRUCT_FILENAME;
+			std::string RTDOSE_FILENAME;
+
+			if (argc > 2)
+			{
+				RTSTRUCT_FILENAME = argv[1];
+				RTDOSE_FILENAME = argv[2];
+			}
+
+			/* read dicom-rt dose */
+			io::dicom::DicomFileDoseAccessorGenerator doseAccessorGenerator1(RTDOSE_FILENAME.c_str());
+			DoseAccessorPointer doseAccessor1(doseAccessorGenerator1.generateDoseAccessor());
+
+			StructureSetPointer rtStructureSet = io::dicom::DicomFileStructureSetGenerator(
+			        RTSTRUCT_FILENAME.c_str()).generateStructureSet();
+
+			//do not compute structure "Aussenkontur" since it is very large (15000 cm³)
+			for (size_t j = 1; j < rtStructureSet->getNumberOfStructures(); j++)
+			{
+				std::cout << j << ": " << rtStructureSet->getStructure(j)->getLabel() << std::endl;
+
+				clock_t startBoost(clock());
+				auto boostGeometryMask = ::boost::make_shared<rttb::masks::boost::BoostMaskAccessor>
+				                         (rtStructureSet->getStructure(j), doseAccessor1->getGeometricInfo(), true,
+				                          rttb::masks::boost::VoxelizationMethod::BoostGeometry);
+				CHECK_NO_THROW(boostGeometryMask->updateMask());
+				clock_t finishBoost(clock());
+
+				auto scanlineMask = ::boost::make_shared<rttb::masks::boost::BoostMaskAccessor>
+				                    (rtStructureSet->getStructure(j), doseAccessor1->getGeometricInfo(), true,
+				                     rttb::masks::boost::VoxelizationMethod::Scanline);
+				CHECK_NO_THROW(scanlineMask->updateMask());
+				clock_t finishScanline(clock());
+
+				std::cout << "boost::geometry voxelization: " << (finishBoost - startBoost) / (CLOCKS_PER_SEC / 1000)
+				          << " ms, scanline voxelization: " << (finishScanline - finishBoost) / (CLOCKS_PER_SEC / 1000)
+				          << " ms" << std::endl;
+
+				CHECK_CLOSE(0.0, maxVolumeFractionDifference(*(boostGeometryMask->getRelevantVoxelVector()),
+				            *(scanlineMask->getRelevantVoxelVector())), errorConstant);
+			}
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+
+	}//testing
+}//rttb
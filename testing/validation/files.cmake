@@ -1,6 +1,8 @@
 SET(CPP_FILES
 	VoxelizationDVHComparisonTest.cpp
 	VoxelizationValidationTest.cpp
+	VoxelizationMethodComparisonTest.cpp
+	LinearInterpolationBenchmarkTest.cpp
 	../io/other/CompareDVH.cpp
 	rttbValidationTests.cpp
   )
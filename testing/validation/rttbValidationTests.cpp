@@ -31,6 +31,8 @@ namespace rttb
 		{
             LIT_REGISTER_TEST(VoxelizationDVHComparisonTest);
             LIT_REGISTER_TEST(VoxelizationValidationTest);
+            LIT_REGISTER_TEST(VoxelizationMethodComparisonTest);
+            LIT_REGISTER_TEST(LinearInterpolationBenchmarkTest);
 		}
 	}
 }